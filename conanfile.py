@@ -160,13 +160,13 @@ class NikuConan(ConanFile):
         component = "vkglsl"
         self.cpp_info.components[component].set_property("cmake_target_name", f"niku::{component}")
         self.cpp_info.components[component].libs = [component]
-        self.cpp_info.components[component].requires.extend(["vkrndr"])
+        self.cpp_info.components[component].requires.extend(["vkrndr", "thread_pool_impl"])
         self.cpp_info.components[component].requires.extend(["glslang::glslang", "glslang::glslang-default-resource-limits", "glslang::spirv",  "spirv-cross::spirv-cross"])
 
         component = "ngnast"
         self.cpp_info.components[component].set_property("cmake_target_name", f"niku::{component}")
         self.cpp_info.components[component].libs = [component]
-        self.cpp_info.components[component].requires.extend(["cppext", "vkrndr", "glm_impl", "stb_impl"])
+        self.cpp_info.components[component].requires.extend(["cppext", "vkrndr", "glm_impl", "stb_impl", "thread_pool_impl"])
         self.cpp_info.components[component].requires.extend(["boost::headers", "fastgltf::fastgltf", "libbasisu::libbasisu", "mikktspace::mikktspace", "meshoptimizer::meshoptimizer", "spdlog::spdlog"])
 
         component = "ngngfx"
@@ -0,0 +1,46 @@
+#ifndef GALILEO_CLUSTERS_INCLUDED
+#define GALILEO_CLUSTERS_INCLUDED
+
+// View frustum is divided into clusters, screen space tiles in x and y and
+// exponentially distributed depth slices in z. Has to match frame_info.cpp
+const uvec3 clusterGrid = uvec3(16, 9, 24);
+const uint maxClusterLights = 128;
+
+#ifdef LIGHT_CULLING
+#define CLUSTER_ACCESS restrict writeonly
+#else
+#define CLUSTER_ACCESS restrict readonly
+#endif
+
+layout(std430, set = 0, binding = 2) CLUSTER_ACCESS buffer ClusterLightCounts
+{
+    uint v[];
+} clusterLightCounts;
+
+// Each cluster has room for maxClusterLights light indices
+layout(std430, set = 0, binding = 3) CLUSTER_ACCESS buffer ClusterLightIndices
+{
+    uint v[];
+} clusterLightIndices;
+
+// View space distance of the near side of a depth slice
+float sliceDepth(uint slice, vec2 nearFar)
+{
+    return nearFar.x *
+        pow(nearFar.y / nearFar.x, float(slice) / float(clusterGrid.z));
+}
+
+// Cluster containing the point at screen uv and view space distance
+uint clusterIndex(vec2 uv, float depth, vec2 nearFar)
+{
+    const float slice = log(max(depth, nearFar.x) / nearFar.x) /
+        log(nearFar.y / nearFar.x) * float(clusterGrid.z);
+
+    const uvec2 tile = uvec2(
+        clamp(uv * vec2(clusterGrid.xy), vec2(0.0), vec2(clusterGrid.xy - 1)));
+    const uint z = uint(min(slice, float(clusterGrid.z - 1)));
+
+    return tile.x + clusterGrid.x * (tile.y + clusterGrid.y * z);
+}
+
+#endif
@@ -3,6 +3,7 @@
 #extension GL_GOOGLE_include_directive : require
 
 #include "frame_info.glsl"
+#include "clusters.glsl"
 
 layout(location = 0) in vec2 inUV;
 
@@ -18,16 +19,25 @@ void main()
     const vec3 normal = texture(normalTexture, inUV).rgb;
     const vec3 albedo = texture(albedoTexture, inUV).rgb;
 
+    const float depth = -(frame.view * vec4(position, 1.0)).z;
+    const uint cluster = clusterIndex(inUV, depth, frame.nearFar);
+    const uint lightCount = clusterLightCounts.v[cluster];
+
     vec3 lighting = albedo * 0.1;
-    for (int i = 0; i < frame.lightCount; ++i)
+    for (uint i = 0; i != lightCount; ++i)
     {
-        Light light = lights.v[i];
+        const uint lightIndex =
+            clusterLightIndices.v[cluster * maxClusterLights + i];
+        Light light = lights.v[lightIndex];
 
         const vec3 lightDir = normalize(light.position - position);
         const vec3 diffuse =
             max(dot(normal, lightDir), 0.0) * albedo * light.color.rgb;
         const float distance = length(light.position - position);
-        const float attenuation = 1 / (distance * distance);
+        // Falls off to zero at the radius, lights are culled beyond it
+        const float window =
+            clamp(1.0 - pow(distance / light.radius, 4.0), 0.0, 1.0);
+        const float attenuation = window * window / (distance * distance);
 
         lighting += diffuse * attenuation;
     }
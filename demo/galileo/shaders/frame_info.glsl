@@ -7,12 +7,15 @@ layout(std430, set = 0, binding = 0) restrict readonly buffer FrameInfo
     mat4 projection;
     vec3 position;
     uint lightCount;
+    mat4 inverseProjection;
+    vec2 nearFar;
 } frame;
 
 struct Light
 {
     vec4 color;
     vec3 position;
+    float radius;
 };
 
 layout(std430, set = 0, binding = 1) restrict readonly buffer Lights
@@ -6,8 +6,8 @@
 #include "frame_info.glsl"
 #include "scene_graph.glsl"
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inNormal;
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec2 inNormal;
 layout(location = 2) in vec4 inColor;
 layout(location = 3) in vec2 inUV;
 layout(location = 4) in uint inInstance;
@@ -20,13 +20,17 @@ layout(location = 4) out uint outInstance;
 
 void main()
 {
-    const mat4 model = graph.nodes[inInstance].model;
-    const vec4 worldPosition = model * vec4(inPosition, 1.0);
+    const GraphNode node = graph.nodes[inInstance];
+    const mat4 model = node.model;
+
+    const vec3 position =
+        node.positionOffset.xyz + node.positionScale.xyz * inPosition.xyz;
+    const vec4 worldPosition = model * vec4(position, 1.0);
 
     gl_Position = frame.projection * frame.view * worldPosition;
 
     outPosition = worldPosition.xyz;
-    outNormal = transpose(inverse(mat3(model))) * inNormal;
+    outNormal = transpose(inverse(mat3(model))) * octDecode(inNormal);
     outColor = inColor;
     outUV = inUV;
     outInstance = inInstance;
@@ -5,8 +5,21 @@ struct GraphNode
 {
     mat4 model;
     uint material;
+    // Dequantization of packed vertex positions
+    vec4 positionOffset;
+    vec4 positionScale;
 };
 
+vec3 octDecode(vec2 e)
+{
+    vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0)
+    {
+        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(v);
+}
+
 layout(std430, set = 2, binding = 0) readonly buffer GraphNodeBuffer
 {
     GraphNode nodes[];
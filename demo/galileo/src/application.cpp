@@ -29,6 +29,7 @@
 #include <ngnast_scene_model.hpp>
 
 #include <ngngfx_aircraft_camera.hpp>
+#include <ngngfx_frustum.hpp>
 #include <ngngfx_perspective_projection.hpp>
 
 #include <ngnphy_coordinate_system.hpp>
@@ -46,7 +47,6 @@
 
 #include <vkrndr_backend.hpp>
 #include <vkrndr_commands.hpp>
-#include <vkrndr_cpu_pacing.hpp>
 #include <vkrndr_debug_utils.hpp>
 #include <vkrndr_device.hpp>
 #include <vkrndr_error_code.hpp>
@@ -56,6 +56,7 @@
 #include <vkrndr_image.hpp>
 #include <vkrndr_instance.hpp>
 #include <vkrndr_library_handle.hpp>
+#include <vkrndr_pipeline_cache.hpp>
 #include <vkrndr_render_pass.hpp>
 #include <vkrndr_rendering_context.hpp>
 #include <vkrndr_swapchain.hpp>
@@ -75,6 +76,7 @@ DISABLE_WARNING_POP
 
 #include <glm/gtc/constants.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <glm/trigonometric.hpp>
 #include <glm/vec3.hpp>
 
 #include <Jolt/Core/Core.h>
@@ -112,6 +114,7 @@ DISABLE_WARNING_POP
 #include <array>
 #include <cassert>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
@@ -143,6 +146,9 @@ DISABLE_WARNING_POP
 
 namespace
 {
+    constexpr char const* pipeline_cache_file{"pipeline_cache.bin"};
+    constexpr char const* shader_cache_directory{"shader_cache"};
+
     [[nodiscard]] vkrndr::image_t create_color_image(
         vkrndr::backend_t const& backend,
         VkExtent2D const extent)
@@ -239,6 +245,7 @@ galileo::application_t::application_t()
                                                          {
                                                              .video = true,
                                                          }}}
+    , glsl_guard_{shader_cache_directory}
     , free_camera_controller_{camera_, mouse_}
     , follow_camera_controller_{camera_}
     , random_engine_{std::random_device{}()}
@@ -337,6 +344,20 @@ galileo::application_t::application_t()
                         vkrndr::handle_cast(device->logical_device),
                         fmt::join(device->extensions, ", "));
 
+                    // Pipelines are compiled by the driver on a cold cache
+                    if (std::expected<bool, std::error_code> const loaded{
+                            vkrndr::load_pipeline_cache(*device,
+                                pipeline_cache_file)};
+                        !loaded)
+                    {
+                        spdlog::warn("Pipeline cache not loaded: {}",
+                            loaded.error().message());
+                    }
+                    else if (!*loaded)
+                    {
+                        spdlog::info("Pipeline cache missing or outdated");
+                    }
+
                     rendering_context_.device = std::move(device);
                 })
             .transform_error(
@@ -388,6 +409,7 @@ galileo::application_t::application_t()
                     scene_graph_ = std::make_unique<scene_graph_t>(*backend_);
                     deferred_shader_ =
                         std::make_unique<deferred_shader_t>(*backend_,
+                            thread_pool_,
                             frame_info_->descriptor_set_layout());
                     postprocess_shader_ =
                         std::make_unique<postprocess_shader_t>(*backend_);
@@ -577,6 +599,11 @@ void galileo::application_t::draw()
     imgui_->begin_frame();
     frame_info_->begin_frame();
     batch_renderer_->begin_frame();
+    scene_graph_->update_lod(camera_.position(),
+        cppext::as_fp(target_image->extent.height) /
+            (2.0f * std::tan(glm::radians(projection_.fov()) * 0.5f)));
+    scene_graph_->update_frustum(
+        ngngfx::extract_frustum(projection_.view_projection_matrix()));
     scene_graph_->begin_frame();
 
     debug_draw();
@@ -651,6 +678,10 @@ void galileo::application_t::draw()
     VkRect2D const scissor{{0, 0}, vkrndr::to_2d_extent(target_image->extent)};
     vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
+    scene_graph_->prepare_draws(command_buffer);
+
+    frame_info_->cull_lights(command_buffer);
+
     {
         auto const barrier{vkrndr::to_layout(
             vkrndr::with_access(
@@ -996,6 +1027,7 @@ void galileo::application_t::on_startup()
     character_->set_contact_listener(character_listener_.get());
 
     gbuffer_shader_ = std::make_unique<gbuffer_shader_t>(*backend_,
+        thread_pool_,
         frame_info_->descriptor_set_layout(),
         materials_->descriptor_set_layout(),
         scene_graph_->descriptor_set_layout(),
@@ -1009,6 +1041,14 @@ void galileo::application_t::on_shutdown()
 {
     vkDeviceWaitIdle(backend_->device());
 
+    if (std::expected<void, std::error_code> const result{
+            vkrndr::save_pipeline_cache(backend_->device(),
+                pipeline_cache_file)};
+        !result)
+    {
+        spdlog::warn("Pipeline cache not saved: {}", result.error().message());
+    }
+
     registry_.clear();
 
     physics_debug_.reset();
@@ -1055,10 +1095,9 @@ void galileo::application_t::on_resize(uint32_t const width,
         return;
     }
 
-    vkrndr::frame_in_flight_t& in_flight{render_window_->frame_in_flight()};
     std::function<void(std::function<void()>)> deletion_queue_insert{
-        [&in_flight](std::function<void()> cb)
-        { in_flight.cleanup.push_back(std::move(cb)); }};
+        [this](std::function<void()> cb)
+        { render_window_->defer(std::move(cb)); }};
 
     projection_.set_aspect_ratio(cppext::as_fp(width) / cppext::as_fp(height));
 
@@ -1087,7 +1126,8 @@ void galileo::application_t::setup_world()
 {
     using namespace JPH::literals;
 
-    ngnast::gltf::loader_t loader{{}};
+    constexpr bool use_cooked_cache{true};
+    ngnast::gltf::loader_t loader{{}, &thread_pool_, use_cooked_cache};
     auto model{loader.load(std::filesystem::absolute("world.glb"))};
     if (!model)
     {
@@ -2,29 +2,25 @@
 
 #include <config.hpp>
 
-#include <cppext_cycled_buffer.hpp>
+#include <cppext_numeric.hpp>
 
 #include <vkglsl_shader_set.hpp>
 
 #include <vkrndr_backend.hpp>
-#include <vkrndr_buffer.hpp>
 #include <vkrndr_graphics_pipeline_builder.hpp>
-#include <vkrndr_memory.hpp>
+#include <vkrndr_linear_allocator.hpp>
 #include <vkrndr_pipeline.hpp>
 #include <vkrndr_pipeline_layout_builder.hpp>
 #include <vkrndr_shader_module.hpp>
 
-#include <vma_impl.hpp>
-
 #include <boost/scope/defer.hpp>
-#include <boost/scope/scope_fail.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cassert>
-#include <iterator>
+#include <cstdint>
+#include <vector>
 
-// IWYU pragma: no_include <boost/scope/exception_checker.hpp>
 // IWYU pragma: no_include <memory>
 // IWYU pragma: no_include <filesystem>
 // IWYU pragma: no_include <functional>
@@ -71,7 +67,6 @@ galileo::batch_renderer_t::batch_renderer_t(vkrndr::backend_t& backend,
     VkDescriptorSetLayout frame_info_layout,
     VkFormat const depth_buffer_format)
     : backend_{&backend}
-    , frame_data_{backend_->frames_in_flight(), backend_->frames_in_flight()}
 {
     vkglsl::shader_set_t shader_set{enable_shader_debug_symbols,
         enable_shader_optimization};
@@ -157,78 +152,34 @@ galileo::batch_renderer_t::~batch_renderer_t()
     destroy(backend_->device(), line_pipeline_);
     destroy(backend_->device(), triangle_pipeline_);
     destroy(backend_->device(), pipeline_layout_);
-
-    for (auto& data : cppext::as_span(frame_data_))
-    {
-        for (auto& buffer : data.buffers)
-        {
-            if (buffer.memory.allocation != VK_NULL_HANDLE)
-            {
-                vkrndr::unmap_memory(backend_->device(), &buffer.memory);
-            }
-
-            vkrndr::destroy(backend_->device(), buffer.buffer);
-        }
-    }
 }
 
 void galileo::batch_renderer_t::add_triangle(batch_vertex_t const& p1,
     batch_vertex_t const& p2,
     batch_vertex_t const& p3)
 {
-    vertex_buffer_t* const buffer{
-        buffer_for(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST)};
-    batch_vertex_t* const mapping{
-        buffer->memory.as<batch_vertex_t>() + buffer->size};
-
-    mapping[0] = p1;
-    mapping[1] = p2;
-    mapping[2] = p3;
-
-    buffer->size += 3;
+    triangles_.push_back(p1);
+    triangles_.push_back(p2);
+    triangles_.push_back(p3);
 }
 
 void galileo::batch_renderer_t::add_line(batch_vertex_t const& p1,
     batch_vertex_t const& p2)
 {
-    vertex_buffer_t* const buffer{buffer_for(VK_PRIMITIVE_TOPOLOGY_LINE_LIST)};
-    batch_vertex_t* const mapping{
-        buffer->memory.as<batch_vertex_t>() + buffer->size};
-
-    mapping[0] = p1;
-    mapping[1] = p2;
-
-    buffer->size += 2;
+    lines_.push_back(p1);
+    lines_.push_back(p2);
 }
 
 void galileo::batch_renderer_t::add_point(batch_vertex_t const& p1)
 {
-    vertex_buffer_t* const buffer{buffer_for(VK_PRIMITIVE_TOPOLOGY_POINT_LIST)};
-    batch_vertex_t* const mapping{
-        buffer->memory.as<batch_vertex_t>() + buffer->size};
-
-    mapping[0] = p1;
-
-    buffer->size += 1;
+    points_.push_back(p1);
 }
 
 void galileo::batch_renderer_t::begin_frame()
 {
-    frame_data_.cycle(
-        [this](frame_data_t const&, frame_data_t& next)
-        {
-            std::ranges::for_each(next.buffers,
-                [this](vertex_buffer_t& buffer)
-                {
-                    buffer.size = 0;
-                    if (buffer.memory.allocation != VK_NULL_HANDLE)
-                    {
-                        vkrndr::unmap_memory(backend_->device(),
-                            &buffer.memory);
-                        buffer.memory.allocation = VK_NULL_HANDLE;
-                    }
-                });
-        });
+    triangles_.clear();
+    lines_.clear();
+    points_.clear();
 }
 
 VkPipelineLayout galileo::batch_renderer_t::pipeline_layout() const
@@ -238,116 +189,42 @@ VkPipelineLayout galileo::batch_renderer_t::pipeline_layout() const
 
 void galileo::batch_renderer_t::draw(VkCommandBuffer command_buffer)
 {
-    auto const draw_topology = [&command_buffer](
-                                   std::vector<vertex_buffer_t> const& buffers,
-                                   VkPrimitiveTopology const topology)
-    {
-        VkDeviceSize const zero_offset{};
-        for (auto const& buffer : buffers)
-        {
-            if (buffer.topology != topology || buffer.size == 0)
-            {
-                continue;
-            }
-
-            vkCmdBindVertexBuffers(command_buffer,
-                0,
-                1,
-                &buffer.buffer.handle,
-                &zero_offset);
-
-            vkCmdDraw(command_buffer, buffer.size, 1, 0, 0);
-        }
-    };
-
-    if (triangle_buffer_)
+    if (!triangles_.empty())
     {
         vkrndr::bind_pipeline(command_buffer, triangle_pipeline_);
-        draw_topology(frame_data_->buffers,
-            VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+        draw_vertices(command_buffer, triangles_);
     }
 
-    if (line_buffer_)
+    if (!lines_.empty())
     {
         vkrndr::bind_pipeline(command_buffer, line_pipeline_);
         vkCmdSetLineWidth(command_buffer, 3.0f);
-        draw_topology(frame_data_->buffers, VK_PRIMITIVE_TOPOLOGY_LINE_LIST);
+        draw_vertices(command_buffer, lines_);
     }
 
-    if (point_buffer_)
+    if (!points_.empty())
     {
         vkrndr::bind_pipeline(command_buffer, point_pipeline_);
-        draw_topology(frame_data_->buffers, VK_PRIMITIVE_TOPOLOGY_POINT_LIST);
+        draw_vertices(command_buffer, points_);
     }
-
-    triangle_buffer_.reset();
-    line_buffer_.reset();
-    point_buffer_.reset();
 }
 
-galileo::batch_renderer_t::vertex_buffer_t*
-galileo::batch_renderer_t::buffer_for(VkPrimitiveTopology topology)
+void galileo::batch_renderer_t::draw_vertices(VkCommandBuffer command_buffer,
+    std::vector<batch_vertex_t> const& vertices)
 {
-    auto from_cached_variable = [this, &topology](
-                                    std::optional<size_t>& cached_index)
-    {
-        if (cached_index &&
-            frame_data_->buffers[*cached_index].size !=
-                frame_data_->buffers[*cached_index].capacity)
-        {
-            return &frame_data_->buffers[*cached_index];
-        }
-
-        auto existing{std::ranges::find_if(frame_data_->buffers,
-            [&topology](vertex_buffer_t const& buffer)
-            { return buffer.topology == topology && buffer.size == 0; })};
-        if (existing != frame_data_->buffers.cend())
-        {
-            cached_index =
-                std::distance(frame_data_->buffers.begin(), existing);
-        }
-        else
-        {
-            vkrndr::buffer_t const buffer{create_buffer(backend_->device(),
-                {.size = 30000 * sizeof(batch_vertex_t),
-                    .usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                    .allocation_flags =
-                        VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
-                    .required_memory_flags =
-                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
-                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT})};
-            boost::scope::scope_fail f{
-                [this, buffer]() { destroy(backend_->device(), buffer); }};
-
-            frame_data_->buffers.emplace_back(topology,
-                buffer,
-                vkrndr::mapped_memory_t{},
-                0,
-                30000);
-
-            cached_index = frame_data_->buffers.size() - 1;
-
-            f.set_active(false);
-        }
-
-        frame_data_->buffers[*cached_index].memory =
-            vkrndr::map_memory(backend_->device(),
-                frame_data_->buffers[*cached_index].buffer);
-        return &frame_data_->buffers[*cached_index];
-    };
-
-    switch (topology)
-    {
-    case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
-        return from_cached_variable(point_buffer_);
-    case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
-        return from_cached_variable(line_buffer_);
-    case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST:
-        return from_cached_variable(triangle_buffer_);
-    default:
-        assert(false);
-    }
-
-    return nullptr;
+    vkrndr::linear_allocation_t const allocation{
+        backend_->frame_allocator().allocate<batch_vertex_t>(vertices.size())};
+    std::ranges::copy(vertices, allocation.as<batch_vertex_t>().begin());
+
+    vkCmdBindVertexBuffers(command_buffer,
+        0,
+        1,
+        &allocation.buffer,
+        &allocation.offset);
+
+    vkCmdDraw(command_buffer,
+        cppext::narrow<uint32_t>(vertices.size()),
+        1,
+        0,
+        0);
 }
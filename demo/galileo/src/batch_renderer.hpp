@@ -1,10 +1,6 @@
 #ifndef GALILEO_BATCH_RENDERER_INCLUDED
 #define GALILEO_BATCH_RENDERER_INCLUDED
 
-#include <cppext_cycled_buffer.hpp>
-
-#include <vkrndr_buffer.hpp>
-#include <vkrndr_memory.hpp>
 #include <vkrndr_pipeline.hpp>
 
 #include <glm/vec3.hpp>
@@ -12,9 +8,6 @@
 
 #include <volk.h>
 
-#include <cstddef>
-#include <cstdint>
-#include <optional>
 #include <vector>
 
 namespace vkrndr
@@ -67,22 +60,8 @@ namespace galileo
         batch_renderer_t& operator=(batch_renderer_t&&) noexcept = delete;
 
     private:
-        struct [[nodiscard]] vertex_buffer_t final
-        {
-            VkPrimitiveTopology topology{VK_PRIMITIVE_TOPOLOGY_LINE_LIST};
-            vkrndr::buffer_t buffer;
-            vkrndr::mapped_memory_t memory;
-            uint32_t size{};
-            uint32_t capacity{};
-        };
-
-        struct [[nodiscard]] frame_data_t final
-        {
-            std::vector<vertex_buffer_t> buffers;
-        };
-
-    private:
-        vertex_buffer_t* buffer_for(VkPrimitiveTopology topology);
+        void draw_vertices(VkCommandBuffer command_buffer,
+            std::vector<batch_vertex_t> const& vertices);
 
     private:
         vkrndr::backend_t* backend_;
@@ -92,11 +71,10 @@ namespace galileo
         vkrndr::pipeline_t line_pipeline_;
         vkrndr::pipeline_t point_pipeline_;
 
-        cppext::cycled_buffer_t<frame_data_t> frame_data_;
-
-        std::optional<size_t> triangle_buffer_;
-        std::optional<size_t> line_buffer_;
-        std::optional<size_t> point_buffer_;
+        // Copied to the backend frame allocator when drawn
+        std::vector<batch_vertex_t> triangles_;
+        std::vector<batch_vertex_t> lines_;
+        std::vector<batch_vertex_t> points_;
     };
 } // namespace galileo
 
@@ -18,6 +18,8 @@
 #include <vkrndr_shader_module.hpp>
 #include <vkrndr_utility.hpp>
 
+#include <BS_thread_pool.hpp>
+
 #include <boost/scope/defer.hpp>
 
 #include <array>
@@ -131,6 +133,7 @@ namespace
 } // namespace
 
 galileo::deferred_shader_t::deferred_shader_t(vkrndr::backend_t& backend,
+    BS::thread_pool<>& thread_pool,
     VkDescriptorSetLayout frame_info_layout)
     : backend_{&backend}
     , descriptor_set_layout_{create_descriptor_set_layout(backend_->device())}
@@ -140,22 +143,25 @@ galileo::deferred_shader_t::deferred_shader_t(vkrndr::backend_t& backend,
     vkglsl::shader_set_t shader_set{enable_shader_debug_symbols,
         enable_shader_optimization};
 
-    auto vertex_shader{add_shader_module_from_path(shader_set,
-        backend_->device(),
-        VK_SHADER_STAGE_VERTEX_BIT,
-        "fullscreen.vert")};
-    assert(vertex_shader);
-    boost::scope::defer_guard destroy_vtx{[this, &shd = vertex_shader.value()]()
-        { destroy(backend_->device(), shd); }};
-
-    auto fragment_shader{add_shader_module_from_path(shader_set,
+    std::array const sources{
+        vkglsl::shader_source_t{.stage = VK_SHADER_STAGE_VERTEX_BIT,
+            .file = "fullscreen.vert"},
+        vkglsl::shader_source_t{.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .file = "deferred.frag"}};
+    auto shaders{add_shader_modules_from_paths(shader_set,
         backend_->device(),
-        VK_SHADER_STAGE_FRAGMENT_BIT,
-        "deferred.frag")};
-    assert(fragment_shader);
-    boost::scope::defer_guard destroy_frag{
-        [this, &shd = fragment_shader.value()]()
-        { destroy(backend_->device(), shd); }};
+        sources,
+        &thread_pool)};
+    assert(shaders);
+    boost::scope::defer_guard destroy_shaders{[this, &shd = shaders.value()]()
+        {
+            for (vkrndr::shader_module_t const& shader : shd)
+            {
+                destroy(backend_->device(), shader);
+            }
+        }};
+    vkrndr::shader_module_t const& vertex_shader{(*shaders)[0]};
+    vkrndr::shader_module_t const& fragment_shader{(*shaders)[1]};
 
     pipeline_layout_ = vkrndr::pipeline_layout_builder_t{backend_->device()}
                            .add_descriptor_set_layout(frame_info_layout)
@@ -164,8 +170,8 @@ galileo::deferred_shader_t::deferred_shader_t(vkrndr::backend_t& backend,
 
     pipeline_ = vkrndr::graphics_pipeline_builder_t{backend_->device(),
         pipeline_layout_}
-                    .add_shader(as_pipeline_shader(*vertex_shader))
-                    .add_shader(as_pipeline_shader(*fragment_shader))
+                    .add_shader(as_pipeline_shader(vertex_shader))
+                    .add_shader(as_pipeline_shader(fragment_shader))
                     .add_color_attachment(VK_FORMAT_R16G16B16A16_SFLOAT)
                     .with_culling(VK_CULL_MODE_FRONT_BIT,
                         VK_FRONT_FACE_COUNTER_CLOCKWISE)
@@ -5,6 +5,8 @@
 
 #include <vkrndr_pipeline.hpp>
 
+#include <BS_thread_pool.hpp> // IWYU pragma: keep
+
 #include <volk.h>
 
 namespace vkrndr
@@ -22,7 +24,8 @@ namespace galileo
     class [[nodiscard]] deferred_shader_t final
     {
     public:
-        explicit deferred_shader_t(vkrndr::backend_t& backend,
+        deferred_shader_t(vkrndr::backend_t& backend,
+            BS::thread_pool<>& thread_pool,
             VkDescriptorSetLayout frame_info_layout);
 
         deferred_shader_t(deferred_shader_t const&) = delete;
@@ -1,5 +1,7 @@
 #include <frame_info.hpp>
 
+#include <config.hpp>
+
 #include <cppext_container.hpp>
 #include <cppext_cycled_buffer.hpp>
 
@@ -8,14 +10,27 @@
 #include <ngngfx_camera.hpp>
 #include <ngngfx_projection.hpp>
 
+#include <vkglsl_shader_set.hpp>
+
 #include <vkrndr_backend.hpp>
 #include <vkrndr_buffer.hpp>
+#include <vkrndr_compute_pipeline_builder.hpp>
+#include <vkrndr_debug_utils.hpp>
 #include <vkrndr_descriptors.hpp>
 #include <vkrndr_device.hpp>
 #include <vkrndr_memory.hpp>
+#include <vkrndr_pipeline.hpp>
+#include <vkrndr_pipeline_layout_builder.hpp>
+#include <vkrndr_shader_module.hpp>
+#include <vkrndr_synchronization.hpp>
 #include <vkrndr_utility.hpp>
 
+#include <boost/scope/defer.hpp>
+
+#include <glm/common.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/matrix.hpp>
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
@@ -25,6 +40,8 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
 #include <cstdint>
 #include <random>
 #include <span>
@@ -35,19 +52,31 @@ namespace
 {
     constexpr uint32_t max_lights{2000};
 
+    // Irradiance below which a light doesn't contribute, determines the
+    // radius of lights
+    constexpr float light_cutoff{1.0f / 256.0f};
+
+    // Has to match clusters.glsl
+    constexpr uint32_t cluster_count{16 * 9 * 24};
+    constexpr uint32_t max_cluster_lights{128};
+
+    constexpr uint32_t light_culling_group_size{64};
+
     struct [[nodiscard]] gpu_frame_info_t final
     {
         glm::mat4 view;
         glm::mat4 projection;
         glm::vec3 position;
         uint32_t light_count;
+        glm::mat4 inverse_projection;
+        glm::vec2 near_far;
     };
 
     struct [[nodiscard]] gpu_light_t final
     {
         glm::vec4 color;
         glm::vec3 position;
-        uint32_t padding;
+        float radius;
     };
 
     [[nodiscard]] VkDescriptorSetLayout create_descriptor_set_layout(
@@ -57,17 +86,36 @@ namespace
         info_binding.binding = 0;
         info_binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         info_binding.descriptorCount = 1;
-        info_binding.stageFlags =
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        info_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT |
+            VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
 
         VkDescriptorSetLayoutBinding light_binding{};
         light_binding.binding = 1;
         light_binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
         light_binding.descriptorCount = 1;
-        light_binding.stageFlags =
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-
-        std::array bindings{info_binding, light_binding};
+        light_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT |
+            VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutBinding cluster_counts_binding{};
+        cluster_counts_binding.binding = 2;
+        cluster_counts_binding.descriptorType =
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        cluster_counts_binding.descriptorCount = 1;
+        cluster_counts_binding.stageFlags =
+            VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutBinding cluster_indices_binding{};
+        cluster_indices_binding.binding = 3;
+        cluster_indices_binding.descriptorType =
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        cluster_indices_binding.descriptorCount = 1;
+        cluster_indices_binding.stageFlags =
+            VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+        std::array bindings{info_binding,
+            light_binding,
+            cluster_counts_binding,
+            cluster_indices_binding};
 
         return vkrndr::create_descriptor_set_layout(device, bindings).value();
     }
@@ -75,7 +123,9 @@ namespace
     void update_descriptor_set(vkrndr::device_t const& device,
         VkDescriptorSet const descriptor_set,
         VkDescriptorBufferInfo const info_buffer,
-        VkDescriptorBufferInfo const light_buffer)
+        VkDescriptorBufferInfo const light_buffer,
+        VkDescriptorBufferInfo const cluster_counts_buffer,
+        VkDescriptorBufferInfo const cluster_indices_buffer)
     {
         VkWriteDescriptorSet info_write{};
         info_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -95,7 +145,30 @@ namespace
         light_write.descriptorCount = 1;
         light_write.pBufferInfo = &light_buffer;
 
-        std::array const descriptor_writes{info_write, light_write};
+        VkWriteDescriptorSet cluster_counts_write{};
+        cluster_counts_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        cluster_counts_write.dstSet = descriptor_set;
+        cluster_counts_write.dstBinding = 2;
+        cluster_counts_write.dstArrayElement = 0;
+        cluster_counts_write.descriptorType =
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        cluster_counts_write.descriptorCount = 1;
+        cluster_counts_write.pBufferInfo = &cluster_counts_buffer;
+
+        VkWriteDescriptorSet cluster_indices_write{};
+        cluster_indices_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        cluster_indices_write.dstSet = descriptor_set;
+        cluster_indices_write.dstBinding = 3;
+        cluster_indices_write.dstArrayElement = 0;
+        cluster_indices_write.descriptorType =
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        cluster_indices_write.descriptorCount = 1;
+        cluster_indices_write.pBufferInfo = &cluster_indices_buffer;
+
+        std::array const descriptor_writes{info_write,
+            light_write,
+            cluster_counts_write,
+            cluster_indices_write};
 
         vkUpdateDescriptorSets(device,
             vkrndr::count_cast(descriptor_writes),
@@ -116,12 +189,20 @@ namespace
         std::ranges::generate(buffer,
             [&]() -> gpu_light_t
             {
-                return {.color = {cdist(engine),
-                            cdist(engine),
-                            cdist(engine),
-                            1.0f},
+                glm::vec4 const color{cdist(engine),
+                    cdist(engine),
+                    cdist(engine),
+                    1.0f};
+
+                // Distance at which inverse square falloff of the brightest
+                // channel reaches the cutoff
+                float const radius{std::sqrt(
+                    glm::max(glm::max(color.r, color.g), color.b) /
+                    light_cutoff)};
+
+                return {.color = color,
                     .position = {pdist(engine), hdist(engine), pdist(engine)},
-                    .padding = 0};
+                    .radius = radius};
             });
     }
 } // namespace
@@ -150,6 +231,16 @@ galileo::frame_info_t::frame_info_t(vkrndr::backend_t& backend)
                     VK_BUFFER_USAGE_TRANSFER_DST_BIT,
                 .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
 
+        data.cluster_light_counts = vkrndr::create_buffer(backend_->device(),
+            {.size = sizeof(uint32_t) * cluster_count,
+                .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
+
+        data.cluster_light_indices = vkrndr::create_buffer(backend_->device(),
+            {.size = sizeof(uint32_t) * cluster_count * max_cluster_lights,
+                .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
+
         vkrndr::check_result(allocate_descriptor_sets(backend_->device(),
             backend_->descriptor_pool(),
             cppext::as_span(descriptor_set_layout_),
@@ -158,18 +249,49 @@ galileo::frame_info_t::frame_info_t(vkrndr::backend_t& backend)
         update_descriptor_set(backend_->device(),
             data.descriptor_set,
             vkrndr::buffer_descriptor(data.info_buffer),
-            vkrndr::buffer_descriptor(data.light_buffer));
+            vkrndr::buffer_descriptor(data.light_buffer),
+            vkrndr::buffer_descriptor(data.cluster_light_counts),
+            vkrndr::buffer_descriptor(data.cluster_light_indices));
     }
+
+    vkglsl::shader_set_t shader_set{enable_shader_debug_symbols,
+        enable_shader_optimization};
+
+    auto shader{add_shader_module_from_path(shader_set,
+        backend_->device(),
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        "light_culling.comp")};
+    assert(shader);
+    boost::scope::defer_guard destroy_shd{[this, &shd = shader.value()]()
+        { destroy(backend_->device(), shd); }};
+
+    light_culling_pipeline_layout_ =
+        vkrndr::pipeline_layout_builder_t{backend_->device()}
+            .add_descriptor_set_layout(descriptor_set_layout_)
+            .build();
+
+    light_culling_pipeline_ =
+        vkrndr::compute_pipeline_builder_t{backend_->device(),
+            light_culling_pipeline_layout_}
+            .with_shader(as_pipeline_shader(*shader))
+            .build();
 }
 
 galileo::frame_info_t::~frame_info_t()
 {
+    destroy(backend_->device(), light_culling_pipeline_);
+    destroy(backend_->device(), light_culling_pipeline_layout_);
+
     for (auto& data : cppext::as_span(frame_data_))
     {
         free_descriptor_sets(backend_->device(),
             backend_->descriptor_pool(),
             cppext::as_span(data.descriptor_set));
 
+        vkrndr::destroy(backend_->device(), data.cluster_light_indices);
+
+        vkrndr::destroy(backend_->device(), data.cluster_light_counts);
+
         vkrndr::destroy(backend_->device(), data.light_buffer);
 
         vkrndr::unmap_memory(backend_->device(), &data.info_map);
@@ -198,6 +320,8 @@ void galileo::frame_info_t::update(ngngfx::camera_t const& camera,
     gpu->projection = projection.projection_matrix();
     gpu->position = camera.position();
     gpu->light_count = light_count;
+    gpu->inverse_projection = glm::inverse(projection.projection_matrix());
+    gpu->near_far = projection.near_far_planes();
 }
 
 void galileo::frame_info_t::bind_on(VkCommandBuffer command_buffer,
@@ -214,6 +338,33 @@ void galileo::frame_info_t::bind_on(VkCommandBuffer command_buffer,
         nullptr);
 }
 
+void galileo::frame_info_t::cull_lights(VkCommandBuffer command_buffer)
+{
+    VKRNDR_IF_DEBUG_UTILS(
+        [[maybe_unused]] vkrndr::command_buffer_scope_t const culling_scope{
+            command_buffer,
+            "Light Culling"});
+
+    vkrndr::bind_pipeline(command_buffer,
+        light_culling_pipeline_,
+        0,
+        cppext::as_span(frame_data_->descriptor_set));
+
+    vkCmdDispatch(command_buffer,
+        (cluster_count + light_culling_group_size - 1) /
+            light_culling_group_size,
+        1,
+        1);
+
+    auto const barrier{vkrndr::with_access(
+        vkrndr::on_stage(vkrndr::memory_barrier(),
+            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT),
+        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+        VK_ACCESS_2_SHADER_STORAGE_READ_BIT)};
+    vkrndr::wait_for(command_buffer, cppext::as_span(barrier), {}, {});
+}
+
 void galileo::frame_info_t::disperse_lights(
     ngnast::bounding_box_t const& bounding_box)
 {
@@ -5,6 +5,7 @@
 
 #include <vkrndr_buffer.hpp>
 #include <vkrndr_memory.hpp>
+#include <vkrndr_pipeline.hpp>
 
 #include <volk.h>
 
@@ -53,6 +54,10 @@ namespace galileo
             VkPipelineLayout layout,
             VkPipelineBindPoint bind_point);
 
+        // Bins lights into view space clusters, has to be recorded outside
+        // of a render pass after the frame info is updated
+        void cull_lights(VkCommandBuffer command_buffer);
+
         void disperse_lights(ngnast::bounding_box_t const& bounding_box);
 
     public:
@@ -68,6 +73,9 @@ namespace galileo
 
             vkrndr::buffer_t light_buffer;
 
+            vkrndr::buffer_t cluster_light_counts;
+            vkrndr::buffer_t cluster_light_indices;
+
             VkDescriptorSet descriptor_set{VK_NULL_HANDLE};
         };
 
@@ -76,6 +84,9 @@ namespace galileo
 
         VkDescriptorSetLayout descriptor_set_layout_{VK_NULL_HANDLE};
 
+        vkrndr::pipeline_layout_t light_culling_pipeline_layout_;
+        vkrndr::pipeline_t light_culling_pipeline_;
+
         cppext::cycled_buffer_t<frame_data_t> frame_data_;
     };
 } // namespace galileo
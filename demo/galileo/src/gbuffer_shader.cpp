@@ -12,8 +12,11 @@
 #include <vkrndr_pipeline_layout_builder.hpp>
 #include <vkrndr_shader_module.hpp>
 
+#include <BS_thread_pool.hpp>
+
 #include <boost/scope/defer.hpp>
 
+#include <array>
 #include <cassert>
 
 // IWYU pragma: no_include <expected>
@@ -24,6 +27,7 @@
 // IWYU pragma: no_include <system_error>
 
 galileo::gbuffer_shader_t::gbuffer_shader_t(vkrndr::backend_t& backend,
+    BS::thread_pool<>& thread_pool,
     VkDescriptorSetLayout frame_info_layout,
     VkDescriptorSetLayout materials_layout,
     VkDescriptorSetLayout graph_layout,
@@ -33,22 +37,25 @@ galileo::gbuffer_shader_t::gbuffer_shader_t(vkrndr::backend_t& backend,
     vkglsl::shader_set_t shader_set{enable_shader_debug_symbols,
         enable_shader_optimization};
 
-    auto vertex_shader{add_shader_module_from_path(shader_set,
-        backend_->device(),
-        VK_SHADER_STAGE_VERTEX_BIT,
-        "gbuffer.vert")};
-    assert(vertex_shader);
-    boost::scope::defer_guard destroy_vtx{[this, &shd = vertex_shader.value()]()
-        { destroy(backend_->device(), shd); }};
-
-    auto fragment_shader{add_shader_module_from_path(shader_set,
+    std::array const sources{
+        vkglsl::shader_source_t{.stage = VK_SHADER_STAGE_VERTEX_BIT,
+            .file = "gbuffer.vert"},
+        vkglsl::shader_source_t{.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
+            .file = "gbuffer.frag"}};
+    auto shaders{add_shader_modules_from_paths(shader_set,
         backend_->device(),
-        VK_SHADER_STAGE_FRAGMENT_BIT,
-        "gbuffer.frag")};
-    assert(fragment_shader);
-    boost::scope::defer_guard destroy_frag{
-        [this, &shd = fragment_shader.value()]()
-        { destroy(backend_->device(), shd); }};
+        sources,
+        &thread_pool)};
+    assert(shaders);
+    boost::scope::defer_guard destroy_shaders{[this, &shd = shaders.value()]()
+        {
+            for (vkrndr::shader_module_t const& shader : shd)
+            {
+                destroy(backend_->device(), shader);
+            }
+        }};
+    vkrndr::shader_module_t const& vertex_shader{(*shaders)[0]};
+    vkrndr::shader_module_t const& fragment_shader{(*shaders)[1]};
 
     pipeline_layout_ = vkrndr::pipeline_layout_builder_t{backend_->device()}
                            .add_descriptor_set_layout(frame_info_layout)
@@ -58,8 +65,8 @@ galileo::gbuffer_shader_t::gbuffer_shader_t(vkrndr::backend_t& backend,
 
     pipeline_ = vkrndr::graphics_pipeline_builder_t{backend_->device(),
         pipeline_layout_}
-                    .add_shader(as_pipeline_shader(*vertex_shader))
-                    .add_shader(as_pipeline_shader(*fragment_shader))
+                    .add_shader(as_pipeline_shader(vertex_shader))
+                    .add_shader(as_pipeline_shader(fragment_shader))
                     .add_color_attachment(gbuffer_t::position_format)
                     .add_color_attachment(gbuffer_t::normal_format)
                     .add_color_attachment(gbuffer_t::albedo_format)
@@ -3,6 +3,8 @@
 
 #include <vkrndr_pipeline.hpp>
 
+#include <BS_thread_pool.hpp> // IWYU pragma: keep
+
 #include <volk.h>
 
 namespace vkrndr
@@ -20,7 +22,8 @@ namespace galileo
     class [[nodiscard]] gbuffer_shader_t final
     {
     public:
-        explicit gbuffer_shader_t(vkrndr::backend_t& backend,
+        gbuffer_shader_t(vkrndr::backend_t& backend,
+            BS::thread_pool<>& thread_pool,
             VkDescriptorSetLayout frame_info_layout,
             VkDescriptorSetLayout materials_layout,
             VkDescriptorSetLayout graph_layout,
@@ -1,58 +1,63 @@
 #include <scene_graph.hpp>
 
+#include <config.hpp>
+
 #include <cppext_container.hpp>
 #include <cppext_cycled_buffer.hpp>
 #include <cppext_numeric.hpp>
 
 #include <ngnast_gpu_transfer.hpp>
+#include <ngnast_mesh_transform.hpp>
 #include <ngnast_scene_model.hpp>
+#include <ngnast_transform_hierarchy.hpp>
+
+#include <ngngfx_frustum.hpp>
+
+#include <vkglsl_shader_set.hpp>
 
 #include <vkrndr_backend.hpp>
 #include <vkrndr_buffer.hpp>
+#include <vkrndr_compute_pipeline_builder.hpp>
+#include <vkrndr_debug_utils.hpp>
 #include <vkrndr_descriptors.hpp>
 #include <vkrndr_device.hpp>
+#include <vkrndr_linear_allocator.hpp>
 #include <vkrndr_memory.hpp>
+#include <vkrndr_pipeline.hpp>
+#include <vkrndr_pipeline_layout_builder.hpp>
+#include <vkrndr_shader_module.hpp>
+#include <vkrndr_synchronization.hpp>
 #include <vkrndr_utility.hpp>
 
 #include <boost/scope/defer.hpp>
 
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <glm/mat4x4.hpp>
-#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
-#include <vma_impl.hpp>
-
 #include <volk.h>
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <initializer_list>
 #include <iterator>
-#include <ranges>
+#include <limits>
 #include <span>
+#include <vector>
 
 // IWYU pragma: no_include <expected>
+// IWYU pragma: no_include <filesystem>
 // IWYU pragma: no_include <optional>
 // IWYU pragma: no_include <string>
-// IWYU pragma: no_include <vector>
 
 namespace
 {
-    constexpr size_t max_instance_count{1000};
-
-    struct [[nodiscard]] graph_vertex_t final
-    {
-        glm::vec3 position;
-        char padding1;
-        glm::vec3 normal;
-        char padding2;
-        glm::vec4 color;
-        glm::vec2 uv;
-    };
-
     struct [[nodiscard]] graph_instance_vertex_t final
     {
         uint32_t primitive;
@@ -64,8 +69,53 @@ namespace
         glm::mat4 position;
         uint32_t material;
         uint8_t padding[12];
+        // Dequantization of packed vertex positions
+        glm::vec4 position_offset;
+        glm::vec4 position_scale;
+    };
+
+    struct [[nodiscard]] gpu_primitive_t final
+    {
+        uint32_t count;
+        uint32_t first;
+        int32_t vertex_offset;
+        uint32_t indexed;
+    };
+
+    // Header of the counter buffer, followed by a counter per primitive
+    struct [[nodiscard]] gpu_draw_counters_t final
+    {
+        uint32_t indexed_draw_count;
+        uint32_t draw_count;
+        uint32_t instance_cursor;
+        uint32_t padding;
+    };
+
+    struct [[nodiscard]] gpu_primitive_counter_t final
+    {
+        uint32_t instance_count;
+        uint32_t cursor;
+    };
+
+    // Counts instances of each primitive, builds draw commands with a
+    // contiguous instance range for each primitive and scatters the instances
+    // into their ranges
+    enum class draw_commands_phase_t : uint32_t
+    {
+        count,
+        build,
+        scatter
     };
 
+    struct [[nodiscard]] push_constants_t final
+    {
+        draw_commands_phase_t phase;
+        uint32_t instance_count;
+        uint32_t primitive_count;
+    };
+
+    constexpr uint32_t draw_commands_group_size{64};
+
     [[nodiscard]] VkDescriptorSetLayout create_descriptor_set_layout(
         vkrndr::device_t const& device)
     {
@@ -103,11 +153,54 @@ namespace
             nullptr);
     }
 
-    galileo::render_node_t to_render_node(ngnast::node_t const& n)
+    void update_draw_commands_descriptor_set(vkrndr::device_t const& device,
+        VkDescriptorSet const descriptor_set,
+        std::array<VkDescriptorBufferInfo, 6> const& buffer_infos)
+    {
+        std::array<VkWriteDescriptorSet, 6> descriptor_writes{};
+        for (uint32_t i{}; i != descriptor_writes.size(); ++i)
+        {
+            VkWriteDescriptorSet& write{descriptor_writes[i]};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = descriptor_set;
+            write.dstBinding = i;
+            write.dstArrayElement = 0;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            write.descriptorCount = 1;
+            write.pBufferInfo = &buffer_infos[i];
+        }
+
+        vkUpdateDescriptorSets(device,
+            vkrndr::count_cast(descriptor_writes),
+            descriptor_writes.data(),
+            0,
+            nullptr);
+    }
+
+    void wait_for_draw_commands(VkCommandBuffer command_buffer,
+        VkPipelineStageFlags2 const src_stage,
+        VkAccessFlags2 const src_access,
+        VkPipelineStageFlags2 const dst_stage,
+        VkAccessFlags2 const dst_access)
+    {
+        auto const barrier{vkrndr::with_access(
+            vkrndr::on_stage(vkrndr::memory_barrier(), src_stage, dst_stage),
+            src_access,
+            dst_access)};
+        vkrndr::wait_for(command_buffer, cppext::as_span(barrier), {}, {});
+    }
+
+    [[nodiscard]] constexpr uint32_t group_count(uint32_t const count)
     {
-        return {.matrix = n.matrix,
-            .mesh_index = n.mesh_index,
-            .child_indices = n.child_indices};
+        return (count + draw_commands_group_size - 1) /
+            draw_commands_group_size;
+    }
+
+    [[nodiscard]] float max_scale(glm::mat4 const& matrix)
+    {
+        return glm::max(glm::max(glm::length(glm::vec3{matrix[0]}),
+                            glm::length(glm::vec3{matrix[1]})),
+            glm::length(glm::vec3{matrix[2]}));
     }
 } // namespace
 
@@ -116,11 +209,14 @@ galileo::scene_graph_t::binding_description()
 {
     static constexpr std::array descriptions{
         VkVertexInputBindingDescription{.binding = 0,
-            .stride = sizeof(graph_vertex_t),
+            .stride = sizeof(ngnast::gpu::packed_vertex_t),
             .inputRate = VK_VERTEX_INPUT_RATE_VERTEX},
         VkVertexInputBindingDescription{.binding = 1,
             .stride = sizeof(graph_instance_vertex_t),
             .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE},
+        VkVertexInputBindingDescription{.binding = 2,
+            .stride = sizeof(uint32_t),
+            .inputRate = VK_VERTEX_INPUT_RATE_VERTEX},
     };
 
     return descriptions;
@@ -132,20 +228,20 @@ galileo::scene_graph_t::attribute_description()
     static constexpr std::array descriptions{
         VkVertexInputAttributeDescription{.location = 0,
             .binding = 0,
-            .format = VK_FORMAT_R32G32B32_SFLOAT,
-            .offset = offsetof(graph_vertex_t, position)},
+            .format = ngnast::gpu::packed_position_format,
+            .offset = offsetof(ngnast::gpu::packed_vertex_t, position)},
         VkVertexInputAttributeDescription{.location = 1,
             .binding = 0,
-            .format = VK_FORMAT_R32G32B32_SFLOAT,
-            .offset = offsetof(graph_vertex_t, normal)},
+            .format = ngnast::gpu::packed_direction_format,
+            .offset = offsetof(ngnast::gpu::packed_vertex_t, normal)},
         VkVertexInputAttributeDescription{.location = 2,
-            .binding = 0,
-            .format = VK_FORMAT_R32G32B32A32_SFLOAT,
-            .offset = offsetof(graph_vertex_t, color)},
+            .binding = 2,
+            .format = ngnast::gpu::packed_color_format,
+            .offset = 0},
         VkVertexInputAttributeDescription{.location = 3,
             .binding = 0,
-            .format = VK_FORMAT_R32G32_SFLOAT,
-            .offset = offsetof(graph_vertex_t, uv)},
+            .format = ngnast::gpu::packed_uv_format,
+            .offset = offsetof(ngnast::gpu::packed_vertex_t, uv)},
         VkVertexInputAttributeDescription{.location = 4,
             .binding = 1,
             .format = VK_FORMAT_R32_UINT,
@@ -160,39 +256,51 @@ galileo::scene_graph_t::scene_graph_t(vkrndr::backend_t& backend)
     , descriptor_set_layout_{create_descriptor_set_layout(backend_->device())}
     , frame_data_{backend_->frames_in_flight(), backend_->frames_in_flight()}
 {
-    for (auto& data : cppext::as_span(frame_data_))
+    vkglsl::shader_set_t shader_set{enable_shader_debug_symbols,
+        enable_shader_optimization};
+
+    auto shader{add_shader_module_from_path(shader_set,
+        backend_->device(),
+        VK_SHADER_STAGE_COMPUTE_BIT,
+        "draw_commands.comp")};
+    assert(shader);
+    boost::scope::defer_guard destroy_shd{[this, &shd = shader.value()]()
+        { destroy(backend_->device(), shd); }};
+
+    // Qualified, the member function hides the free function
+    if (auto const layout{
+            vkglsl::descriptor_set_layout(shader_set, backend_->device(), 0)})
+    {
+        draw_commands_descriptor_set_layout_ = *layout;
+    }
+    else
     {
-        data.instance_vertex_buffer = vkrndr::create_buffer(backend_->device(),
-            {.size = sizeof(graph_instance_vertex_t) * max_instance_count,
-                .usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                .allocation_flags =
-                    VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
-                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
-                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT});
-
-        data.instance_map =
-            vkrndr::map_memory(backend_->device(), data.instance_vertex_buffer);
-
-        data.uniform = vkrndr::create_buffer(backend_->device(),
-            {.size = sizeof(gpu_render_node_t) * max_instance_count,
-                .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                .allocation_flags =
-                    VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
-                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
-                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
-                    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT});
-
-        data.uniform_map = vkrndr::map_memory(backend_->device(), data.uniform);
+        assert(false);
+    }
+
+    draw_commands_pipeline_layout_ =
+        vkrndr::pipeline_layout_builder_t{backend_->device()}
+            .add_push_constants<push_constants_t>(VK_SHADER_STAGE_COMPUTE_BIT)
+            .add_descriptor_set_layout(draw_commands_descriptor_set_layout_)
+            .build();
 
+    draw_commands_pipeline_ =
+        vkrndr::compute_pipeline_builder_t{backend_->device(),
+            draw_commands_pipeline_layout_}
+            .with_shader(as_pipeline_shader(*shader))
+            .build();
+
+    for (auto& data : cppext::as_span(frame_data_))
+    {
         vkrndr::check_result(allocate_descriptor_sets(backend_->device(),
             backend_->descriptor_pool(),
             cppext::as_span(descriptor_set_layout_),
             cppext::as_span(data.descriptor_set)));
 
-        update_descriptor_set(backend_->device(),
-            data.descriptor_set,
-            vkrndr::buffer_descriptor(data.uniform));
+        vkrndr::check_result(allocate_descriptor_sets(backend_->device(),
+            backend_->descriptor_pool(),
+            cppext::as_span(draw_commands_descriptor_set_layout_),
+            cppext::as_span(data.draw_commands_descriptor_set)));
     }
 }
 
@@ -200,26 +308,35 @@ galileo::scene_graph_t::~scene_graph_t()
 {
     for (auto& data : cppext::as_span(frame_data_))
     {
+        destroy_draw_buffers(data);
+
         free_descriptor_sets(backend_->device(),
             backend_->descriptor_pool(),
-            cppext::as_span(data.descriptor_set));
-
-        vkrndr::unmap_memory(backend_->device(), &data.uniform_map);
-
-        vkrndr::destroy(backend_->device(), data.uniform);
+            cppext::as_span(data.draw_commands_descriptor_set));
 
-        vkrndr::unmap_memory(backend_->device(), &data.instance_map);
-
-        vkrndr::destroy(backend_->device(), data.instance_vertex_buffer);
+        free_descriptor_sets(backend_->device(),
+            backend_->descriptor_pool(),
+            cppext::as_span(data.descriptor_set));
     }
 
+    destroy(backend_->device(), primitive_buffer_);
+
     destroy(backend_->device(), index_buffer_);
 
+    destroy(backend_->device(), color_buffer_);
+
     destroy(backend_->device(), vertex_buffer_);
 
     vkDestroyDescriptorSetLayout(backend_->device(),
         descriptor_set_layout_,
         nullptr);
+
+    destroy(backend_->device(), draw_commands_pipeline_);
+    destroy(backend_->device(), draw_commands_pipeline_layout_);
+
+    vkDestroyDescriptorSetLayout(backend_->device(),
+        draw_commands_descriptor_set_layout_,
+        nullptr);
 }
 
 VkDescriptorSetLayout galileo::scene_graph_t::descriptor_set_layout() const
@@ -229,15 +346,24 @@ VkDescriptorSetLayout galileo::scene_graph_t::descriptor_set_layout() const
 
 void galileo::scene_graph_t::consume(ngnast::scene_model_t& model)
 {
-    nodes_.clear();
+    node_meshes_.clear();
     meshes_.clear();
     primitives_.clear();
 
+    for (ngnast::primitive_t& primitive : model.primitives)
+    {
+        ngnast::mesh::generate_lods(primitive);
+    }
+
     auto transfer_result{
-        ngnast::gpu::transfer_geometry(backend_->device(), model)};
+        ngnast::gpu::transfer_geometry(backend_->device(),
+            model,
+            {.vertex_format = ngnast::gpu::vertex_format_t::packed,
+                .require_color_stream = true})};
     boost::scope::defer_guard destroy_transfer{[this, &transfer_result]()
         { destroy(backend_->device(), transfer_result); }};
 
+    std::vector<ngnast::gpu::primitive_t const*> lod_sources;
     for (ngnast::mesh_t const& mesh : model.meshes)
     {
         auto const first{primitives_.size()};
@@ -245,53 +371,71 @@ void galileo::scene_graph_t::consume(ngnast::scene_model_t& model)
         {
             auto const& gp{transfer_result.primitives[pi]};
 
-            primitives_.emplace_back(0,
-                gp.topology,
+            primitives_.emplace_back(gp.topology,
                 gp.count,
                 gp.first,
                 gp.is_indexed,
                 gp.vertex_offset,
-                gp.material_index);
+                gp.material_index,
+                gp.position_offset,
+                gp.position_scale);
+            lod_sources.push_back(&gp);
         }
 
-        meshes_.emplace_back(first, mesh.primitive_indices.size());
+        meshes_.emplace_back(first,
+            mesh.primitive_indices.size(),
+            (mesh.bounding_box.min + mesh.bounding_box.max) * 0.5f,
+            glm::distance(mesh.bounding_box.min, mesh.bounding_box.max) *
+                0.5f,
+            mesh.bounding_box.min,
+            mesh.bounding_box.max);
     }
-    std::ranges::transform(model.nodes,
-        std::back_inserter(nodes_),
-        to_render_node);
+
+    for (size_t i{}; i != lod_sources.size(); ++i)
+    {
+        ngnast::gpu::primitive_t const& gp{*lod_sources[i]};
+
+        primitives_[i].first_lod = primitives_.size();
+        primitives_[i].lod_count = gp.lods.size();
+
+        for (ngnast::gpu::lod_t const& lod : gp.lods)
+        {
+            primitives_.emplace_back(gp.topology,
+                lod.count,
+                lod.first,
+                true,
+                gp.vertex_offset,
+                gp.material_index,
+                gp.position_offset,
+                gp.position_scale,
+                0,
+                0,
+                lod.error);
+        }
+    }
+
+    hierarchy_ = ngnast::flatten_hierarchy(model);
+    std::ranges::transform(hierarchy_.node_indices,
+        std::back_inserter(node_meshes_),
+        [&model](size_t const i) { return model.nodes[i].mesh_index; });
 
     destroy(backend_->device(), vertex_buffer_);
     vertex_buffer_ = vkrndr::create_buffer(backend_->device(),
-        {.size = sizeof(graph_vertex_t) *
-                (transfer_result.vertex_buffer.size /
-                    sizeof(ngnast::gpu::vertex_t)),
+        {.size = transfer_result.vertex_buffer.size,
             .usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
                 VK_BUFFER_USAGE_TRANSFER_DST_BIT,
             .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
-    {
-        auto staging{vkrndr::create_staging_buffer(backend_->device(),
-            vertex_buffer_.size)};
-        auto staging_map{vkrndr::map_memory(backend_->device(), staging)};
-        auto* const vertices{staging_map.as<graph_vertex_t>()};
 
-        auto gltf_map{vkrndr::map_memory(backend_->device(),
-            transfer_result.vertex_buffer)};
-        auto* const gltf_vertices{gltf_map.as<ngnast::gpu::vertex_t>()};
+    backend_->transfer_buffer(transfer_result.vertex_buffer, vertex_buffer_);
 
-        for (uint32_t i{}; i != transfer_result.vertex_count; ++i)
-        {
-            vertices[i].position = gltf_vertices[i].position;
-            vertices[i].normal = gltf_vertices[i].normal;
-            vertices[i].color = gltf_vertices[i].color;
-            vertices[i].uv = {gltf_vertices[i].uv_s, gltf_vertices[i].uv_t};
-        }
+    destroy(backend_->device(), color_buffer_);
+    color_buffer_ = vkrndr::create_buffer(backend_->device(),
+        {.size = transfer_result.color_buffer.size,
+            .usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
 
-        unmap_memory(backend_->device(), &gltf_map);
-        unmap_memory(backend_->device(), &staging_map);
-
-        backend_->transfer_buffer(staging, vertex_buffer_);
-        destroy(backend_->device(), staging);
-    }
+    backend_->transfer_buffer(transfer_result.color_buffer, color_buffer_);
 
     destroy(backend_->device(), index_buffer_);
     index_buffer_ = vkrndr::create_buffer(backend_->device(),
@@ -301,60 +445,322 @@ void galileo::scene_graph_t::consume(ngnast::scene_model_t& model)
             .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
 
     backend_->transfer_buffer(transfer_result.index_buffer, index_buffer_);
+
+    // Descriptor ranges can't be empty
+    vkrndr::buffer_t const staging_buffer{create_staging_buffer(
+        backend_->device(),
+        sizeof(gpu_primitive_t) * std::max(primitives_.size(), size_t{1}))};
+    vkrndr::mapped_memory_t staging_map{
+        map_memory(backend_->device(), staging_buffer)};
+    std::ranges::transform(primitives_,
+        staging_map.as<gpu_primitive_t>(),
+        [](render_primitive_t const& p)
+        {
+            return gpu_primitive_t{.count = p.count,
+                .first = p.first,
+                .vertex_offset = p.vertex_offset,
+                .indexed = p.is_indexed ? 1U : 0U};
+        });
+    unmap_memory(backend_->device(), &staging_map);
+
+    destroy(backend_->device(), primitive_buffer_);
+    primitive_buffer_ = vkrndr::create_buffer(backend_->device(),
+        {.size = staging_buffer.size,
+            .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
+
+    backend_->transfer_buffer(staging_buffer, primitive_buffer_);
+
+    destroy(backend_->device(), staging_buffer);
+}
+
+void galileo::scene_graph_t::update_lod(glm::vec3 const& camera_position,
+    float const projection_scale)
+{
+    camera_position_ = camera_position;
+    projection_scale_ = projection_scale;
+}
+
+void galileo::scene_graph_t::update_frustum(ngngfx::frustum_t const& frustum)
+{
+    frustum_ = frustum;
 }
 
 void galileo::scene_graph_t::begin_frame()
 {
-    frame_data_.cycle(
-        [](frame_data_t const&, frame_data_t& next) { next.current_draw = 0; });
+    frame_data_.cycle([](frame_data_t const&, frame_data_t& next)
+        { next.instances = next.render_nodes = {}; });
 
-    std::ranges::for_each(primitives_,
-        [](render_primitive_t& p) { p.instance_count = 0; });
+    draws_.clear();
+    draw_bounds_.clear();
 }
 
 void galileo::scene_graph_t::update(size_t const index,
     glm::mat4 const& position)
 {
-    auto* const gpu_instance{
-        frame_data_->instance_map.as<graph_instance_vertex_t>()};
-
-    auto* const gpu_uniform{frame_data_->uniform_map.as<gpu_render_node_t>()};
+    uint32_t const root{hierarchy_.positions[index]};
+    assert(root != ngnast::transform_hierarchy_t::no_position);
 
-    auto const& node{nodes_[index]};
+    ngnast::update_world_matrices(hierarchy_, root, position);
 
-    if (node.mesh_index)
+    // Subtree is a contiguous range of positions starting at its root
+    uint32_t const last{root + hierarchy_.subtree_sizes[root]};
+    for (uint32_t node{root}; node != last; ++node)
     {
-        auto const& mesh{meshes_[*node.mesh_index]};
+        if (!node_meshes_[node])
+        {
+            continue;
+        }
+
+        auto const& mesh{meshes_[*node_meshes_[node]]};
+        glm::mat4 const& world{hierarchy_.world_matrices[node]};
+
+        float const pixels_per_unit{mesh_pixels_per_unit(mesh, world)};
+
+        ngnast::bounding_box_t const bounds{
+            ngnast::calculate_aabb({mesh.min, mesh.max}, world)};
+        size_t const bounds_index{draw_bounds_.size()};
+        draw_bounds_.push_back(bounds.min, bounds.max);
 
-        auto const last{mesh.first_primitive + mesh.count};
-        for (auto i{mesh.first_primitive}; i != last; ++i)
+        auto const last_primitive{mesh.first_primitive + mesh.count};
+        for (auto i{mesh.first_primitive}; i != last_primitive; ++i)
         {
-            auto& primitive{primitives_[i]};
+            // Coarsest level of detail whose projected error is below a pixel
+            size_t lod_index{i};
+            for (size_t l{}; l != primitives_[i].lod_count; ++l)
+            {
+                size_t const candidate{primitives_[i].first_lod + l};
+                if (primitives_[candidate].lod_error * pixels_per_unit > 1.0f)
+                {
+                    break;
+                }
+                lod_index = candidate;
+            }
+
+            draws_.emplace_back(lod_index, world, bounds_index);
+        }
+    }
+}
+
+void galileo::scene_graph_t::prepare_draws(VkCommandBuffer command_buffer)
+{
+    cull();
+
+    upload();
+
+    frame_data_t& data{*frame_data_};
+
+    reserve_draw_buffers(data);
+
+    update_draw_commands_descriptor_set(backend_->device(),
+        data.draw_commands_descriptor_set,
+        {VkDescriptorBufferInfo{.buffer = data.instances.buffer,
+             .offset = data.instances.offset,
+             .range = data.instances.size},
+            VkDescriptorBufferInfo{.buffer = primitive_buffer_,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE},
+            VkDescriptorBufferInfo{.buffer = data.counters,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE},
+            VkDescriptorBufferInfo{.buffer = data.indexed_commands,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE},
+            VkDescriptorBufferInfo{.buffer = data.commands,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE},
+            VkDescriptorBufferInfo{.buffer = data.sorted_instances,
+                .offset = 0,
+                .range = VK_WHOLE_SIZE}});
+
+    VKRNDR_IF_DEBUG_UTILS(
+        [[maybe_unused]] vkrndr::command_buffer_scope_t const cb_scope{
+            command_buffer,
+            "Draw Commands"});
+
+    vkCmdFillBuffer(command_buffer, data.counters, 0, VK_WHOLE_SIZE, 0);
+
+    wait_for_draw_commands(command_buffer,
+        VK_PIPELINE_STAGE_2_CLEAR_BIT,
+        VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+            VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+
+    vkrndr::bind_pipeline(command_buffer,
+        draw_commands_pipeline_,
+        0,
+        cppext::as_span(data.draw_commands_descriptor_set));
+
+    push_constants_t pc{
+        .instance_count = cppext::narrow<uint32_t>(draws_.size()),
+        .primitive_count = cppext::narrow<uint32_t>(primitives_.size())};
+    for (draw_commands_phase_t const phase :
+        {draw_commands_phase_t::count,
+            draw_commands_phase_t::build,
+            draw_commands_phase_t::scatter})
+    {
+        if (phase != draw_commands_phase_t::count)
+        {
+            wait_for_draw_commands(command_buffer,
+                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+                VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+                    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+        }
 
-            gpu_instance[frame_data_->current_draw] = {
-                .primitive = cppext::narrow<uint32_t>(i),
-                .index = frame_data_->current_draw};
+        pc.phase = phase;
+        vkCmdPushConstants(command_buffer,
+            draw_commands_pipeline_.layout,
+            VK_SHADER_STAGE_COMPUTE_BIT,
+            0,
+            sizeof(pc),
+            &pc);
+
+        vkCmdDispatch(command_buffer,
+            group_count(phase == draw_commands_phase_t::build
+                    ? pc.primitive_count
+                    : pc.instance_count),
+            1,
+            1);
+    }
+
+    wait_for_draw_commands(command_buffer,
+        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+        VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT |
+            VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT,
+        VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT |
+            VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT);
+}
+
+void galileo::scene_graph_t::cull()
+{
+    visible_.resize(draw_bounds_.size());
+    ngngfx::frustum_cull(frustum_, draw_bounds_, visible_);
 
-            gpu_uniform[frame_data_->current_draw].material =
-                cppext::narrow<uint32_t>(primitive.material_index);
-            gpu_uniform[frame_data_->current_draw].position = position;
+    std::erase_if(draws_,
+        [this](draw_t const& draw) { return visible_[draw.bounds] == 0; });
+}
 
-            ++primitive.instance_count;
-            ++frame_data_->current_draw;
+void galileo::scene_graph_t::upload()
+{
+    // Descriptor ranges can't be empty
+    size_t const count{std::max(draws_.size(), size_t{1})};
+
+    vkrndr::linear_allocator_t& allocator{backend_->frame_allocator()};
+    frame_data_->instances = allocator.allocate<graph_instance_vertex_t>(count);
+    // Structure is aligned to 16 bytes in std430 layout
+    frame_data_->render_nodes =
+        allocator.allocate(sizeof(gpu_render_node_t) * count, 16);
+
+    std::span const instances{
+        frame_data_->instances.as<graph_instance_vertex_t>()};
+    std::span const render_nodes{
+        frame_data_->render_nodes.as<gpu_render_node_t>()};
+    for (size_t i{}; i != draws_.size(); ++i)
+    {
+        draw_t const& draw{draws_[i]};
+        render_primitive_t const& primitive{primitives_[draw.primitive]};
+
+        instances[i] = {.primitive = cppext::narrow<uint32_t>(draw.primitive),
+            .index = cppext::narrow<uint32_t>(i)};
+
+        render_nodes[i].material =
+            cppext::narrow<uint32_t>(primitive.material_index);
+        render_nodes[i].position = draw.position;
+        render_nodes[i].position_offset =
+            glm::vec4{primitive.position_offset, 0.0f};
+        render_nodes[i].position_scale =
+            glm::vec4{primitive.position_scale, 0.0f};
+    }
+
+    update_descriptor_set(backend_->device(),
+        frame_data_->descriptor_set,
+        {.buffer = frame_data_->render_nodes.buffer,
+            .offset = frame_data_->render_nodes.offset,
+            .range = frame_data_->render_nodes.size});
+}
+
+void galileo::scene_graph_t::reserve_draw_buffers(frame_data_t& data)
+{
+    // The frame slot is no longer used by the device, buffers can be
+    // recreated immediately
+    auto const reserve = [this](vkrndr::buffer_t& buffer,
+                             VkDeviceSize const size,
+                             VkBufferUsageFlags const usage)
+    {
+        if (buffer.size >= size)
+        {
+            return;
         }
+
+        destroy(backend_->device(), buffer);
+        buffer = vkrndr::create_buffer(backend_->device(),
+            {.size = size,
+                .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | usage,
+                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
+    };
+
+    // Descriptor ranges can't be empty
+    size_t const primitive_count{std::max(primitives_.size(), size_t{1})};
+    // Number of instances changes between frames, grow geometrically to
+    // avoid recreating the buffer each time an instance is added
+    size_t const instance_count{std::bit_ceil(draws_.size())};
+
+    reserve(data.counters,
+        sizeof(gpu_draw_counters_t) +
+            sizeof(gpu_primitive_counter_t) * primitive_count,
+        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    reserve(data.indexed_commands,
+        sizeof(VkDrawIndexedIndirectCommand) * primitive_count,
+        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+    reserve(data.commands,
+        sizeof(VkDrawIndirectCommand) * primitive_count,
+        VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+    reserve(data.sorted_instances,
+        sizeof(graph_instance_vertex_t) * instance_count,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+}
+
+void galileo::scene_graph_t::destroy_draw_buffers(frame_data_t& data)
+{
+    destroy(backend_->device(), data.sorted_instances);
+    destroy(backend_->device(), data.commands);
+    destroy(backend_->device(), data.indexed_commands);
+    destroy(backend_->device(), data.counters);
+}
+
+float galileo::scene_graph_t::mesh_pixels_per_unit(render_mesh_t const& mesh,
+    glm::mat4 const& position) const
+{
+    // Full detail until the view is known or when camera is inside the bounds
+    if (projection_scale_ == 0.0f)
+    {
+        return std::numeric_limits<float>::max();
     }
 
-    glm::mat4 const new_position{position * node.matrix};
-    for (auto const child : node.child_indices)
+    float const scale{max_scale(position)};
+    glm::vec3 const center{position * glm::vec4{mesh.center, 1.0f}};
+    float const distance{
+        glm::distance(camera_position_, center) - mesh.radius * scale};
+    if (distance <= 0.0f)
     {
-        update(child, new_position);
+        return std::numeric_limits<float>::max();
     }
+
+    return projection_scale_ * scale / distance;
 }
 
 void galileo::scene_graph_t::bind_on(VkCommandBuffer command_buffer,
     VkPipelineLayout layout,
     VkPipelineBindPoint const bind_point)
 {
+    assert(frame_data_->instances.buffer != VK_NULL_HANDLE);
+
     vkCmdBindDescriptorSets(command_buffer,
         bind_point,
         layout,
@@ -364,13 +770,14 @@ void galileo::scene_graph_t::bind_on(VkCommandBuffer command_buffer,
         0,
         nullptr);
 
-    std::array<VkBuffer, 2> const vertex_buffers{vertex_buffer_,
-        frame_data_->instance_vertex_buffer};
-    std::array<VkDeviceSize, 2> const vertex_offsets{0, 0};
+    std::array<VkBuffer, 3> const vertex_buffers{vertex_buffer_,
+        frame_data_->sorted_instances.handle,
+        color_buffer_};
+    std::array<VkDeviceSize, 3> const vertex_offsets{0, 0, 0};
 
     vkCmdBindVertexBuffers(command_buffer,
         0,
-        2,
+        3,
         vertex_buffers.data(),
         vertex_offsets.data());
 
@@ -382,38 +789,23 @@ void galileo::scene_graph_t::bind_on(VkCommandBuffer command_buffer,
 
 void galileo::scene_graph_t::draw(VkCommandBuffer command_buffer)
 {
-    auto* const instances{
-        frame_data_->instance_map.as<graph_instance_vertex_t>()};
-
-    std::span const instance_range{instances,
-        instances + frame_data_->current_draw};
-    std::ranges::sort(instance_range,
-        std::less{},
-        &graph_instance_vertex_t::primitive);
-
-    uint32_t current_instance{};
-    for (auto& primitive : primitives_ |
-            std::views::filter(
-                [](auto const& p) { return p.instance_count > 0; }))
-    {
-        if (primitive.is_indexed)
-        {
-            vkCmdDrawIndexed(command_buffer,
-                primitive.count,
-                primitive.instance_count,
-                primitive.first,
-                primitive.vertex_offset,
-                current_instance);
-        }
-        else
-        {
-            vkCmdDraw(command_buffer,
-                primitive.count,
-                primitive.instance_count,
-                primitive.first,
-                current_instance);
-        }
+    // Each primitive has at most one draw command
+    uint32_t const max_draw_count{
+        cppext::narrow<uint32_t>(primitives_.size())};
 
-        current_instance += primitive.instance_count;
-    }
+    vkCmdDrawIndexedIndirectCount(command_buffer,
+        frame_data_->indexed_commands,
+        0,
+        frame_data_->counters,
+        offsetof(gpu_draw_counters_t, indexed_draw_count),
+        max_draw_count,
+        sizeof(VkDrawIndexedIndirectCommand));
+
+    vkCmdDrawIndirectCount(command_buffer,
+        frame_data_->commands,
+        0,
+        frame_data_->counters,
+        offsetof(gpu_draw_counters_t, draw_count),
+        max_draw_count,
+        sizeof(VkDrawIndirectCommand));
 }
@@ -3,10 +3,16 @@
 
 #include <cppext_cycled_buffer.hpp>
 
+#include <ngnast_transform_hierarchy.hpp>
+
+#include <ngngfx_frustum.hpp>
+
 #include <vkrndr_buffer.hpp>
-#include <vkrndr_memory.hpp>
+#include <vkrndr_linear_allocator.hpp>
+#include <vkrndr_pipeline.hpp>
 
 #include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
 
 #include <volk.h>
 
@@ -30,8 +36,6 @@ namespace galileo
 {
     struct [[nodiscard]] render_primitive_t final
     {
-        uint32_t instance_count;
-
         VkPrimitiveTopology topology;
 
         uint32_t count;
@@ -41,19 +45,28 @@ namespace galileo
         int32_t vertex_offset;
 
         size_t material_index;
+
+        glm::vec3 position_offset;
+        glm::vec3 position_scale;
+
+        // Coarser levels of detail are stored as separate primitives
+        size_t first_lod{};
+        size_t lod_count{};
+        float lod_error{};
     };
 
     struct [[nodiscard]] render_mesh_t final
     {
         size_t first_primitive;
         size_t count;
-    };
 
-    struct [[nodiscard]] render_node_t final
-    {
-        glm::mat4 matrix{1.0f};
-        std::optional<size_t> mesh_index;
-        std::vector<size_t> child_indices;
+        // Bounding sphere in model space
+        glm::vec3 center;
+        float radius;
+
+        // Bounding box in model space
+        glm::vec3 min;
+        glm::vec3 max;
     };
 
     class [[nodiscard]] scene_graph_t final
@@ -80,10 +93,24 @@ namespace galileo
 
         void consume(ngnast::scene_model_t& model);
 
+        // Levels of detail are selected based on camera position, projection
+        // scale is viewport height / (2 * tan(fov / 2))
+        void update_lod(glm::vec3 const& camera_position,
+            float projection_scale);
+
+        // Meshes outside of the frustum aren't drawn
+        void update_frustum(ngngfx::frustum_t const& frustum);
+
         void begin_frame();
 
+        // Draws the subtree of the node, position replaces the matrix of the
+        // node itself
         void update(size_t index, glm::mat4 const& position);
 
+        // Builds draw commands of the frame on the device, has to be recorded
+        // outside of a render pass before the graph is bound
+        void prepare_draws(VkCommandBuffer command_buffer);
+
         void bind_on(VkCommandBuffer command_buffer,
             VkPipelineLayout layout,
             VkPipelineBindPoint bind_point);
@@ -96,32 +123,76 @@ namespace galileo
         scene_graph_t& operator=(scene_graph_t&&) noexcept = delete;
 
     private:
-        struct [[nodiscard]] frame_data_t final
+        struct [[nodiscard]] draw_t final
         {
-            vkrndr::buffer_t instance_vertex_buffer;
-            vkrndr::mapped_memory_t instance_map;
+            size_t primitive;
+            glm::mat4 position;
+            // Index of the world space bounding box of the mesh
+            size_t bounds;
+        };
 
-            vkrndr::buffer_t uniform;
-            vkrndr::mapped_memory_t uniform_map;
+        struct [[nodiscard]] frame_data_t final
+        {
+            // Allocated from the backend frame allocator when draws are
+            // prepared, instances are in order of update calls
+            vkrndr::linear_allocation_t instances;
+            vkrndr::linear_allocation_t render_nodes;
+
+            // Written by the draw commands pass, instances are grouped by
+            // primitive
+            vkrndr::buffer_t counters;
+            vkrndr::buffer_t indexed_commands;
+            vkrndr::buffer_t commands;
+            vkrndr::buffer_t sorted_instances;
 
             VkDescriptorSet descriptor_set{VK_NULL_HANDLE};
-
-            uint32_t current_draw{};
+            VkDescriptorSet draw_commands_descriptor_set{VK_NULL_HANDLE};
         };
 
+    private:
+        void cull();
+
+        void upload();
+
+        void reserve_draw_buffers(frame_data_t& data);
+
+        void destroy_draw_buffers(frame_data_t& data);
+
+        [[nodiscard]] float mesh_pixels_per_unit(render_mesh_t const& mesh,
+            glm::mat4 const& position) const;
+
     private:
         vkrndr::backend_t* backend_;
 
         VkDescriptorSetLayout descriptor_set_layout_{VK_NULL_HANDLE};
 
+        VkDescriptorSetLayout draw_commands_descriptor_set_layout_{
+            VK_NULL_HANDLE};
+        vkrndr::pipeline_layout_t draw_commands_pipeline_layout_;
+        vkrndr::pipeline_t draw_commands_pipeline_;
+
         vkrndr::buffer_t vertex_buffer_;
+        vkrndr::buffer_t color_buffer_;
         vkrndr::buffer_t index_buffer_;
+        // Static part of draw commands of each primitive
+        vkrndr::buffer_t primitive_buffer_;
 
-        std::vector<render_node_t> nodes_;
+        ngnast::transform_hierarchy_t hierarchy_;
+        // Mesh of each node in hierarchy order
+        std::vector<std::optional<size_t>> node_meshes_;
         std::vector<render_mesh_t> meshes_;
         std::vector<render_primitive_t> primitives_;
 
+        std::vector<draw_t> draws_;
+
+        ngngfx::frustum_t frustum_;
+        ngngfx::aabb_array_t draw_bounds_;
+        std::vector<uint8_t> visible_;
+
         cppext::cycled_buffer_t<frame_data_t> frame_data_;
+
+        glm::vec3 camera_position_{};
+        float projection_scale_{};
     };
 } // namespace galileo
 
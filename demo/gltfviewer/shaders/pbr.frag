@@ -17,7 +17,6 @@ layout(push_constant) uniform PushConsts
 {
     uint debug;
     float iblFactor;
-    uint modelIndex;
     uint materialIndex;
 } pc;
 
@@ -10,10 +10,11 @@ layout(push_constant) uniform PushConsts
 {
     uint debug;
     float iblFactor;
-    uint modelIndex;
     uint materialIndex;
     VertexBuffer vertices;
     TransformBuffer transforms;
+    ColorBuffer colors;
+    InstanceBuffer instances;
 } pc;
 
 #ifndef DEPTH_PASS
@@ -27,9 +28,12 @@ layout(location = 5) out vec4 outShadowPosition;
 
 void main()
 {
-    const Vertex vert = unpackVertex(pc.vertices.v[gl_VertexIndex]);
+    const Vertex vert = unpackVertex(pc.vertices.v[gl_VertexIndex],
+        pc.colors,
+        gl_VertexIndex);
 
-    const Transform transform = pc.transforms.v[pc.modelIndex];
+    const Transform transform =
+        pc.transforms.v[pc.instances.v[gl_InstanceIndex]];
 
     vec4 worldPosition = transform.model * vec4(vert.position, 1.0);
 
@@ -4,12 +4,15 @@
 #extension GL_EXT_scalar_block_layout : require
 #extension GL_EXT_buffer_reference : require
 
+#extension GL_EXT_buffer_reference_uvec2 : require
+
+// Layout of ngnast::gpu::packed_vertex_t
 struct PackedVertex
 {
-    vec4 position_uv_s;
-    vec4 normal_uv_t;
-    vec4 tangent;
-    vec4 color;
+    uvec2 position; // xyz unorm16 relative to mesh bounds, w tangent sign
+    uint normal; // octahedral snorm16
+    uint tangent; // octahedral snorm16
+    uint uv; // half precision
 };
 
 struct Vertex
@@ -21,18 +24,42 @@ struct Vertex
     vec2 uv;
 };
 
-layout(buffer_reference, buffer_reference_align = 64) readonly buffer VertexBuffer
+layout(scalar, buffer_reference, buffer_reference_align = 4) readonly buffer VertexBuffer
 {
     PackedVertex v[];
 };
 
-Vertex unpackVertex(PackedVertex vtx)
+layout(buffer_reference, buffer_reference_align = 4) readonly buffer ColorBuffer
+{
+    uint v[];
+};
+
+vec3 octDecode(vec2 e)
+{
+    vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0)
+    {
+        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(v);
+}
+
+// Position is returned in normalized mesh bounds, dequantization is part of
+// the model transform
+Vertex unpackVertex(PackedVertex vtx, ColorBuffer colors, uint index)
 {
-    return Vertex(vtx.position_uv_s.xyz,
-        vtx.normal_uv_t.xyz,
-        vtx.tangent,
-        vtx.color,
-        vec2(vtx.position_uv_s.w, vtx.normal_uv_t.w));
+    const vec2 xy = unpackUnorm2x16(vtx.position.x);
+    const vec2 zw = unpackUnorm2x16(vtx.position.y);
+
+    const vec4 color = uvec2(colors) != uvec2(0)
+        ? unpackUnorm4x8(colors.v[index])
+        : vec4(1.0);
+
+    return Vertex(vec3(xy, zw.x),
+        octDecode(unpackSnorm2x16(vtx.normal)),
+        vec4(octDecode(unpackSnorm2x16(vtx.tangent)), zw.y * 2.0 - 1.0),
+        color,
+        unpackHalf2x16(vtx.uv));
 }
 
 struct Transform
@@ -46,4 +73,11 @@ layout(buffer_reference, buffer_reference_align = 128) readonly buffer Transform
     Transform v[];
 };
 
+// Transform index of each instance, indexed by gl_InstanceIndex which
+// includes firstInstance of the draw
+layout(buffer_reference, buffer_reference_align = 4) readonly buffer InstanceBuffer
+{
+    uint v[];
+};
+
 #endif
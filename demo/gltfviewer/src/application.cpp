@@ -22,6 +22,7 @@
 #include <ngnast_scene_model.hpp> // IWYU pragma: keep
 
 #include <ngngfx_aircraft_camera.hpp>
+#include <ngngfx_frustum.hpp>
 #include <ngngfx_perspective_projection.hpp>
 
 #include <ngnwsi_application.hpp>
@@ -32,7 +33,6 @@
 
 #include <vkrndr_backend.hpp>
 #include <vkrndr_commands.hpp>
-#include <vkrndr_cpu_pacing.hpp>
 #include <vkrndr_debug_utils.hpp>
 #include <vkrndr_device.hpp>
 #include <vkrndr_error_code.hpp>
@@ -42,12 +42,16 @@
 #include <vkrndr_image.hpp>
 #include <vkrndr_instance.hpp>
 #include <vkrndr_library_handle.hpp>
+#include <vkrndr_pipeline_cache.hpp>
+#include <vkrndr_render_graph.hpp>
 #include <vkrndr_render_pass.hpp>
 #include <vkrndr_rendering_context.hpp>
 #include <vkrndr_swapchain.hpp>
 #include <vkrndr_synchronization.hpp>
 #include <vkrndr_utility.hpp>
 
+#include <BS_thread_pool.hpp>
+
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 DISABLE_WARNING_PUSH
@@ -55,6 +59,8 @@ DISABLE_WARNING_STRINGOP_OVERFLOW
 #include <fmt/std.h> // IWYU pragma: keep
 DISABLE_WARNING_POP
 
+#include <glm/trigonometric.hpp>
+
 #include <imgui.h>
 
 #include <SDL3/SDL_events.h>
@@ -69,6 +75,8 @@ DISABLE_WARNING_POP
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <expected>
@@ -76,6 +84,7 @@ DISABLE_WARNING_POP
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <system_error>
@@ -88,12 +97,14 @@ DISABLE_WARNING_POP
 // IWYU pragma: no_include <boost/smart_ptr/intrusive_ref_counter.hpp>
 // IWYU pragma: no_include <fmt/base.h>
 // IWYU pragma: no_include <map>
-// IWYU pragma: no_include <optional>
 // IWYU pragma: no_include <set>
 // IWYU pragma: no_include <string_view>
 
 namespace
 {
+    constexpr char const* pipeline_cache_file{"pipeline_cache.bin"};
+    constexpr char const* shader_cache_directory{"shader_cache"};
+
     struct [[nodiscard]] push_constants_t final
     {
         // cppcheck-suppress unusedStructMember
@@ -209,6 +220,7 @@ gltfviewer::application_t::application_t(int const argc,
                                                          {
                                                              .video = true,
                                                          }}}
+    , glsl_guard_{shader_cache_directory}
     , render_window_{std::make_unique<ngnwsi::render_window_t>("gltfviewer",
           SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY,
           512,
@@ -323,11 +335,22 @@ gltfviewer::application_t::application_t(int const argc,
                             VK_ERROR_INITIALIZATION_FAILED)};
                     }
 
+                    // Uploads are submitted to a dedicated transfer queue
+                    // when the device has one
+                    std::vector<vkrndr::queue_family_t> queue_families{
+                        *queue_with_present};
+                    if (std::optional<vkrndr::queue_family_t> const transfer{
+                            vkrndr::find_dedicated_transfer_family(
+                                *physical_device)})
+                    {
+                        queue_families.push_back(*transfer);
+                    }
+
                     return create_device(*rendering_context_.instance,
                         device_extensions,
                         *physical_device,
                         effective_features,
-                        cppext::as_span(*queue_with_present));
+                        queue_families);
                 })
             .transform(
                 [this](vkrndr::device_ptr_t&& device)
@@ -337,6 +360,20 @@ gltfviewer::application_t::application_t(int const argc,
                         vkrndr::handle_cast(device->logical_device),
                         fmt::join(device->extensions, ", "));
 
+                    // Pipelines are compiled by the driver on a cold cache
+                    if (std::expected<bool, std::error_code> const loaded{
+                            vkrndr::load_pipeline_cache(*device,
+                                pipeline_cache_file)};
+                        !loaded)
+                    {
+                        spdlog::warn("Pipeline cache not loaded: {}",
+                            loaded.error().message());
+                    }
+                    else if (!*loaded)
+                    {
+                        spdlog::info("Pipeline cache missing or outdated");
+                    }
+
                     rendering_context_.device = std::move(device);
                 })
             .transform_error(
@@ -405,7 +442,10 @@ gltfviewer::application_t::application_t(int const argc,
     std::vector<VkFormat> const formats{
         vkrndr::find_supported_texture_compression_formats(
             rendering_context_.device->physical_device)};
-    gltf_loader_ = std::make_unique<ngnast::gltf::loader_t>(std::span{formats});
+    constexpr bool use_cooked_cache{true};
+    gltf_loader_ = std::make_unique<ngnast::gltf::loader_t>(std::span{formats},
+        &thread_pool_,
+        use_cooked_cache);
 }
 
 gltfviewer::application_t::~application_t() = default;
@@ -462,7 +502,10 @@ void gltfviewer::application_t::update(float delta_time)
         std::filesystem::path const model_path{selector_.selected_model()};
         spdlog::info("Start loading: {}", model_path);
 
-        auto model{gltf_loader_->load(model_path)};
+        // Stop decoding images of the previous model
+        image_stream_.reset();
+
+        auto model{gltf_loader_->load_streaming(model_path)};
         if (!model.has_value())
         {
             spdlog::error("Failed to load model: {}. Reason: {}",
@@ -473,8 +516,10 @@ void gltfviewer::application_t::update(float delta_time)
 
         vkDeviceWaitIdle(backend_->device());
 
-        materials_->load(*model);
-        scene_graph_->load(std::move(model).value());
+        materials_->load(model->model);
+        scene_graph_->load(std::move(model->model));
+        image_stream_ = std::make_unique<ngnast::gltf::image_stream_t>(
+            std::move(model->images));
         depth_pass_shader_->load(environment_->descriptor_layout(),
             materials_->descriptor_layout(),
             depth_buffer_.format);
@@ -495,6 +540,8 @@ void gltfviewer::application_t::update(float delta_time)
         spdlog::info("End loading: {}", model_path);
     }
 
+    stream_images();
+
     camera_controller_.update(delta_time);
     projection_.update(camera_.view_matrix());
 }
@@ -535,13 +582,27 @@ void gltfviewer::application_t::draw()
         .height = cppext::as_fp(target_image->extent.height),
         .minDepth = 0.0f,
         .maxDepth = 1.0f};
-    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
-
     VkRect2D const scissor{{0, 0}, vkrndr::to_2d_extent(target_image->extent)};
-    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+    // Dynamic state isn't inherited between command buffers
+    auto const set_viewport{[&viewport, &scissor](VkCommandBuffer cb)
+        {
+            vkCmdSetViewport(cb, 0, 1, &viewport);
+            vkCmdSetScissor(cb, 0, 1, &scissor);
+        }};
+    set_viewport(command_buffer);
 
     environment_->draw(camera_, projection_);
 
+    materials_->begin_frame();
+    scene_graph_->begin_frame();
+    scene_graph_->update_lod(camera_.position(),
+        viewport.height /
+            (2.0f * std::tan(glm::radians(projection_.fov()) * 0.5f)));
+    scene_graph_->update_visibility(
+        ngngfx::extract_frustum(projection_.view_projection_matrix()));
+    scene_graph_->build_render_list();
+
     push_constants_t const pc{.debug = debug_, .ibl_factor = ibl_factor_};
 
     {
@@ -558,77 +619,96 @@ void gltfviewer::application_t::draw()
 
     if (!scene_graph_->empty())
     {
-        {
-            vkrndr::render_pass_t depth_render_pass;
-            depth_render_pass.with_depth_attachment(VK_ATTACHMENT_LOAD_OP_CLEAR,
-                VK_ATTACHMENT_STORE_OP_STORE,
-                depth_buffer_.view,
-                VkClearValue{.depthStencil = {1.0f, 0}});
+        // Passes are recorded concurrently and submitted in order
+        std::span<VkCommandBuffer const> const pass_buffers{
+            backend_->request_parallel_command_buffers(3)};
 
-            VkPipelineLayout const layout{
-                depth_pass_shader_->pipeline_layout()};
-            environment_->bind_on(command_buffer,
-                layout,
-                VK_PIPELINE_BIND_POINT_GRAPHICS);
+        auto const record_depth_pass{[&, cb = pass_buffers[0]]()
+            {
+                set_viewport(cb);
+
+                vkrndr::render_pass_t depth_render_pass;
+                depth_render_pass.with_depth_attachment(
+                    VK_ATTACHMENT_LOAD_OP_CLEAR,
+                    VK_ATTACHMENT_STORE_OP_STORE,
+                    depth_buffer_.view,
+                    VkClearValue{.depthStencil = {1.0f, 0}});
+
+                VkPipelineLayout const layout{
+                    depth_pass_shader_->pipeline_layout()};
+                environment_->bind_on(cb,
+                    layout,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+                materials_->bind_on(cb,
+                    layout,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS);
+
+                scene_graph_->bind_on(cb);
+
+                vkCmdPushConstants(cb,
+                    layout,
+                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                    0,
+                    8,
+                    &pc);
 
-            materials_->bind_on(command_buffer,
-                layout,
-                VK_PIPELINE_BIND_POINT_GRAPHICS);
+                {
+                    [[maybe_unused]] auto guard{depth_render_pass.begin(cb,
+                        {{0, 0}, vkrndr::to_2d_extent(depth_buffer_.extent)})};
 
-            scene_graph_->bind_on(command_buffer);
+                    depth_pass_shader_->draw(*scene_graph_, cb);
+                }
 
-            vkCmdPushConstants(command_buffer,
-                layout,
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                0,
-                8,
-                &pc);
+                auto const barrier{vkrndr::with_access(
+                    vkrndr::on_stage(vkrndr::image_barrier(depth_buffer_,
+                                         VK_IMAGE_ASPECT_DEPTH_BIT),
+                        VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+                        VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT),
+                    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                    VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT)};
 
-            {
-                [[maybe_unused]] auto guard{
-                    depth_render_pass.begin(command_buffer,
-                        {{0, 0}, vkrndr::to_2d_extent(depth_buffer_.extent)})};
+                vkrndr::wait_for(cb, {}, {}, cppext::as_span(barrier));
+            }};
 
-                depth_pass_shader_->draw(*scene_graph_, command_buffer);
-            }
-        }
+        auto const record_shadow_pass{[&, cb = pass_buffers[1]]()
+            {
+                if (!environment_->has_directional_lights())
+                {
+                    return;
+                }
 
-        {
-            auto const barrier{vkrndr::with_access(
-                vkrndr::on_stage(vkrndr::image_barrier(depth_buffer_,
-                                     VK_IMAGE_ASPECT_DEPTH_BIT),
-                    VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
-                    VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT),
-                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT)};
+                set_viewport(cb);
 
-            vkrndr::wait_for(command_buffer, {}, {}, cppext::as_span(barrier));
-        }
+                VkPipelineLayout const layout{shadow_map_->pipeline_layout()};
+                environment_->bind_on(cb,
+                    layout,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS);
 
-        if (environment_->has_directional_lights())
-        {
-            VkPipelineLayout const layout{shadow_map_->pipeline_layout()};
-            environment_->bind_on(command_buffer,
-                layout,
-                VK_PIPELINE_BIND_POINT_GRAPHICS);
+                materials_->bind_on(cb,
+                    layout,
+                    VK_PIPELINE_BIND_POINT_GRAPHICS);
 
-            materials_->bind_on(command_buffer,
-                layout,
-                VK_PIPELINE_BIND_POINT_GRAPHICS);
+                scene_graph_->bind_on(cb);
 
-            scene_graph_->bind_on(command_buffer);
+                vkCmdPushConstants(cb,
+                    layout,
+                    VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                    0,
+                    8,
+                    &pc);
 
-            vkCmdPushConstants(command_buffer,
-                layout,
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                0,
-                8,
-                &pc);
+                shadow_map_->draw(*scene_graph_, cb);
+            }};
 
-            shadow_map_->draw(*scene_graph_, command_buffer);
-        }
+        BS::multi_future<void> recordings;
+        recordings.push_back(recording_pool_.submit_task(record_depth_pass));
+        recordings.push_back(recording_pool_.submit_task(record_shadow_pass));
 
         {
+            VkCommandBuffer const cb{pass_buffers[2]};
+            set_viewport(cb);
+
             vkrndr::render_pass_t color_render_pass;
             color_render_pass.with_color_attachment(VK_ATTACHMENT_LOAD_OP_CLEAR,
                 VK_ATTACHMENT_STORE_OP_STORE,
@@ -639,21 +719,15 @@ void gltfviewer::application_t::draw()
                 depth_buffer_.view);
 
             VkPipelineLayout const layout{pbr_shader_->pipeline_layout()};
-            environment_->bind_on(command_buffer,
-                layout,
-                VK_PIPELINE_BIND_POINT_GRAPHICS);
+            environment_->bind_on(cb, layout, VK_PIPELINE_BIND_POINT_GRAPHICS);
 
-            materials_->bind_on(command_buffer,
-                layout,
-                VK_PIPELINE_BIND_POINT_GRAPHICS);
+            materials_->bind_on(cb, layout, VK_PIPELINE_BIND_POINT_GRAPHICS);
 
-            scene_graph_->bind_on(command_buffer);
+            scene_graph_->bind_on(cb);
 
-            shadow_map_->bind_on(command_buffer,
-                layout,
-                VK_PIPELINE_BIND_POINT_GRAPHICS);
+            shadow_map_->bind_on(cb, layout, VK_PIPELINE_BIND_POINT_GRAPHICS);
 
-            vkCmdPushConstants(command_buffer,
+            vkCmdPushConstants(cb,
                 layout,
                 VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
                 0,
@@ -661,15 +735,22 @@ void gltfviewer::application_t::draw()
                 &pc);
 
             {
-                [[maybe_unused]] auto guard{
-                    color_render_pass.begin(command_buffer,
-                        {{0, 0}, vkrndr::to_2d_extent(color_image_.extent)})};
+                [[maybe_unused]] auto guard{color_render_pass.begin(cb,
+                    {{0, 0}, vkrndr::to_2d_extent(color_image_.extent)})};
 
-                pbr_shader_->draw(*scene_graph_, command_buffer);
+                pbr_shader_->draw(*scene_graph_, cb);
 
-                environment_->draw_skybox(command_buffer);
+                environment_->draw_skybox(cb);
             }
         }
+
+        // Tasks reference local state, all of them have to be finished
+        // before errors are rethrown
+        recordings.wait();
+        recordings.get();
+
+        command_buffer = backend_->request_command_buffer();
+        set_viewport(command_buffer);
     }
     else
     {
@@ -747,111 +828,112 @@ void gltfviewer::application_t::draw()
                 postprocess_cb_scope{command_buffer, "Postprocess"});
 
         auto const& blur_image{pyramid_blur_->source_image()};
-        {
-            std::array const barriers{
-                vkrndr::with_layout(
-                    vkrndr::with_access(
-                        vkrndr::on_stage(vkrndr::image_barrier(color_image_),
-                            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-                        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
-                        VK_ACCESS_2_SHADER_SAMPLED_READ_BIT),
-                    VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL),
-                vkrndr::to_layout(
-                    vkrndr::with_access(
-                        vkrndr::on_stage(vkrndr::image_barrier(resolve_image_),
-                            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-                        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT),
-                    VK_IMAGE_LAYOUT_GENERAL),
-                vkrndr::to_layout(
-                    vkrndr::with_access(
-                        vkrndr::on_stage(vkrndr::image_barrier(blur_image),
-                            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-                        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT),
-                    VK_IMAGE_LAYOUT_GENERAL)};
-
-            vkrndr::wait_for(command_buffer, {}, {}, barriers);
-        }
 
-        resolve_shader_->draw(command_buffer,
+        constexpr VkPipelineStageFlags2 compute{
+            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT};
+
+        vkrndr::render_graph_t graph{backend_->device()};
+        vkrndr::render_graph_image_t const color{graph.import_image(
             color_image_,
-            resolve_image_,
-            blur_image);
+            {.stage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+                .access = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+                .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL})};
+        vkrndr::render_graph_image_t const resolve{
+            graph.import_image(resolve_image_, {.stage = compute})};
+        vkrndr::render_graph_image_t const blur{
+            graph.import_image(blur_image, {.stage = compute})};
+        vkrndr::render_graph_image_t const target{graph.import_image(
+            *target_image,
+            {.stage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT},
+            vkrndr::color_attachment_usage())};
+
+        graph.add_pass("Resolve")
+            .read(color, vkrndr::sampled_usage(compute))
+            .write(resolve,
+                vkrndr::storage_usage(compute,
+                    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT))
+            .write(blur,
+                vkrndr::storage_usage(compute,
+                    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT))
+            .execute(
+                [this, &blur_image](VkCommandBuffer cb)
+                {
+                    resolve_shader_->draw(cb,
+                        color_image_,
+                        resolve_image_,
+                        blur_image);
+                });
+
+        graph.add_pass("Blur")
+            .write(blur, vkrndr::storage_usage(compute))
+            .execute([this](VkCommandBuffer cb)
+                { pyramid_blur_->draw(blur_levels_, cb); });
+
+        graph.add_pass("Blend")
+            .write(resolve, vkrndr::storage_usage(compute))
+            .read(blur, vkrndr::sampled_usage(compute, VK_IMAGE_LAYOUT_GENERAL))
+            .execute(
+                [this, &blur_image](VkCommandBuffer cb)
+                {
+                    weighted_blend_shader_->draw(bloom_strength_,
+                        cb,
+                        resolve_image_,
+                        blur_image);
+                });
+
+        graph.add_pass("Tone mapping")
+            .read(resolve,
+                vkrndr::storage_usage(compute,
+                    VK_ACCESS_2_SHADER_STORAGE_READ_BIT))
+            .write(target,
+                vkrndr::storage_usage(compute,
+                    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT))
+            .execute(
+                [this, &target_image](VkCommandBuffer cb)
+                {
+                    postprocess_shader_->draw(color_conversion_,
+                        tone_mapping_,
+                        cb,
+                        resolve_image_,
+                        *target_image);
+                });
+
+        graph.compile();
+        graph.execute(command_buffer);
+    }
 
-        pyramid_blur_->draw(blur_levels_, command_buffer);
+    imgui_->render(command_buffer, *target_image);
 
-        {
-            std::array const barriers{
-                vkrndr::with_access(
-                    vkrndr::on_stage(vkrndr::image_barrier(resolve_image_),
-                        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-                    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                    VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
-                        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT),
-
-                vkrndr::with_access(
-                    vkrndr::on_stage(vkrndr::image_barrier(blur_image),
-                        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-                    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                    VK_ACCESS_2_SHADER_SAMPLED_READ_BIT)};
-
-            vkrndr::wait_for(command_buffer, {}, {}, barriers);
-        }
+    vkrndr::transition_to_present_layout(*target_image, command_buffer);
 
-        weighted_blend_shader_->draw(bloom_strength_,
-            command_buffer,
-            resolve_image_,
-            blur_image);
+    render_window_->present(backend_->present_buffers());
 
-        {
-            std::array const barriers{
-                vkrndr::with_access(
-                    vkrndr::on_stage(vkrndr::image_barrier(resolve_image_),
-                        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-                    VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
-                        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                    VK_ACCESS_2_SHADER_STORAGE_READ_BIT),
-
-                vkrndr::to_layout(
-                    vkrndr::with_access(
-                        vkrndr::on_stage(vkrndr::image_barrier(*target_image),
-                            VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-                            VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT),
-                        VK_ACCESS_2_NONE,
-                        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT),
-                    VK_IMAGE_LAYOUT_GENERAL)};
-
-            vkrndr::wait_for(command_buffer, {}, {}, barriers);
-        }
+    backend_->end_frame();
+}
 
-        postprocess_shader_->draw(color_conversion_,
-            tone_mapping_,
-            command_buffer,
-            resolve_image_,
-            *target_image);
+void gltfviewer::application_t::stream_images()
+{
+    if (image_stream_ && !image_stream_->done())
+    {
+        // Uploads are submitted at the beginning of the next frame
+        image_stream_->poll([this](size_t const index,
+                                ngnast::image_t&& image)
+            { materials_->update_image(index, image); });
 
+        if (image_stream_->done())
         {
-            auto const barrier{vkrndr::with_layout(
-                vkrndr::with_access(
-                    vkrndr::on_stage(vkrndr::image_barrier(*target_image),
-                        VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-                        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT),
-                    VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
-                    VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT),
-                VK_IMAGE_LAYOUT_GENERAL,
-                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL)};
-            vkrndr::wait_for(command_buffer, {}, {}, cppext::as_span(barrier));
+            spdlog::info("Streamed {} images", image_stream_->total());
         }
     }
 
-    imgui_->render(command_buffer, *target_image);
-
-    vkrndr::transition_to_present_layout(*target_image, command_buffer);
-
-    render_window_->present(backend_->present_buffers());
+    if (!materials_->has_ready_images())
+    {
+        return;
+    }
 
-    backend_->end_frame();
+    // Replaced images may still be used by frames in flight
+    materials_->commit_ready_images([this](std::function<void()> cb)
+        { render_window_->defer(std::move(cb)); });
 }
 
 void gltfviewer::application_t::debug_draw()
@@ -964,6 +1046,14 @@ void gltfviewer::application_t::on_shutdown()
 {
     vkDeviceWaitIdle(backend_->device());
 
+    if (std::expected<void, std::error_code> const result{
+            vkrndr::save_pipeline_cache(backend_->device(),
+                pipeline_cache_file)};
+        !result)
+    {
+        spdlog::warn("Pipeline cache not saved: {}", result.error().message());
+    }
+
     postprocess_shader_.reset();
 
     weighted_blend_shader_.reset();
@@ -1014,10 +1104,9 @@ void gltfviewer::application_t::on_resize(uint32_t const width,
         return;
     }
 
-    vkrndr::frame_in_flight_t& in_flight{render_window_->frame_in_flight()};
     std::function<void(std::function<void()>)> deletion_queue_insert{
-        [&in_flight](std::function<void()> cb)
-        { in_flight.cleanup.push_back(std::move(cb)); }};
+        [this](std::function<void()> cb)
+        { render_window_->defer(std::move(cb)); }};
 
     deletion_queue_insert([&device = backend_->device(), image = color_image_]()
         { destroy(device, image); });
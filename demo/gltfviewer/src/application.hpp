@@ -15,6 +15,8 @@
 #include <vkrndr_image.hpp>
 #include <vkrndr_rendering_context.hpp>
 
+#include <BS_thread_pool.hpp>
+
 #include <SDL3/SDL_events.h>
 
 #include <cstdint>
@@ -22,6 +24,7 @@
 
 namespace ngnast::gltf
 {
+    class image_stream_t;
     class loader_t;
 } // namespace ngnast::gltf
 
@@ -92,9 +95,16 @@ namespace gltfviewer
 
         void debug_draw();
 
+        void stream_images();
+
     private:
         vkglsl::guard_t glsl_guard_;
 
+        BS::thread_pool<> thread_pool_;
+        // Separate from the loader pool, frames don't wait behind queued
+        // image decodes
+        BS::thread_pool<> recording_pool_{2};
+
         ngnwsi::mouse_t mouse_;
         ngngfx::aircraft_camera_t camera_;
         ngngfx::perspective_projection_t projection_;
@@ -125,6 +135,7 @@ namespace gltfviewer
         model_selector_t selector_;
         bool change_model_{false};
         std::unique_ptr<ngnast::gltf::loader_t> gltf_loader_;
+        std::unique_ptr<ngnast::gltf::image_stream_t> image_stream_;
 
         uint32_t debug_{0};
         float ibl_factor_{0.5f};
@@ -59,7 +59,7 @@ void gltfviewer::depth_pass_shader_t::draw(scene_graph_t const& graph,
 
     vkrndr::bind_pipeline(command_buffer, depth_pipeline_);
 
-    graph.traverse(ngnast::alpha_mode_t::opaque,
+    graph.draw(graph.draw_packets(ngnast::alpha_mode_t::opaque),
         command_buffer,
         depth_pipeline_.layout,
         []([[maybe_unused]] ngnast::alpha_mode_t const mode,
@@ -108,7 +108,7 @@ void gltfviewer::depth_pass_shader_t::load(
                                .stageFlags = VK_SHADER_STAGE_VERTEX_BIT |
                                    VK_SHADER_STAGE_FRAGMENT_BIT,
                                .offset = 0,
-                               .size = 32})
+                               .size = 48})
                            .build();
 
     depth_pipeline_ =
@@ -1,6 +1,7 @@
 #include <materials.hpp>
 
 #include <cppext_container.hpp>
+#include <cppext_cycled_buffer.hpp>
 #include <cppext_numeric.hpp>
 
 #include <ngnast_gpu_transfer.hpp>
@@ -14,6 +15,7 @@
 #include <vkrndr_image.hpp>
 #include <vkrndr_memory.hpp>
 #include <vkrndr_sampler.hpp>
+#include <vkrndr_upload_queue.hpp>
 #include <vkrndr_utility.hpp>
 
 #include <glm/vec3.hpp>
@@ -30,16 +32,19 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <map>
 #include <span>
+#include <system_error>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 // IWYU pragma: no_include <fmt/base.h>
 // IWYU pragma: no_include <fmt/format.h>
-// IWYU pragma: no_include <expected>
 // IWYU pragma: no_include <memory>
 // IWYU pragma: no_include <optional>
 // IWYU pragma: no_include <string_view>
@@ -166,6 +171,86 @@ namespace
         return rv;
     }
 
+    struct [[nodiscard]] image_mips_t final
+    {
+        uint32_t count{};
+        std::vector<vkrndr::image_mip_level_t> predefined;
+    };
+
+    [[nodiscard]] image_mips_t image_mips(vkrndr::backend_t const& backend,
+        ngnast::image_t const& image)
+    {
+        auto const& base_mip{image.mip_levels.front()};
+
+        image_mips_t rv{.count = vkrndr::max_mip_levels(base_mip.extent.width,
+            base_mip.extent.height)};
+
+        auto properties{vku::InitStruct<VkFormatProperties2>()};
+        vkGetPhysicalDeviceFormatProperties2(backend.device(),
+            image.format,
+            &properties);
+        if (!vkrndr::supports_flags(
+                properties.formatProperties.linearTilingFeatures,
+                VK_FORMAT_FEATURE_2_BLIT_DST_BIT))
+        {
+            spdlog::warn(
+                "Mipmap generation disabled for image in source format {}",
+                string_VkFormat(image.format));
+
+            rv.count = cppext::narrow<uint32_t>(image.mip_levels.size());
+
+            rv.predefined.reserve(rv.count);
+            std::ranges::transform(image.mip_levels,
+                std::back_inserter(rv.predefined),
+                ngnast::gpu::to_vulkan);
+        }
+
+        return rv;
+    }
+
+    [[nodiscard]] vkrndr::image_t transfer_image(vkrndr::backend_t& backend,
+        ngnast::image_t const& image)
+    {
+        image_mips_t mips{image_mips(backend, image)};
+
+        return backend.transfer_image(
+            std::span{image.data.get(), image.data_size},
+            image.mip_levels.front().extent,
+            image.format,
+            mips.count,
+            mips.predefined);
+    }
+
+    [[nodiscard]] std::pair<vkrndr::image_t, vkrndr::upload_ticket_t>
+    upload_image(vkrndr::backend_t& backend, ngnast::image_t const& image)
+    {
+        image_mips_t const mips{image_mips(backend, image)};
+
+        vkrndr::image_t rv{create_image_and_view(backend.device(),
+            vkrndr::image_2d_create_info_t{.format = image.format,
+                .extent = image.mip_levels.front().extent,
+                .mip_levels = mips.count,
+                .tiling = VK_IMAGE_TILING_OPTIMAL,
+                .usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                    VK_IMAGE_USAGE_SAMPLED_BIT,
+                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT},
+            VK_IMAGE_ASPECT_COLOR_BIT)};
+
+        std::expected<vkrndr::upload_ticket_t, std::error_code> const ticket{
+            backend.upload_queue().upload(
+                std::span{image.data.get(), image.data_size},
+                rv,
+                mips.predefined)};
+        if (!ticket)
+        {
+            destroy(backend.device(), rv);
+            throw std::system_error{ticket.error()};
+        }
+
+        return {rv, *ticket};
+    }
+
     [[nodiscard]] vkrndr::buffer_t create_material_uniform(
         vkrndr::backend_t& backend,
         std::span<ngnast::material_t const> const& materials)
@@ -265,6 +350,7 @@ namespace
 
 gltfviewer::materials_t::materials_t(vkrndr::backend_t& backend)
     : backend_{&backend}
+    , frame_data_{backend_->frames_in_flight(), backend_->frames_in_flight()}
 {
     create_dummy_material();
 }
@@ -308,6 +394,95 @@ void gltfviewer::materials_t::load(ngnast::scene_model_t& model)
     model.samplers.clear();
 }
 
+void gltfviewer::materials_t::update_image(size_t const index,
+    ngnast::image_t const& image)
+{
+    if (index >= images_.size())
+    {
+        return;
+    }
+
+    auto [uploaded, ticket]{upload_image(*backend_, image)};
+    pending_images_.push_back(
+        {.index = index, .image = uploaded, .ticket = ticket});
+}
+
+bool gltfviewer::materials_t::has_ready_images() const
+{
+    return std::ranges::any_of(pending_images_,
+        [this](pending_image_t const& pending)
+        { return backend_->upload_queue().ready(pending.ticket); });
+}
+
+void gltfviewer::materials_t::commit_ready_images(
+    std::function<void(std::function<void()>)> const& deletion_queue_insert)
+{
+    auto const [first, last]{std::ranges::stable_partition(pending_images_,
+        [this](pending_image_t const& pending)
+        { return !backend_->upload_queue().ready(pending.ticket); })};
+    if (first == last)
+    {
+        return;
+    }
+
+    for (pending_image_t const& pending : std::ranges::subrange(first, last))
+    {
+        deletion_queue_insert(
+            [&device = backend_->device(), image = images_[pending.index]]()
+            { destroy(device, image); });
+        images_[pending.index] = pending.image;
+
+        for (frame_data_t& frame : cppext::as_span(frame_data_))
+        {
+            frame.stale_images.push_back(pending.index);
+        }
+    }
+
+    pending_images_.erase(first, last);
+}
+
+void gltfviewer::materials_t::begin_frame()
+{
+    frame_data_.cycle();
+
+    std::vector<size_t>& stale_images{frame_data_->stale_images};
+    if (stale_images.empty())
+    {
+        return;
+    }
+
+    // Previous submission of this frame is complete, its descriptor set can
+    // be updated
+    std::vector<VkDescriptorImageInfo> image_descriptors;
+    image_descriptors.reserve(stale_images.size());
+    for (size_t const index : stale_images)
+    {
+        image_descriptors.push_back(
+            vkrndr::sampled_image_descriptor(images_[index]));
+    }
+
+    std::vector<VkWriteDescriptorSet> writes;
+    writes.reserve(image_descriptors.size());
+    for (size_t i{}; i != image_descriptors.size(); ++i)
+    {
+        writes.push_back({.sType = vku::GetSType<VkWriteDescriptorSet>(),
+            .dstSet = frame_data_->descriptor_set,
+            .dstBinding = 0,
+            .dstArrayElement = cppext::narrow<uint32_t>(stale_images[i]),
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            .pImageInfo = &image_descriptors[i]});
+    }
+
+    vkUpdateDescriptorSets(backend_->device(),
+        vkrndr::count_cast(writes),
+        writes.data(),
+        0,
+        nullptr);
+
+    stale_images.clear();
+}
+
 void gltfviewer::materials_t::bind_on(VkCommandBuffer command_buffer,
     VkPipelineLayout const layout,
     VkPipelineBindPoint const bind_point)
@@ -317,7 +492,8 @@ void gltfviewer::materials_t::bind_on(VkCommandBuffer command_buffer,
         layout,
         1,
         1,
-        has_materials_ ? &descriptor_set_ : &dummy_descriptor_set_,
+        has_materials_ ? &frame_data_->descriptor_set
+                       : &dummy_descriptor_set_,
         0,
         nullptr);
 }
@@ -373,41 +549,7 @@ void gltfviewer::materials_t::transfer_textures(
         images_.reserve(model.images.size());
         for (ngnast::image_t const& image : model.images)
         {
-            auto const& base_mip{image.mip_levels.front()};
-
-            uint32_t effective_mips_for_image{
-                vkrndr::max_mip_levels(base_mip.extent.width,
-                    base_mip.extent.height)};
-
-            std::vector<vkrndr::image_mip_level_t> predefined_mips;
-
-            auto properties{vku::InitStruct<VkFormatProperties2>()};
-            vkGetPhysicalDeviceFormatProperties2(backend_->device(),
-                image.format,
-                &properties);
-            if (!vkrndr::supports_flags(
-                    properties.formatProperties.linearTilingFeatures,
-                    VK_FORMAT_FEATURE_2_BLIT_DST_BIT))
-            {
-                spdlog::warn(
-                    "Mipmap generation disabled for image in source format {}",
-                    string_VkFormat(image.format));
-
-                effective_mips_for_image =
-                    cppext::narrow<uint32_t>(image.mip_levels.size());
-
-                predefined_mips.reserve(effective_mips_for_image);
-                std::ranges::transform(image.mip_levels,
-                    std::back_inserter(predefined_mips),
-                    ngnast::gpu::to_vulkan);
-            }
-
-            images_.push_back(backend_->transfer_image(
-                std::span{image.data.get(), image.data_size},
-                base_mip.extent,
-                image.format,
-                effective_mips_for_image,
-                predefined_mips));
+            images_.push_back(transfer_image(*backend_, image));
 
             image_descriptors.push_back(
                 sampled_image_descriptor(images_.back()));
@@ -433,20 +575,39 @@ void gltfviewer::materials_t::transfer_textures(
         image_descriptors.size(),
         sampler_descriptors.size());
 
-    vkrndr::check_result(allocate_descriptor_sets(backend_->device(),
-        backend_->descriptor_pool(),
-        cppext::as_span(descriptor_layout_),
-        cppext::as_span(descriptor_set_)));
-
-    update_descriptor_set(backend_->device(),
-        descriptor_set_,
-        image_descriptors,
-        sampler_descriptors,
-        vkrndr::buffer_descriptor(uniform_));
+    for (frame_data_t& frame : cppext::as_span(frame_data_))
+    {
+        vkrndr::check_result(allocate_descriptor_sets(backend_->device(),
+            backend_->descriptor_pool(),
+            cppext::as_span(descriptor_layout_),
+            cppext::as_span(frame.descriptor_set)));
+
+        update_descriptor_set(backend_->device(),
+            frame.descriptor_set,
+            image_descriptors,
+            sampler_descriptors,
+            vkrndr::buffer_descriptor(uniform_));
+    }
 }
 
 void gltfviewer::materials_t::clear()
 {
+    if (!pending_images_.empty())
+    {
+        if (std::expected<void, std::error_code> const result{
+                backend_->upload_queue().wait(pending_images_.back().ticket)};
+            !result)
+        {
+            throw std::system_error{result.error()};
+        }
+
+        for (pending_image_t const& pending : pending_images_)
+        {
+            destroy(backend_->device(), pending.image);
+        }
+        pending_images_.clear();
+    }
+
     destroy(backend_->device(), uniform_);
     uniform_ = {};
 
@@ -462,12 +623,16 @@ void gltfviewer::materials_t::clear()
     }
     images_.clear();
 
-    if (descriptor_set_ != VK_NULL_HANDLE)
+    for (frame_data_t& frame : cppext::as_span(frame_data_))
     {
-        free_descriptor_sets(backend_->device(),
-            backend_->descriptor_pool(),
-            cppext::as_span(descriptor_set_));
-        descriptor_set_ = VK_NULL_HANDLE;
+        if (frame.descriptor_set != VK_NULL_HANDLE)
+        {
+            free_descriptor_sets(backend_->device(),
+                backend_->descriptor_pool(),
+                cppext::as_span(frame.descriptor_set));
+            frame.descriptor_set = VK_NULL_HANDLE;
+        }
+        frame.stale_images.clear();
     }
 
     vkDestroyDescriptorSetLayout(backend_->device(),
@@ -1,15 +1,21 @@
 #ifndef GLTFVIEWER_MATERIALS_INCLUDED
 #define GLTFVIEWER_MATERIALS_INCLUDED
 
+#include <cppext_cycled_buffer.hpp>
+
 #include <vkrndr_buffer.hpp>
 #include <vkrndr_image.hpp>
+#include <vkrndr_upload_queue.hpp>
 
 #include <volk.h>
 
+#include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace ngnast
 {
+    struct image_t;
     struct scene_model_t;
 } // namespace ngnast
 
@@ -37,6 +43,22 @@ namespace gltfviewer
 
         void load(ngnast::scene_model_t& model);
 
+        // Starts the upload of a replacement for an image of the loaded
+        // model, the image is replaced once the upload is ready
+        void update_image(size_t index, ngnast::image_t const& image);
+
+        [[nodiscard]] bool has_ready_images() const;
+
+        // Replaces images with ready uploads. Replaced images are destroyed
+        // through the deletion queue, descriptor sets of frames in flight
+        // are updated when their frame begins again.
+        void commit_ready_images(
+            std::function<void(std::function<void()>)> const&
+                deletion_queue_insert);
+
+        // Has to be called after the backend begins the frame
+        void begin_frame();
+
         void bind_on(VkCommandBuffer command_buffer,
             VkPipelineLayout layout,
             VkPipelineBindPoint bind_point);
@@ -46,6 +68,23 @@ namespace gltfviewer
 
         materials_t& operator=(materials_t&&) noexcept = delete;
 
+    private:
+        struct [[nodiscard]] pending_image_t final
+        {
+            size_t index{};
+            vkrndr::image_t image;
+            vkrndr::upload_ticket_t ticket;
+        };
+
+        struct [[nodiscard]] frame_data_t final
+        {
+            VkDescriptorSet descriptor_set{VK_NULL_HANDLE};
+
+            // Indices of images committed after the descriptor set was
+            // last updated
+            std::vector<size_t> stale_images;
+        };
+
     private:
         void create_dummy_material();
 
@@ -67,10 +106,11 @@ namespace gltfviewer
 
         // Actual model data
         VkDescriptorSetLayout descriptor_layout_{VK_NULL_HANDLE};
-        VkDescriptorSet descriptor_set_{VK_NULL_HANDLE};
+        cppext::cycled_buffer_t<frame_data_t> frame_data_;
         vkrndr::buffer_t uniform_;
         std::vector<VkSampler> samplers_;
         std::vector<vkrndr::image_t> images_;
+        std::vector<pending_image_t> pending_images_;
     };
 } // namespace gltfviewer
 
@@ -12,6 +12,7 @@
 #include <vkrndr_device.hpp>
 #include <vkrndr_graphics_pipeline_builder.hpp>
 #include <vkrndr_pipeline.hpp>
+#include <vkrndr_pipeline_compiler.hpp>
 #include <vkrndr_pipeline_layout_builder.hpp>
 #include <vkrndr_shader_module.hpp>
 
@@ -20,7 +21,7 @@
 #include <cassert>
 #include <filesystem>
 #include <functional>
-#include <utility>
+#include <initializer_list>
 
 // IWYU pragma: no_include <expected>
 // IWYU pragma: no_include <chrono>
@@ -53,14 +54,22 @@ VkPipelineLayout gltfviewer::pbr_shader_t::pipeline_layout() const
 void gltfviewer::pbr_shader_t::draw(scene_graph_t const& graph,
     VkCommandBuffer command_buffer)
 {
+    if (culling_pipeline_.pending() && culling_pipeline_.poll())
+    {
+        VKRNDR_IF_DEBUG_UTILS(object_name(backend_->device(),
+            culling_pipeline_.current(),
+            "Culling Pipeline"));
+    }
+
     auto switch_pipeline =
         [command_buffer,
-            bound = static_cast<vkrndr::pipeline_t*>(nullptr),
+            bound = static_cast<vkrndr::pipeline_t const*>(nullptr),
             this]([[maybe_unused]] ngnast::alpha_mode_t const mode,
             bool const double_sided) mutable
     {
-        auto* const required_pipeline{
-            double_sided ? &double_sided_pipeline_ : &culling_pipeline_};
+        auto const* const required_pipeline{double_sided
+                ? &double_sided_pipeline_
+                : &culling_pipeline_.current()};
         if (bound != required_pipeline)
         {
             vkrndr::bind_pipeline(command_buffer, *required_pipeline);
@@ -72,12 +81,14 @@ void gltfviewer::pbr_shader_t::draw(scene_graph_t const& graph,
         [[maybe_unused]] vkrndr::command_buffer_scope_t const color_pass_scope{
             command_buffer,
             "Opaque & Mask"});
-    graph.traverse(static_cast<ngnast::alpha_mode_t>(
-                       std::to_underlying(ngnast::alpha_mode_t::opaque) |
-                       std::to_underlying(ngnast::alpha_mode_t::mask)),
-        command_buffer,
-        double_sided_pipeline_.layout,
-        switch_pipeline);
+    for (ngnast::alpha_mode_t const mode :
+        {ngnast::alpha_mode_t::opaque, ngnast::alpha_mode_t::mask})
+    {
+        graph.draw(graph.draw_packets(mode),
+            command_buffer,
+            double_sided_pipeline_.layout,
+            switch_pipeline);
+    }
 }
 
 void gltfviewer::pbr_shader_t::load(VkDescriptorSetLayout environment_layout,
@@ -85,6 +96,11 @@ void gltfviewer::pbr_shader_t::load(VkDescriptorSetLayout environment_layout,
     VkDescriptorSetLayout shadow_layout,
     VkFormat depth_buffer_format)
 {
+    // Pending compilation may still reference the shader modules
+    destroy(backend_->device(), culling_pipeline_);
+    destroy(backend_->device(), double_sided_pipeline_);
+    destroy(backend_->device(), pipeline_layout_);
+
     vkglsl::shader_set_t shader_set{enable_shader_debug_symbols,
         enable_shader_optimization};
 
@@ -130,10 +146,6 @@ void gltfviewer::pbr_shader_t::load(VkDescriptorSetLayout environment_layout,
         fragment_write_time_ = wt;
     }
 
-    destroy(backend_->device(), double_sided_pipeline_);
-    destroy(backend_->device(), culling_pipeline_);
-    destroy(backend_->device(), pipeline_layout_);
-
     pipeline_layout_ = vkrndr::pipeline_layout_builder_t{backend_->device()}
                            .add_descriptor_set_layout(environment_layout)
                            .add_descriptor_set_layout(materials_layout)
@@ -142,7 +154,7 @@ void gltfviewer::pbr_shader_t::load(VkDescriptorSetLayout environment_layout,
                                .stageFlags = VK_SHADER_STAGE_VERTEX_BIT |
                                    VK_SHADER_STAGE_FRAGMENT_BIT,
                                .offset = 0,
-                               .size = 32})
+                               .size = 48})
                            .build();
 
     double_sided_pipeline_ =
@@ -159,7 +171,9 @@ void gltfviewer::pbr_shader_t::load(VkDescriptorSetLayout environment_layout,
         double_sided_pipeline_,
         "Double Sided Pipeline"));
 
-    culling_pipeline_ =
+    // Culled faces are drawn by the fallback until the pipeline is compiled,
+    // which gives the same image for closed meshes
+    culling_pipeline_ = backend_->pipeline_compiler().compile(
         vkrndr::graphics_pipeline_builder_t{backend_->device(),
             pipeline_layout_}
             .add_shader(as_pipeline_shader(vertex_shader_))
@@ -169,8 +183,6 @@ void gltfviewer::pbr_shader_t::load(VkDescriptorSetLayout environment_layout,
             .with_rasterization_samples(backend_->device().max_msaa_samples)
             .with_depth_test(depth_buffer_format, VK_COMPARE_OP_LESS_OR_EQUAL)
             .with_culling(VK_CULL_MODE_BACK_BIT,
-                VK_FRONT_FACE_COUNTER_CLOCKWISE)
-            .build();
-    VKRNDR_IF_DEBUG_UTILS(
-        object_name(backend_->device(), culling_pipeline_, "Culling Pipeline"));
+                VK_FRONT_FACE_COUNTER_CLOCKWISE),
+        double_sided_pipeline_);
 }
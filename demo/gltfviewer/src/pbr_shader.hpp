@@ -2,6 +2,7 @@
 #define GLTFVIEWER_PBR_SHADER_INCLUDED
 
 #include <vkrndr_pipeline.hpp>
+#include <vkrndr_pipeline_compiler.hpp>
 #include <vkrndr_shader_module.hpp>
 
 #include <volk.h>
@@ -58,7 +59,8 @@ namespace gltfviewer
 
         vkrndr::pipeline_layout_t pipeline_layout_;
         vkrndr::pipeline_t double_sided_pipeline_;
-        vkrndr::pipeline_t culling_pipeline_;
+        // Double sided pipeline is drawn until this one is compiled
+        vkrndr::deferred_pipeline_t culling_pipeline_;
     };
 } // namespace gltfviewer
 #endif
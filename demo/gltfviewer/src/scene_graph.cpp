@@ -4,7 +4,11 @@
 #include <cppext_numeric.hpp>
 
 #include <ngnast_gpu_transfer.hpp>
+#include <ngnast_mesh_transform.hpp>
 #include <ngnast_scene_model.hpp>
+#include <ngnast_transform_hierarchy.hpp>
+
+#include <ngngfx_frustum.hpp>
 
 #include <vkrndr_backend.hpp>
 #include <vkrndr_buffer.hpp>
@@ -12,65 +16,81 @@
 
 #include <boost/scope/defer.hpp>
 
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/matrix.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 
 #include <vma_impl.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <span>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 // IWYU pragma: no_include <optional>
 // IWYU pragma: no_include <ranges>
-// IWYU pragma: no_include <vector>
 
 namespace
 {
     struct [[nodiscard]] push_constants_t final
     {
-        uint32_t transform_index;
         uint32_t material_index;
         VkDeviceAddress vertices;
         VkDeviceAddress transforms;
+        VkDeviceAddress colors;
+        VkDeviceAddress instances;
     };
 
+    // Push constants of the scene graph follow the first 8 bytes set by
+    // the application
+    constexpr uint32_t push_constants_offset{8};
+
+    constexpr VkShaderStageFlags push_constants_stages{
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT};
+
     struct [[nodiscard]] transform_t final
     {
         glm::mat4 model;
         glm::mat4 model_inverse;
     };
 
-    [[nodiscard]] uint32_t calculate_transform(
-        ngnast::scene_model_t const& model,
-        ngnast::node_t const& node,
-        transform_t* const transforms,
-        glm::mat4 const& transform,
-        uint32_t const index)
+    void calculate_transform(ngnast::mesh_t const& mesh,
+        std::span<ngnast::gpu::primitive_t const> const& primitives,
+        glm::mat4 const& node_transform,
+        transform_t& transform,
+        gltfviewer::draw_bounds_t& bounds)
     {
-        auto const node_transform{transform * node.matrix};
-
-        uint32_t drawn{0};
-        if (node.mesh_index)
-        {
-            transforms[index].model = node_transform;
-            transforms[index].model_inverse =
-                glm::transpose(glm::inverse(node_transform));
-
-            ++drawn;
-        }
-
-        // cppcheck-suppress-begin useStlAlgorithm
-        for (auto const& child : node.children(model))
-        {
-            drawn += calculate_transform(model,
-                child,
-                transforms,
-                node_transform,
-                index + drawn);
-        }
-        // cppcheck-suppress-end useStlAlgorithm
-
-        return drawn;
+        // All primitives of a mesh share the same dequantization, it is
+        // applied only to positions
+        glm::mat4 const dequantization{mesh.primitive_indices.empty()
+                ? glm::mat4{1.0f}
+                : ngnast::gpu::dequantization_matrix(
+                      primitives[mesh.primitive_indices.front()])};
+
+        transform.model = node_transform * dequantization;
+        transform.model_inverse = glm::transpose(glm::inverse(node_transform));
+
+        glm::vec3 const center{
+            (mesh.bounding_box.min + mesh.bounding_box.max) * 0.5f};
+        float const scale{
+            glm::max(glm::max(glm::length(glm::vec3{node_transform[0]}),
+                         glm::length(glm::vec3{node_transform[1]})),
+                glm::length(glm::vec3{node_transform[2]}))};
+
+        bounds = {
+            .center = glm::vec3{node_transform * glm::vec4{center, 1.0f}},
+            .radius = scale * 0.5f *
+                glm::length(mesh.bounding_box.max - mesh.bounding_box.min),
+            .scale = scale,
+            .box = ngnast::calculate_aabb(mesh.bounding_box, node_transform)};
     }
 } // namespace
 
@@ -88,8 +108,15 @@ void gltfviewer::scene_graph_t::load(ngnast::scene_model_t&& model)
 {
     clear();
 
+    for (ngnast::primitive_t& primitive : model.primitives)
+    {
+        ngnast::mesh::generate_lods(primitive);
+    }
+
     auto transfer_result{
-        ngnast::gpu::transfer_geometry(backend_->device(), model)};
+        ngnast::gpu::transfer_geometry(backend_->device(),
+            model,
+            {.vertex_format = ngnast::gpu::vertex_format_t::packed})};
     boost::scope::defer_guard destroy_transfer{[this, &transfer_result]()
         { destroy(backend_->device(), transfer_result); }};
 
@@ -105,6 +132,17 @@ void gltfviewer::scene_graph_t::load(ngnast::scene_model_t&& model)
             .alignment = 64});
     backend_->transfer_buffer(transfer_result.vertex_buffer, vertex_buffer_);
 
+    if (transfer_result.color_buffer.handle != VK_NULL_HANDLE)
+    {
+        color_buffer_ = create_buffer(backend_->device(),
+            {.size = transfer_result.color_buffer.size,
+                .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                    VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
+        backend_->transfer_buffer(transfer_result.color_buffer, color_buffer_);
+    }
+
     if (transfer_result.index_count > 0)
     {
         index_count_ = transfer_result.index_count;
@@ -116,7 +154,24 @@ void gltfviewer::scene_graph_t::load(ngnast::scene_model_t&& model)
         backend_->transfer_buffer(transfer_result.index_buffer, index_buffer_);
     }
 
-    uint32_t const transform_count{required_transforms(model, false)};
+    // Drawn nodes are ordered as in the flattened hierarchy, the draw index
+    // is also the index of the transform
+    ngnast::transform_hierarchy_t hierarchy{ngnast::flatten_hierarchy(model)};
+    ngnast::update_world_matrices(hierarchy);
+
+    std::vector<glm::mat4> drawn_matrices;
+    for (size_t i{}; i != hierarchy.node_indices.size(); ++i)
+    {
+        ngnast::node_t const& node{model.nodes[hierarchy.node_indices[i]]};
+        if (node.mesh_index)
+        {
+            drawn_meshes_.push_back(*node.mesh_index);
+            drawn_matrices.push_back(hierarchy.world_matrices[i]);
+        }
+    }
+
+    auto const transform_count{
+        cppext::narrow<uint32_t>(drawn_meshes_.size())};
     VkDeviceSize const transform_buffer_size{
         transform_count * sizeof(transform_t)};
     for (auto& data : cppext::as_span(frame_data_))
@@ -134,17 +189,60 @@ void gltfviewer::scene_graph_t::load(ngnast::scene_model_t&& model)
         data.uniform_map = map_memory(backend_->device(), data.uniform);
     }
 
-    calculate_transforms(model, cppext::as_span(frame_data_));
+    // Each primitive of a drawn node can be an instance of both the view
+    // and the shadow caster render list
+    for (size_t const mesh_index : drawn_meshes_)
+    {
+        instance_capacity_ += 2 *
+            cppext::narrow<uint32_t>(
+                model.meshes[mesh_index].primitive_indices.size());
+    }
+
+    for (auto& data : cppext::as_span(frame_data_))
+    {
+        data.instances = create_buffer(backend_->device(),
+            {.size = instance_capacity_ * sizeof(uint32_t),
+                .usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                    VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                .allocation_flags =
+                    VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+                .required_memory_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                .alignment = 16});
+        data.instances_map = map_memory(backend_->device(), data.instances);
+    }
+
+    draw_bounds_.resize(transform_count);
+    for (frame_data_t& data : cppext::as_span(frame_data_))
+    {
+        std::span const transforms{
+            data.uniform_map.as<transform_t>(), transform_count};
+        for (uint32_t i{}; i != transform_count; ++i)
+        {
+            calculate_transform(model.meshes[drawn_meshes_[i]],
+                primitives_,
+                drawn_matrices[i],
+                transforms[i],
+                draw_bounds_[i]);
+        }
+    }
+
+    for (draw_bounds_t const& bounds : draw_bounds_)
+    {
+        draw_boxes_.push_back(bounds.box.min, bounds.box.max);
+    }
+    // Everything is visible until the frustum is known
+    visible_.assign(draw_bounds_.size(), 1);
 
     model_ = std::move(model);
     model_.primitives.clear();
     model_.images.clear();
 }
 
-void gltfviewer::scene_graph_t::bind_on(VkCommandBuffer command_buffer)
-{
-    frame_data_.cycle();
+void gltfviewer::scene_graph_t::begin_frame() { frame_data_.cycle(); }
 
+void gltfviewer::scene_graph_t::bind_on(VkCommandBuffer command_buffer) const
+{
     if (index_count_)
     {
         vkCmdBindIndexBuffer(command_buffer,
@@ -154,130 +252,225 @@ void gltfviewer::scene_graph_t::bind_on(VkCommandBuffer command_buffer)
     }
 }
 
-void gltfviewer::scene_graph_t::traverse(ngnast::alpha_mode_t alpha_mode,
-    VkCommandBuffer command_buffer,
-    VkPipelineLayout layout,
-    std::function<void(ngnast::alpha_mode_t, bool)> const& switch_pipeline)
-    const
+void gltfviewer::scene_graph_t::update_lod(glm::vec3 const& camera_position,
+    float const projection_scale)
 {
-    uint32_t drawn{0};
-    for (auto const& graph : model_.scenes)
-    {
-        // cppcheck-suppress-begin useStlAlgorithm
-        for (auto const& root : graph.roots(model_))
-        {
-            drawn += draw_node(command_buffer,
-                layout,
-                root,
-                alpha_mode,
-                drawn,
-                switch_pipeline);
-        }
-        // cppcheck-suppress-end useStlAlgorithm
-    }
+    camera_position_ = camera_position;
+    projection_scale_ = projection_scale;
 }
 
-void gltfviewer::scene_graph_t::calculate_transforms(
-    ngnast::scene_model_t const& model,
-    std::span<frame_data_t> frames)
+void gltfviewer::scene_graph_t::update_visibility(
+    ngngfx::frustum_t const& frustum)
 {
-    for (frame_data_t& data : frames)
-    {
-        uint32_t drawn{0};
-        for (auto const& graph : model.scenes)
-        {
-            // cppcheck-suppress-begin useStlAlgorithm
-            for (auto const& root : graph.roots(model))
-            {
-                drawn += calculate_transform(model,
-                    root,
-                    data.uniform_map.as<transform_t>(),
-                    glm::mat4{1.0f},
-                    drawn);
-            }
-            // cppcheck-suppress-end useStlAlgorithm
-        }
-    }
+    ngngfx::frustum_cull(frustum, draw_boxes_, visible_);
 }
 
-uint32_t gltfviewer::scene_graph_t::draw_node(VkCommandBuffer command_buffer,
-    VkPipelineLayout layout,
-    ngnast::node_t const& node,
-    ngnast::alpha_mode_t const& alpha_mode,
-    uint32_t const index,
-    std::function<void(ngnast::alpha_mode_t, bool)> const& switch_pipeline)
-    const
+void gltfviewer::scene_graph_t::build_render_list()
 {
-    uint32_t drawn{0};
-    if (node.mesh_index)
+    draw_instances_.clear();
+    shadow_caster_instances_.clear();
+
+    auto const count{cppext::narrow<uint32_t>(drawn_meshes_.size())};
+    for (uint32_t index{}; index != count; ++index)
     {
-        auto const& mesh{model_.meshes[*node.mesh_index]};
+        float const node_pixels_per_unit{pixels_per_unit(index)};
 
-        // cppcheck-suppress-begin useStlAlgorithm
+        auto const& mesh{model_.meshes[drawn_meshes_[index]]};
         for (auto const pi : mesh.primitive_indices)
         {
             auto const& primitive{primitives_[pi]};
 
-            push_constants_t const pc{.transform_index = index,
+            draw_packet_t packet{.alpha_mode = ngnast::alpha_mode_t::opaque,
+                .double_sided = false,
                 .material_index =
                     cppext::narrow<uint32_t>(primitive.material_index),
-                .vertices = vertex_buffer_.device_address,
-                .transforms = frame_data_->uniform.device_address};
+                .is_indexed = primitive.is_indexed,
+                .count = primitive.count,
+                .first = primitive.first,
+                .vertex_offset = primitive.vertex_offset,
+                .first_instance = 0,
+                .instance_count = 0};
 
             if (!model_.materials.empty())
             {
                 auto const& material{
                     model_.materials[primitive.material_index]};
-                if ((std::to_underlying(material.alpha_mode) &
-                        std::to_underlying(alpha_mode)) == 0)
-                {
-                    continue;
-                }
-                switch_pipeline(alpha_mode, material.double_sided);
+                packet.alpha_mode = material.alpha_mode;
+                packet.double_sided = material.double_sided;
             }
 
-            vkCmdPushConstants(command_buffer,
-                layout,
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                8,
-                sizeof(pc),
-                &pc);
             if (primitive.is_indexed)
             {
-                vkCmdDrawIndexed(command_buffer,
-                    primitive.count,
-                    1,
-                    primitive.first,
-                    primitive.vertex_offset,
-                    0);
+                ngnast::gpu::lod_t const lod{
+                    ngnast::gpu::select_lod(primitive, node_pixels_per_unit)};
+                packet.count = lod.count;
+                packet.first = lod.first;
             }
-            else
+
+            draw_instance_t const instance{.packet = packet,
+                .primitive = cppext::narrow<uint32_t>(pi),
+                .transform_index = index};
+
+            if (visible_[index] != 0)
+            {
+                draw_instances_.push_back(instance);
+            }
+
+            // Casters outside of the view frustum can still shadow visible
+            // geometry
+            if (packet.alpha_mode == ngnast::alpha_mode_t::opaque)
             {
-                vkCmdDraw(command_buffer,
-                    primitive.count,
-                    1,
-                    primitive.first,
-                    0);
+                shadow_caster_instances_.push_back(instance);
             }
         }
-        // cppcheck-suppress-end useStlAlgorithm
+    }
+
+    uint32_t first_instance{0};
+    build_packets(draw_instances_, draw_packets_, first_instance);
+    build_packets(shadow_caster_instances_,
+        shadow_caster_packets_,
+        first_instance);
+}
+
+std::span<gltfviewer::draw_packet_t const>
+gltfviewer::scene_graph_t::draw_packets(
+    ngnast::alpha_mode_t const alpha_mode) const
+{
+    auto const packets{std::ranges::equal_range(draw_packets_,
+        alpha_mode,
+        {},
+        &draw_packet_t::alpha_mode)};
+    return {packets.begin(), packets.end()};
+}
+
+std::span<gltfviewer::draw_packet_t const>
+gltfviewer::scene_graph_t::shadow_caster_packets() const
+{
+    return shadow_caster_packets_;
+}
+
+void gltfviewer::scene_graph_t::draw(
+    std::span<draw_packet_t const> const packets,
+    VkCommandBuffer command_buffer,
+    VkPipelineLayout layout,
+    std::function<void(ngnast::alpha_mode_t, bool)> const& switch_pipeline)
+    const
+{
+    if (packets.empty())
+    {
+        return;
+    }
+
+    push_constants_t const pc{.material_index = packets.front().material_index,
+        .vertices = vertex_buffer_.device_address,
+        .transforms = frame_data_->uniform.device_address,
+        .colors = color_buffer_.device_address,
+        .instances = frame_data_->instances.device_address};
+    vkCmdPushConstants(command_buffer,
+        layout,
+        push_constants_stages,
+        push_constants_offset,
+        sizeof(pc),
+        &pc);
+
+    for (size_t i{}; i != packets.size(); ++i)
+    {
+        draw_packet_t const& packet{packets[i]};
+
+        if (i == 0 || packet.alpha_mode != packets[i - 1].alpha_mode ||
+            packet.double_sided != packets[i - 1].double_sided)
+        {
+            switch_pipeline(packet.alpha_mode, packet.double_sided);
+        }
+
+        if (i != 0 && packet.material_index != packets[i - 1].material_index)
+        {
+            vkCmdPushConstants(command_buffer,
+                layout,
+                push_constants_stages,
+                push_constants_offset +
+                    offsetof(push_constants_t, material_index),
+                sizeof(packet.material_index),
+                &packet.material_index);
+        }
 
-        ++drawn;
+        if (packet.is_indexed)
+        {
+            vkCmdDrawIndexed(command_buffer,
+                packet.count,
+                packet.instance_count,
+                packet.first,
+                packet.vertex_offset,
+                packet.first_instance);
+        }
+        else
+        {
+            vkCmdDraw(command_buffer,
+                packet.count,
+                packet.instance_count,
+                packet.first,
+                packet.first_instance);
+        }
     }
+}
 
-    // cppcheck-suppress-begin useStlAlgorithm
-    for (auto const& child : node.children(model_))
+void gltfviewer::scene_graph_t::build_packets(
+    std::span<draw_instance_t> const instances,
+    std::vector<draw_packet_t>& packets,
+    uint32_t& first_instance)
+{
+    // Alpha mode and double sidedness select the pipeline, instances of
+    // the same primitive level of detail end up next to each other
+    std::ranges::sort(instances,
+        {},
+        [](draw_instance_t const& instance)
+        {
+            return std::tuple{std::to_underlying(instance.packet.alpha_mode),
+                instance.packet.double_sided,
+                instance.packet.material_index,
+                instance.primitive,
+                instance.packet.first,
+                instance.transform_index};
+        });
+
+    std::span const transform_indices{
+        frame_data_->instances_map.as<uint32_t>(),
+        instance_capacity_};
+
+    packets.clear();
+    for (size_t i{}; i != instances.size(); ++i)
     {
-        drawn += draw_node(command_buffer,
-            layout,
-            child,
-            alpha_mode,
-            index + drawn,
-            switch_pipeline);
+        draw_instance_t const& instance{instances[i]};
+        if (i == 0 || instance.primitive != instances[i - 1].primitive ||
+            instance.packet.first != instances[i - 1].packet.first)
+        {
+            draw_packet_t& packet{packets.emplace_back(instance.packet)};
+            packet.first_instance = first_instance;
+            packet.instance_count = 0;
+        }
+
+        transform_indices[first_instance++] = instance.transform_index;
+        ++packets.back().instance_count;
+    }
+}
+
+float gltfviewer::scene_graph_t::pixels_per_unit(uint32_t const index) const
+{
+    // Full detail until the view is known or when camera is inside the bounds
+    if (projection_scale_ == 0.0f)
+    {
+        return std::numeric_limits<float>::max();
     }
-    // cppcheck-suppress-end useStlAlgorithm
 
-    return drawn;
+    draw_bounds_t const& bounds{draw_bounds_[index]};
+    float const distance{
+        glm::distance(camera_position_, bounds.center) - bounds.radius};
+    if (distance <= 0.0f)
+    {
+        return std::numeric_limits<float>::max();
+    }
+
+    return projection_scale_ * bounds.scale / distance;
 }
 
 void gltfviewer::scene_graph_t::clear()
@@ -289,6 +482,12 @@ void gltfviewer::scene_graph_t::clear()
             unmap_memory(backend_->device(), &data.uniform_map);
             destroy(backend_->device(), data.uniform);
         }
+
+        if (data.instances_map.allocation)
+        {
+            unmap_memory(backend_->device(), &data.instances_map);
+            destroy(backend_->device(), data.instances);
+        }
     }
 
     if (index_count_ != 0)
@@ -303,5 +502,17 @@ void gltfviewer::scene_graph_t::clear()
         vertex_count_ = 0;
     }
 
+    destroy(backend_->device(), color_buffer_);
+    color_buffer_ = {};
+
     primitives_.clear();
+    drawn_meshes_.clear();
+    instance_capacity_ = 0;
+    draw_instances_.clear();
+    shadow_caster_instances_.clear();
+    draw_packets_.clear();
+    shadow_caster_packets_.clear();
+    draw_bounds_.clear();
+    draw_boxes_.clear();
+    visible_.clear();
 }
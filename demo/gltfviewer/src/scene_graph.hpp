@@ -6,11 +6,16 @@
 #include <ngnast_gpu_transfer.hpp> // IWYU pragma: keep
 #include <ngnast_scene_model.hpp>
 
+#include <ngngfx_frustum.hpp>
+
 #include <vkrndr_buffer.hpp>
 #include <vkrndr_memory.hpp>
 
+#include <glm/vec3.hpp>
+
 #include <volk.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <span>
@@ -23,6 +28,31 @@ namespace vkrndr
 
 namespace gltfviewer
 {
+    // World space bounding sphere and box of a drawn node and the largest
+    // scale of its transform
+    struct [[nodiscard]] draw_bounds_t final
+    {
+        glm::vec3 center;
+        float radius;
+        float scale;
+        ngnast::bounding_box_t box;
+    };
+
+    // Instanced draw of a primitive level of detail, instances read their
+    // transform index from the instance buffer of the frame
+    struct [[nodiscard]] draw_packet_t final
+    {
+        ngnast::alpha_mode_t alpha_mode;
+        bool double_sided;
+        uint32_t material_index;
+        bool is_indexed;
+        uint32_t count;
+        uint32_t first;
+        int32_t vertex_offset;
+        uint32_t first_instance;
+        uint32_t instance_count;
+    };
+
     class [[nodiscard]] scene_graph_t final
     {
     public:
@@ -40,9 +70,37 @@ namespace gltfviewer
 
         void load(ngnast::scene_model_t&& model);
 
-        void bind_on(VkCommandBuffer command_buffer);
+        void begin_frame();
+
+        // Can be called concurrently on different command buffers
+        void bind_on(VkCommandBuffer command_buffer) const;
+
+        // Levels of detail are selected based on camera position, projection
+        // scale is viewport height / (2 * tan(fov / 2))
+        void update_lod(glm::vec3 const& camera_position,
+            float projection_scale);
+
+        // Culls drawn nodes against the view frustum
+        void update_visibility(ngngfx::frustum_t const& frustum);
+
+        // Walks drawn nodes once and merges their primitives into instanced
+        // draw packets sorted by alpha mode, double sidedness, material and
+        // primitive. Has to be called after LOD and visibility updates,
+        // before any pass is recorded.
+        void build_render_list();
 
-        void traverse(ngnast::alpha_mode_t alpha_mode,
+        // Packets of visible nodes with the alpha mode
+        [[nodiscard]] std::span<draw_packet_t const> draw_packets(
+            ngnast::alpha_mode_t alpha_mode) const;
+
+        // Packets of opaque geometry including nodes outside of the view
+        // frustum
+        [[nodiscard]] std::span<draw_packet_t const>
+        shadow_caster_packets() const;
+
+        // Pipeline is switched only when alpha mode or double sidedness
+        // changes between consecutive packets
+        void draw(std::span<draw_packet_t const> packets,
             VkCommandBuffer command_buffer,
             VkPipelineLayout layout,
             std::function<void(ngnast::alpha_mode_t, bool)> const&
@@ -58,19 +116,25 @@ namespace gltfviewer
         {
             vkrndr::buffer_t uniform;
             vkrndr::mapped_memory_t uniform_map;
+
+            // Transform index of each instance of draw packets
+            vkrndr::buffer_t instances;
+            vkrndr::mapped_memory_t instances_map;
+        };
+
+        struct [[nodiscard]] draw_instance_t final
+        {
+            draw_packet_t packet;
+            uint32_t primitive;
+            uint32_t transform_index;
         };
 
     private:
-        static void calculate_transforms(ngnast::scene_model_t const& model,
-            std::span<frame_data_t> frames);
+        void build_packets(std::span<draw_instance_t> instances,
+            std::vector<draw_packet_t>& packets,
+            uint32_t& first_instance);
 
-        uint32_t draw_node(VkCommandBuffer command_buffer,
-            VkPipelineLayout layout,
-            ngnast::node_t const& node,
-            ngnast::alpha_mode_t const& alpha_mode,
-            uint32_t index,
-            std::function<void(ngnast::alpha_mode_t, bool)> const&
-                switch_pipeline) const;
+        [[nodiscard]] float pixels_per_unit(uint32_t index) const;
 
         void clear();
 
@@ -83,10 +147,32 @@ namespace gltfviewer
         uint32_t vertex_count_{};
         vkrndr::buffer_t vertex_buffer_;
 
+        // Optional, device address is 0 when the model has no vertex colors
+        vkrndr::buffer_t color_buffer_;
+
         uint32_t index_count_{};
         vkrndr::buffer_t index_buffer_;
 
         cppext::cycled_buffer_t<frame_data_t> frame_data_;
+
+        // Mesh index of each drawn node, in depth first order of the node
+        // hierarchy
+        std::vector<size_t> drawn_meshes_;
+        // Instances of both render lists together
+        uint32_t instance_capacity_{};
+
+        std::vector<draw_instance_t> draw_instances_;
+        std::vector<draw_instance_t> shadow_caster_instances_;
+        std::vector<draw_packet_t> draw_packets_;
+        std::vector<draw_packet_t> shadow_caster_packets_;
+
+        // World space bounds of each drawn node, used for LOD selection
+        // and culling
+        std::vector<draw_bounds_t> draw_bounds_;
+        ngngfx::aabb_array_t draw_boxes_;
+        std::vector<uint8_t> visible_;
+        glm::vec3 camera_position_{};
+        float projection_scale_{};
     };
 } // namespace gltfviewer
 
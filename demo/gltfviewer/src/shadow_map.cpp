@@ -225,7 +225,7 @@ void gltfviewer::shadow_map_t::draw(scene_graph_t const& graph,
 
         vkrndr::bind_pipeline(command_buffer, depth_pipeline_);
 
-        graph.traverse(ngnast::alpha_mode_t::opaque,
+        graph.draw(graph.shadow_caster_packets(),
             command_buffer,
             depth_pipeline_.layout,
             []([[maybe_unused]] ngnast::alpha_mode_t const mode,
@@ -304,7 +304,7 @@ void gltfviewer::shadow_map_t::load(VkDescriptorSetLayout environment_layout,
                 VkPushConstantRange{.stageFlags = VK_SHADER_STAGE_VERTEX_BIT |
                         VK_SHADER_STAGE_FRAGMENT_BIT,
                     .offset = 0,
-                    .size = 32})
+                    .size = 48})
             .build();
 
     depth_pipeline_ = vkrndr::graphics_pipeline_builder_t{backend_->device(),
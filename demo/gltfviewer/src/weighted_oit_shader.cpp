@@ -201,7 +201,7 @@ void gltfviewer::weighted_oit_shader_t::draw(scene_graph_t const& graph,
 
         vkrndr::bind_pipeline(command_buffer, pbr_pipeline_);
 
-        graph.traverse(ngnast::alpha_mode_t::blend,
+        graph.draw(graph.draw_packets(ngnast::alpha_mode_t::blend),
             command_buffer,
             pbr_pipeline_.layout,
             switch_pipeline);
@@ -370,7 +370,7 @@ void gltfviewer::weighted_oit_shader_t::load(
                                    .stageFlags = VK_SHADER_STAGE_VERTEX_BIT |
                                        VK_SHADER_STAGE_FRAGMENT_BIT,
                                    .offset = 0,
-                                   .size = 32})
+                                   .size = 48})
                                .build();
     pbr_pipeline_ =
         vkrndr::graphics_pipeline_builder_t{backend_->device(),
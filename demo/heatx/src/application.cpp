@@ -103,6 +103,8 @@
 
 namespace
 {
+    constexpr char const* shader_cache_directory{"shader_cache"};
+
     struct [[nodiscard]] uniform_data_t final
     {
         glm::mat4 inverse_view;
@@ -216,6 +218,7 @@ heatx::application_t::application_t(int argc, char const** argv)
                                                          },
           .command_line_parameters = {argv, cppext::narrow<size_t>(argc)}}}
     , camera_controller_{camera_, mouse_}
+    , guard_{shader_cache_directory}
     , render_window_{std::make_unique<ngnwsi::render_window_t>("heatx",
           SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIGH_PIXEL_DENSITY,
           1280,
@@ -864,10 +867,9 @@ void heatx::application_t::on_resize(uint32_t const width,
         return;
     }
 
-    vkrndr::frame_in_flight_t& in_flight{render_window_->frame_in_flight()};
     std::function<void(std::function<void()>)> const deletion_queue_insert{
-        [&in_flight](std::function<void()> cb)
-        { in_flight.cleanup.push_back(std::move(cb)); }};
+        [this](std::function<void()> cb)
+        { render_window_->defer(std::move(cb)); }};
 
     deletion_queue_insert(
         [&device = backend_->device(), image = ray_generation_storage_]()
@@ -0,0 +1,60 @@
+#ifndef CPPEXT_MAPPED_FILE_INCLUDED
+#define CPPEXT_MAPPED_FILE_INCLUDED
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+namespace cppext
+{
+    enum class access_hint_t
+    {
+        normal,
+        sequential,
+        random,
+        will_need,
+    };
+
+    // Read only view of the whole file mapped to memory. Contents are valid
+    // while the object is alive.
+    class [[nodiscard]] mapped_file_t final
+    {
+    public:
+        mapped_file_t();
+
+        explicit mapped_file_t(std::filesystem::path const& file);
+
+        mapped_file_t(mapped_file_t const&) = delete;
+
+        mapped_file_t(mapped_file_t&&) noexcept;
+
+    public:
+        ~mapped_file_t();
+
+    public:
+        [[nodiscard]] std::span<std::byte const> bytes() const;
+
+        [[nodiscard]] std::span<char const> chars() const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] bool empty() const;
+
+        // Hint to the operating system about expected access pattern, returns
+        // false if the hint is not supported on the platform
+        // cppcheck-suppress functionConst
+        bool advise(access_hint_t hint);
+
+    public:
+        mapped_file_t& operator=(mapped_file_t const&) = delete;
+
+        mapped_file_t& operator=(mapped_file_t&&) noexcept;
+
+    private:
+        struct impl_t;
+        std::unique_ptr<impl_t> impl_;
+    };
+} // namespace cppext
+
+#endif
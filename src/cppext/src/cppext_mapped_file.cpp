@@ -0,0 +1,102 @@
+#include <cppext_mapped_file.hpp>
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <system_error>
+
+struct [[nodiscard]] cppext::mapped_file_t::impl_t final
+{
+    boost::interprocess::mapped_region region;
+};
+
+cppext::mapped_file_t::mapped_file_t() = default;
+
+cppext::mapped_file_t::mapped_file_t(std::filesystem::path const& file)
+{
+    // Regions of zero size can't be mapped, empty file is an empty view
+    if (std::filesystem::file_size(file) == 0)
+    {
+        return;
+    }
+
+    try
+    {
+        boost::interprocess::file_mapping const mapping{file.c_str(),
+            boost::interprocess::read_only};
+
+        // Mapped region remains valid after the file mapping is closed
+        impl_ = std::make_unique<impl_t>(
+            boost::interprocess::mapped_region{mapping,
+                boost::interprocess::read_only});
+    }
+    catch (boost::interprocess::interprocess_exception const& ex)
+    {
+        throw std::system_error{
+            std::error_code{ex.get_native_error(), std::system_category()},
+            "failed to map file!"};
+    }
+}
+
+cppext::mapped_file_t::mapped_file_t(mapped_file_t&&) noexcept = default;
+
+cppext::mapped_file_t::~mapped_file_t() = default;
+
+cppext::mapped_file_t& cppext::mapped_file_t::operator=(
+    mapped_file_t&&) noexcept = default;
+
+std::span<std::byte const> cppext::mapped_file_t::bytes() const
+{
+    if (!impl_)
+    {
+        return {};
+    }
+
+    return {static_cast<std::byte const*>(impl_->region.get_address()),
+        impl_->region.get_size()};
+}
+
+std::span<char const> cppext::mapped_file_t::chars() const
+{
+    if (!impl_)
+    {
+        return {};
+    }
+
+    return {static_cast<char const*>(impl_->region.get_address()),
+        impl_->region.get_size()};
+}
+
+size_t cppext::mapped_file_t::size() const
+{
+    return impl_ ? impl_->region.get_size() : 0;
+}
+
+bool cppext::mapped_file_t::empty() const { return size() == 0; }
+
+bool cppext::mapped_file_t::advise(access_hint_t const hint)
+{
+    if (!impl_)
+    {
+        return true;
+    }
+
+    using advice_t = boost::interprocess::mapped_region::advice_types;
+    switch (hint)
+    {
+    case access_hint_t::sequential:
+        return impl_->region.advise(advice_t::advice_sequential);
+    case access_hint_t::random:
+        return impl_->region.advise(advice_t::advice_random);
+    case access_hint_t::will_need:
+        return impl_->region.advise(advice_t::advice_willneed);
+    case access_hint_t::normal:
+    default:
+        return impl_->region.advise(advice_t::advice_normal);
+    }
+}
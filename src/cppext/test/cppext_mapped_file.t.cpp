@@ -0,0 +1,60 @@
+#include <cppext_mapped_file.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace
+{
+    [[nodiscard]] std::filesystem::path write_temporary_file(
+        std::string_view const name,
+        std::string_view const contents)
+    {
+        auto rv{std::filesystem::temp_directory_path() / name};
+
+        std::ofstream stream{rv, std::ios::binary | std::ios::trunc};
+        stream.write(contents.data(), std::ssize(contents));
+
+        return rv;
+    }
+} // namespace
+
+TEST_CASE("mapped file contents", "[cppext][mapped_file]")
+{
+    static constexpr std::string_view contents{"mapped file contents"};
+
+    auto const path{write_temporary_file("cppext_mapped_file.t", contents)};
+
+    cppext::mapped_file_t file{path};
+    CHECK(file.size() == contents.size());
+    CHECK_FALSE(file.empty());
+    CHECK(std::ranges::equal(file.chars(), contents));
+    CHECK(file.bytes().size() == contents.size());
+
+    CHECK(file.advise(cppext::access_hint_t::sequential));
+
+    cppext::mapped_file_t moved{std::move(file)};
+    CHECK(std::ranges::equal(moved.chars(), contents));
+}
+
+TEST_CASE("mapped empty file", "[cppext][mapped_file]")
+{
+    auto const path{write_temporary_file("cppext_mapped_file_empty.t", {})};
+
+    cppext::mapped_file_t const file{path};
+    CHECK(file.empty());
+    CHECK(file.bytes().empty());
+}
+
+TEST_CASE("mapped missing file", "[cppext][mapped_file]")
+{
+    CHECK_THROWS_AS(cppext::mapped_file_t{"cppext_mapped_file_missing.t"},
+        std::system_error);
+}
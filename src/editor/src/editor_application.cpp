@@ -30,6 +30,7 @@
 #include <vkrndr_execution_port.hpp>
 #include <vkrndr_features.hpp>
 #include <vkrndr_formats.hpp>
+#include <vkrndr_gpu_profiler.hpp>
 #include <vkrndr_image.hpp>
 #include <vkrndr_instance.hpp>
 #include <vkrndr_library_handle.hpp>
@@ -82,6 +83,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <set>
 #include <stdexcept>
 #include <stop_token>
 #include <string>
@@ -98,11 +100,11 @@
 // IWYU pragma: no_include <fmt/format.h>
 // IWYU pragma: no_include <SDL3/SDL_begin_code.h>
 // IWYU pragma: no_include <map>
-// IWYU pragma: no_include <set>
 
 namespace
 {
     constexpr auto application_name{"Niku Editor"};
+    constexpr char const* shader_cache_directory{"shader_cache"};
 
     struct [[nodiscard]] frame_info_t final
     {
@@ -161,6 +163,18 @@ namespace
         vkUpdateDescriptorSets(device, 1, &write_info, 0, nullptr);
     }
 
+    [[nodiscard]] [[maybe_unused]] char const* intern(
+        std::set<std::string, std::less<>>& names,
+        std::string_view const name)
+    {
+        auto it{names.find(name)};
+        if (it == names.cend())
+        {
+            it = names.emplace(name).first;
+        }
+        return it->c_str();
+    }
+
     constexpr std::array<SDL_DialogFileFilter, 1> const filters{
         {{"Asset files", "gltf;glb"}}};
 
@@ -287,7 +301,8 @@ editor::application_t::application_t(
     std::vector<VkFormat> const formats{
         vkrndr::find_supported_texture_compression_formats(
             rendering_context_.device->physical_device)};
-    gltf_loader_ = std::make_unique<ngnast::gltf::loader_t>(std::span{formats});
+    gltf_loader_ = std::make_unique<ngnast::gltf::loader_t>(std::span{formats},
+        &loader_pool_);
 
     vkrndr::execution_port_t& present_queue{
         **std::ranges::find_if(rendering_context_.device->execution_ports,
@@ -345,6 +360,10 @@ editor::application_t::application_t(
     }
 
     uint32_t const frames_in_flight{swapchain->frames_in_flight()};
+    gpu_profiler_ = std::make_unique<vkrndr::gpu_profiler_t>(
+        *rendering_context_.device,
+        frames_in_flight);
+
     pools_.reserve(frames_in_flight);
     command_buffers_.reserve(frames_in_flight);
     frame_info_descriptors_.reserve(frames_in_flight);
@@ -524,6 +543,9 @@ editor::application_t::application_t(
 
 editor::application_t::~application_t()
 {
+    // Loads in flight use the loader, its pool and the device
+    thread_pool_.wait();
+
     render_thread_.reset();
 
     vkDeviceWaitIdle(*rendering_context_.device);
@@ -565,6 +587,8 @@ editor::application_t::~application_t()
         [&d = *rendering_context_.device](VkCommandPool const cp)
         { destroy_command_pool(d, cp); });
 
+    gpu_profiler_.reset();
+
     imgui_.reset();
 
     if (main_window_)
@@ -730,7 +754,9 @@ void editor::application_t::load_files(
         });
 }
 
-editor::application_t::application_t() : camera_controller_{camera_, mouse_}
+editor::application_t::application_t()
+    : glsl_guard_{shader_cache_directory}
+    , camera_controller_{camera_, mouse_}
 {
     camera_.set_position({0.0f, 2.0f, 1.0f});
     camera_.set_yaw_pitch({0.0f, 1.0f});
@@ -858,6 +884,8 @@ void editor::application_t::render()
 
     draw_material_manager({registry_, material_manager_}, *imgui_);
 
+    imgui_->draw_gpu_profiler(*gpu_profiler_);
+
     imgui_->end_frame();
 
     VkCommandBuffer& command_buffer{command_buffers_[index]};
@@ -874,6 +902,13 @@ void editor::application_t::render()
         throw std::runtime_error{message};
     }
 
+    gpu_profiler_->begin_frame(command_buffer);
+    for ([[maybe_unused]] vkrndr::gpu_scope_timing_t const& timing :
+        gpu_profiler_->timings())
+    {
+        TracyPlot(intern(plot_names_, timing.name), timing.milliseconds);
+    }
+
     VkViewport const viewport{.x = 0.0f,
         .y = 0.0f,
         .width = cppext::as_fp(target_image->extent.width),
@@ -912,6 +947,11 @@ void editor::application_t::render()
             0,
             nullptr);
 
+        [[maybe_unused]] vkrndr::gpu_profiler_scope_t const scope{
+            *gpu_profiler_,
+            command_buffer,
+            "Grid"};
+
         vkrndr::render_pass_guard_t guard{grid_color_pass.begin(command_buffer,
             VkRect2D{.offset = {0, 0},
                 .extent = vkrndr::to_2d_extent(target_image->extent)})};
@@ -928,7 +968,13 @@ void editor::application_t::render()
     }
     vkrndr::wait_for_color_attachment_read(*target_image, command_buffer);
 
-    imgui_->render(command_buffer, *target_image);
+    {
+        [[maybe_unused]] vkrndr::gpu_profiler_scope_t const scope{
+            *gpu_profiler_,
+            command_buffer,
+            "ImGui"};
+        imgui_->render(command_buffer, *target_image);
+    }
 
     vkrndr::transition_to_present_layout(*target_image, command_buffer);
 
@@ -9,6 +9,8 @@
 #include <ngnwsi_fixed_timestep.hpp>
 #include <ngnwsi_mouse.hpp>
 
+#include <vkglsl_guard.hpp>
+
 #include <vkrndr_buffer.hpp> // IWYU pragma: keep
 #include <vkrndr_rendering_context.hpp>
 
@@ -24,9 +26,12 @@
 
 #include <volk.h>
 
+#include <functional>
 #include <memory>
+#include <set>
 #include <shared_mutex>
 #include <span>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -45,6 +50,11 @@ namespace ngnwsi
     class imgui_layer_t;
 } // namespace ngnwsi
 
+namespace vkrndr
+{
+    class gpu_profiler_t;
+} // namespace vkrndr
+
 namespace editor
 {
     struct grid_shader_t;
@@ -95,8 +105,13 @@ namespace editor
         void render();
 
     private:
+        vkglsl::guard_t glsl_guard_;
+
         BS::thread_pool<> thread_pool_;
 
+        // Loads run on the general pool and wait for decoding and mesh
+        // processing tasks, those need their own workers
+        BS::thread_pool<> loader_pool_;
         std::unique_ptr<ngnast::gltf::loader_t> gltf_loader_;
 
         entt::dispatcher event_dispatcher_;
@@ -107,6 +122,10 @@ namespace editor
         std::unique_ptr<ngnwsi::render_window_t> main_window_;
         vkrndr::rendering_context_t rendering_context_;
         std::unique_ptr<ngnwsi::imgui_layer_t> imgui_;
+        std::unique_ptr<vkrndr::gpu_profiler_t> gpu_profiler_;
+        // Plots keep pointers to their names, names of profiler scopes are
+        // interned for the lifetime of the application
+        std::set<std::string, std::less<>> plot_names_;
         std::vector<VkCommandPool> pools_;
         std::vector<VkCommandBuffer> command_buffers_;
 
@@ -14,6 +14,7 @@ namespace ngnast
         out_of_memory,
         export_failed,
         load_transform_failed,
+        cache_mismatch,
         unknown,
     };
 
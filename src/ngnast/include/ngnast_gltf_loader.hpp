@@ -3,27 +3,111 @@
 
 #include <ngnast_scene_model.hpp>
 
+#include <BS_thread_pool.hpp> // IWYU pragma: keep
+
 #include <volk.h>
 
+#include <cstddef>
 #include <expected>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <span>
 #include <system_error>
 #include <vector>
 
 namespace ngnast::gltf
 {
+    class loader_t;
+
+    // Full resolution images of a model loaded with loader_t::load_streaming.
+    // Images are decoded in the background and delivered on the thread which
+    // polls the stream.
+    class [[nodiscard]] image_stream_t final
+    {
+    public:
+        using image_callback_t =
+            std::function<void(size_t image_index, image_t&& image)>;
+
+    public:
+        image_stream_t();
+
+        image_stream_t(image_stream_t const&) = delete;
+
+        image_stream_t(image_stream_t&&) noexcept;
+
+    public:
+        // Waits for images which are currently being decoded, images which
+        // haven't been started are skipped
+        ~image_stream_t();
+
+    public:
+        // Delivers images which finished decoding since the last call,
+        // returns number of delivered images
+        size_t poll(image_callback_t const& callback);
+
+        [[nodiscard]] size_t loaded() const;
+
+        [[nodiscard]] size_t total() const;
+
+        [[nodiscard]] bool done() const;
+
+    public:
+        image_stream_t& operator=(image_stream_t const&) = delete;
+
+        image_stream_t& operator=(image_stream_t&&) noexcept;
+
+    private:
+        struct impl_t;
+
+        image_stream_t(std::unique_ptr<impl_t> impl,
+            BS::thread_pool<>* thread_pool);
+
+    private:
+        std::unique_ptr<impl_t> impl_;
+
+        friend class loader_t;
+    };
+
+    struct [[nodiscard]] streamed_model_t final
+    {
+        // Images of the model are single texel placeholders until replaced
+        // with images delivered by the stream
+        scene_model_t model;
+        image_stream_t images;
+    };
+
+    using mesh_progress_callback_t = std::function<
+        void(size_t mesh_index, size_t loaded_meshes, size_t total_meshes)>;
+
     class [[nodiscard]] loader_t final
     {
     public:
-        loader_t(std::span<VkFormat const> const& compressed_texture_formats);
+        // Cooked cache files are written next to the loaded models, enable
+        // it only when asset directories are writable. Loads wait for tasks
+        // they submit to the thread pool, they can't be called from tasks of
+        // the same pool.
+        explicit loader_t(
+            std::span<VkFormat const> const& compressed_texture_formats,
+            BS::thread_pool<>* thread_pool = nullptr,
+            bool use_cooked_cache = false);
 
     public:
         [[nodiscard]] std::expected<scene_model_t, std::error_code> load(
             std::filesystem::path const& path);
 
+        // Returns as soon as geometry and materials are loaded, images are
+        // decoded on the thread pool or on each poll of the stream if there
+        // is no thread pool. Cooked cache is used if it exists, but it isn't
+        // written by streaming loads.
+        [[nodiscard]] std::expected<streamed_model_t, std::error_code>
+        load_streaming(std::filesystem::path const& path,
+            mesh_progress_callback_t const& mesh_progress = {});
+
     private:
         std::vector<VkFormat> compressed_texture_formats_;
+        BS::thread_pool<>* thread_pool_;
+        bool use_cooked_cache_;
     };
 } // namespace ngnast::gltf
 
@@ -5,11 +5,13 @@
 #include <vkrndr_buffer.hpp>
 #include <vkrndr_image.hpp>
 
+#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
 #include <volk.h>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -38,6 +40,51 @@ namespace ngnast::gpu
         glm::vec4 color{1.0f};
     };
 
+    // Quantized vertex, position is relative to the bounds of the mesh and is
+    // brought back to mesh space with the dequantization matrix of the
+    // primitive. Normal and tangent directions are octahedral encoded.
+    struct [[nodiscard]] packed_vertex_t final
+    {
+        // Last component is tangent handedness, 0 for -1 and 1 for +1
+        std::array<uint16_t, 4> position;
+        std::array<int16_t, 2> normal;
+        std::array<int16_t, 2> tangent;
+        // Half precision floating point
+        std::array<uint16_t, 2> uv;
+    };
+
+    static_assert(sizeof(packed_vertex_t) == 20);
+
+    // Formats of packed_vertex_t members and of the color stream when used as
+    // vertex input attributes
+    inline constexpr VkFormat packed_position_format{
+        VK_FORMAT_R16G16B16A16_UNORM};
+    inline constexpr VkFormat packed_direction_format{VK_FORMAT_R16G16_SNORM};
+    inline constexpr VkFormat packed_uv_format{VK_FORMAT_R16G16_SFLOAT};
+    inline constexpr VkFormat packed_color_format{VK_FORMAT_R8G8B8A8_UNORM};
+
+    enum class vertex_format_t
+    {
+        full,
+        packed,
+    };
+
+    struct [[nodiscard]] geometry_transfer_options_t final
+    {
+        vertex_format_t vertex_format{vertex_format_t::full};
+
+        // Color stream of packed vertices is written only if some vertex
+        // color differs from white, unless it's required
+        bool require_color_stream{false};
+    };
+
+    struct [[nodiscard]] lod_t final
+    {
+        uint32_t count{};
+        uint32_t first{};
+        float error{};
+    };
+
     struct [[nodiscard]] primitive_t final
     {
         VkPrimitiveTopology topology{VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST};
@@ -49,13 +96,36 @@ namespace ngnast::gpu
 
         bool is_indexed{};
         int32_t vertex_offset{};
+
+        // Dequantization of packed positions, identity for full vertices
+        glm::vec3 position_offset{0.0f};
+        glm::vec3 position_scale{1.0f};
+
+        // Coarser levels of detail of indexed primitives, draws use
+        // vertex_offset of the primitive
+        std::vector<lod_t> lods;
     };
 
+    [[nodiscard]] glm::mat4 dequantization_matrix(primitive_t const& primitive);
+
+    // Returns the coarsest level of detail whose error projected to the
+    // screen doesn't exceed threshold pixels. Full detail has zero error.
+    // Pixels per unit is the size in pixels of a model space unit at the
+    // distance of the primitive.
+    [[nodiscard]] lod_t select_lod(primitive_t const& primitive,
+        float pixels_per_unit,
+        float threshold = 1.0f);
+
     struct [[nodiscard]] geometry_transfer_result_t final
     {
+        vertex_format_t vertex_format{vertex_format_t::full};
+
         vkrndr::buffer_t vertex_buffer;
         uint32_t vertex_count{};
 
+        // Vertex colors in packed_color_format, only for packed vertices
+        vkrndr::buffer_t color_buffer;
+
         vkrndr::buffer_t index_buffer;
         uint32_t index_count{};
 
@@ -65,6 +135,49 @@ namespace ngnast::gpu
     void destroy(vkrndr::device_t const& device,
         geometry_transfer_result_t const& model);
 
+    // Layout matches std430 GLSL struct, vertex_offset and triangle_offset
+    // are offsets to meshlet vertex and triangle buffers.
+    struct [[nodiscard]] meshlet_t final
+    {
+        glm::vec3 center;
+        float radius;
+        glm::vec3 cone_apex;
+        float cone_cutoff;
+        glm::vec3 cone_axis;
+        uint32_t primitive_index;
+        uint32_t vertex_offset;
+        uint32_t triangle_offset;
+        uint32_t vertex_count;
+        uint32_t triangle_count;
+    };
+
+    static_assert(sizeof(meshlet_t) == 64);
+
+    struct [[nodiscard]] meshlet_range_t final
+    {
+        uint32_t first{};
+        uint32_t count{};
+    };
+
+    struct [[nodiscard]] cluster_transfer_result_t final
+    {
+        vkrndr::buffer_t meshlet_buffer;
+        uint32_t meshlet_count{};
+
+        // Indices of vertices in the vertex buffer of transfer_geometry
+        vkrndr::buffer_t meshlet_vertex_buffer;
+
+        // Three uint8_t indices to meshlet vertices per triangle, triangles
+        // of each meshlet start at a four byte boundary
+        vkrndr::buffer_t meshlet_triangle_buffer;
+
+        // Meshlets of each primitive of the model
+        std::vector<meshlet_range_t> primitives;
+    };
+
+    void destroy(vkrndr::device_t const& device,
+        cluster_transfer_result_t const& clusters);
+
     struct [[nodiscard]] acceleration_structure_build_result_t final
     {
         vkrndr::buffer_t vertex_buffer;
@@ -86,6 +199,12 @@ namespace ngnast::gpu
         acceleration_structure_build_result_t const& structures);
 
     geometry_transfer_result_t transfer_geometry(vkrndr::device_t const& device,
+        scene_model_t const& model,
+        geometry_transfer_options_t const& options = {});
+
+    // Transfers meshlets built with mesh::build_meshlets, primitives without
+    // meshlets have an empty range
+    cluster_transfer_result_t transfer_clusters(vkrndr::device_t const& device,
         scene_model_t const& model);
 
     acceleration_structure_build_result_t build_acceleration_structures(
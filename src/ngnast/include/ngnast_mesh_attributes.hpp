@@ -0,0 +1,52 @@
+#ifndef NGNAST_MESH_ATTRIBUTES_INCLUDED
+#define NGNAST_MESH_ATTRIBUTES_INCLUDED
+
+#include <BS_thread_pool.hpp> // IWYU pragma: keep
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace ngnast
+{
+    struct primitive_t;
+    struct vertex_t;
+} // namespace ngnast
+
+namespace ngnast::mesh
+{
+    namespace detail
+    {
+        // Faces of an unindexed triangle list processed by one MikkTSpace
+        // run, in their original order. Tangents are written only for owned
+        // faces, other faces share welded corners with owned faces and are
+        // processed so that owned corners get the same results as in a
+        // single run.
+        struct [[nodiscard]] tangent_chunk_t final
+        {
+            std::vector<uint32_t> faces;
+            uint32_t first_owned{};
+            uint32_t last_owned{};
+        };
+
+        // Splits faces to consecutive owned ranges, one per thread. Returns
+        // no chunks when the triangle list is too small to be split.
+        [[nodiscard]] std::vector<tangent_chunk_t> split_to_tangent_chunks(
+            std::span<vertex_t const> vertices,
+            size_t thread_count);
+    } // namespace detail
+
+    // Assigns face normals of triangles to their vertices, vertices shared
+    // between faces take the normal of the last face. Faces are processed
+    // in SIMD lanes when the target supports SSE2 or AVX2.
+    void calculate_normals(primitive_t& primitive);
+
+    // Calculates MikkTSpace tangents of an unindexed triangle list. Ranges
+    // of triangles are processed in parallel when a thread pool is given,
+    // results match a single run up to floating point rounding.
+    [[nodiscard]] bool calculate_tangents(primitive_t& primitive,
+        BS::thread_pool<>* thread_pool = nullptr);
+} // namespace ngnast::mesh
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef NGNAST_MESH_TRANSFORM_INCLUDED
 #define NGNAST_MESH_TRANSFORM_INCLUDED
 
+#include <cstddef>
+
 namespace ngnast
 {
     struct primitive_t;
@@ -8,9 +10,42 @@ namespace ngnast
 
 namespace ngnast::mesh
 {
+    struct [[nodiscard]] meshlet_options_t final
+    {
+        size_t max_vertices{64};
+        size_t max_triangles{124};
+        // Trades spatial locality of meshlets for tighter normal cones
+        float cone_weight{0.25f};
+    };
+
+    struct [[nodiscard]] lod_options_t final
+    {
+        size_t max_lods{4};
+        // Target index count of each level relative to the previous level
+        float reduction{0.5f};
+        // Largest allowed error of a level relative to the mesh extents
+        float max_error{0.05f};
+    };
+
     bool make_unindexed(primitive_t& primitive);
 
     bool make_indexed(primitive_t& primitive);
+
+    // Reorders indices for vertex cache and overdraw efficiency and vertices
+    // for vertex fetch efficiency, only indexed triangle lists are optimized
+    bool optimize(primitive_t& primitive);
+
+    // Splits indexed triangle lists into meshlets with bounding spheres and
+    // normal cones, previously built meshlets are replaced
+    bool build_meshlets(primitive_t& primitive,
+        meshlet_options_t const& options = {});
+
+    // Generates levels of detail of indexed triangle lists by simplifying
+    // each level from the previous one, stops when simplification can't
+    // reach the target without exceeding the error. Attribute seams are
+    // preserved, previously generated levels are replaced.
+    bool generate_lods(primitive_t& primitive,
+        lod_options_t const& options = {});
 } // namespace ngnast::mesh
 
 #endif
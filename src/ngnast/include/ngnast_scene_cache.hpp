@@ -0,0 +1,47 @@
+#ifndef NGNAST_SCENE_CACHE_INCLUDED
+#define NGNAST_SCENE_CACHE_INCLUDED
+
+#include <ngnast_scene_model.hpp>
+
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <system_error>
+
+namespace ngnast::cache
+{
+    // Content hash of the source asset and of every option that affects the
+    // result of loading it.
+    using cache_key_t = std::array<unsigned char, 16>;
+
+    // External file referenced by the source asset. Cooked data is considered
+    // stale if any of the dependencies changed after it was written.
+    struct [[nodiscard]] dependency_t final
+    {
+        std::filesystem::path path;
+        uintmax_t size{};
+        int64_t last_write_time{};
+    };
+
+    [[nodiscard]] std::expected<dependency_t, std::error_code> make_dependency(
+        std::filesystem::path const& path);
+
+    [[nodiscard]] std::filesystem::path cooked_path(
+        std::filesystem::path const& source);
+
+    // Parses the cooked file into a model which owns all of its data, the
+    // file is mapped only while reading. Files with indices outside of the
+    // sections they refer to are rejected as parse failures.
+    [[nodiscard]] std::expected<scene_model_t, std::error_code>
+    read(std::filesystem::path const& cooked, cache_key_t const& key);
+
+    [[nodiscard]] std::expected<void, std::error_code> write(
+        std::filesystem::path const& cooked,
+        cache_key_t const& key,
+        std::span<dependency_t const> const& dependencies,
+        scene_model_t const& model);
+} // namespace ngnast::cache
+
+#endif
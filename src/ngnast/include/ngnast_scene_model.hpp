@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <ranges>
 #include <string>
@@ -34,6 +35,49 @@ namespace ngnast
     bounding_box_t calculate_aabb(bounding_box_t const& box,
         glm::mat4 const& matrix);
 
+    struct [[nodiscard]] arena_statistics_t final
+    {
+        // Blocks requested by the arena from the global heap
+        size_t allocations{};
+        size_t allocated_bytes{};
+    };
+
+    // Monotonic memory resource owned by a scene model. Names, geometry and
+    // index lists of the model are allocated from it and released at once
+    // with the model. Storage released by containers is reclaimed only when
+    // the arena is destroyed, containers which are rebuilt repeatedly should
+    // use a different resource.
+    class [[nodiscard]] arena_t final
+    {
+    public:
+        arena_t();
+
+        arena_t(arena_t const&) = delete;
+
+        arena_t(arena_t&& other) noexcept;
+
+    public:
+        ~arena_t();
+
+    public:
+        // Default resource if the arena was moved from
+        [[nodiscard]] std::pmr::memory_resource* resource() const;
+
+        [[nodiscard]] arena_statistics_t statistics() const;
+
+    public:
+        arena_t& operator=(arena_t const&) = delete;
+
+        // Arenas are exchanged, storage of the assigned to arena is released
+        // when the moved from arena is destroyed. Owner of the arena can then
+        // release its containers after the arena is assigned.
+        arena_t& operator=(arena_t&& other) noexcept;
+
+    private:
+        struct impl_t;
+        std::unique_ptr<impl_t> impl_;
+    };
+
     struct [[nodiscard]] vertex_t final
     {
         glm::vec3 position{};
@@ -52,8 +96,8 @@ namespace ngnast
     // NOLINTNEXTLINE(bugprone-exception-escape)
     struct [[nodiscard]] texture_t final
     {
-        std::string name;
-        std::map<texture_image_type_t, size_t> image_indices;
+        std::pmr::string name;
+        std::pmr::map<texture_image_type_t, size_t> image_indices;
         size_t sampler_index;
     };
 
@@ -75,7 +119,7 @@ namespace ngnast
 
     struct [[nodiscard]] material_t final
     {
-        std::string name;
+        std::pmr::string name;
         pbr_metallic_roughness_t pbr_metallic_roughness;
         texture_t* normal_texture{};
         texture_t* emissive_texture{};
@@ -89,28 +133,63 @@ namespace ngnast
         bool double_sided{false};
     };
 
+    struct [[nodiscard]] meshlet_t final
+    {
+        uint32_t vertex_offset{};
+        uint32_t triangle_offset{};
+        uint32_t vertex_count{};
+        uint32_t triangle_count{};
+
+        glm::vec3 center{};
+        float radius{};
+
+        // Meshlet is backfacing when viewed from camera position if
+        // dot(normalize(cone_apex - camera), cone_axis) >= cone_cutoff
+        glm::vec3 cone_apex{};
+        glm::vec3 cone_axis{};
+        float cone_cutoff{};
+    };
+
+    struct [[nodiscard]] lod_t final
+    {
+        std::pmr::vector<unsigned int> indices;
+        // Distance between the simplified and the full detail surface, in
+        // model space
+        float error{};
+    };
+
     struct [[nodiscard]] primitive_t final
     {
         VkPrimitiveTopology topology{VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST};
 
-        std::vector<vertex_t> vertices;
-        std::vector<unsigned int> indices;
+        std::pmr::vector<vertex_t> vertices;
+        std::pmr::vector<unsigned int> indices;
 
         std::optional<size_t> material_index;
 
         bounding_box_t bounding_box;
+
+        // Empty unless built with mesh::build_meshlets. Meshlet vertices
+        // index into vertices, meshlet triangles index into meshlet vertices.
+        std::pmr::vector<meshlet_t> meshlets;
+        std::pmr::vector<unsigned int> meshlet_vertices;
+        std::pmr::vector<uint8_t> meshlet_triangles;
+
+        // Progressively coarser levels of detail, empty unless generated with
+        // mesh::generate_lods. Full detail level are indices.
+        std::pmr::vector<lod_t> lods;
     };
 
     struct [[nodiscard]] mesh_t final
     {
-        std::string name;
-        std::vector<size_t> primitive_indices;
+        std::pmr::string name;
+        std::pmr::vector<size_t> primitive_indices;
         bounding_box_t bounding_box;
     };
 
     struct [[nodiscard]] node_t final
     {
-        std::string name;
+        std::pmr::string name;
 
         std::optional<size_t> mesh_index;
 
@@ -118,7 +197,7 @@ namespace ngnast
 
         bounding_box_t aabb;
 
-        std::vector<size_t> child_indices;
+        std::pmr::vector<size_t> child_indices;
 
         [[nodiscard]] constexpr auto children(scene_model_t& model);
 
@@ -127,9 +206,9 @@ namespace ngnast
 
     struct [[nodiscard]] scene_graph_t final
     {
-        std::string name;
+        std::pmr::string name;
 
-        std::vector<size_t> root_indices;
+        std::pmr::vector<size_t> root_indices;
 
         [[nodiscard]] constexpr auto roots(scene_model_t& model);
 
@@ -153,6 +232,9 @@ namespace ngnast
 
     struct [[nodiscard]] scene_model_t final
     {
+        // Declared first so that it outlives the containers allocated from it
+        arena_t arena;
+
         std::vector<image_t> images;
         std::vector<vkrndr::sampler_properties_t> samplers;
 
@@ -0,0 +1,73 @@
+#ifndef NGNAST_TRANSFORM_HIERARCHY_INCLUDED
+#define NGNAST_TRANSFORM_HIERARCHY_INCLUDED
+
+#include <BS_thread_pool.hpp> // IWYU pragma: keep
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// IWYU pragma: no_include <glm/detail/qualifier.hpp>
+
+namespace ngnast
+{
+    struct scene_model_t;
+} // namespace ngnast
+
+namespace ngnast
+{
+    // Node hierarchy of a scene model flattened into parallel arrays. Nodes
+    // are stored in depth first order, parents precede their children and
+    // each subtree occupies a contiguous range of positions starting at its
+    // root.
+    struct [[nodiscard]] transform_hierarchy_t final
+    {
+        static constexpr uint32_t no_parent{
+            std::numeric_limits<uint32_t>::max()};
+        static constexpr uint32_t no_position{
+            std::numeric_limits<uint32_t>::max()};
+
+        // Position of the parent of each node or no_parent for roots
+        std::vector<uint32_t> parents;
+        // Number of nodes in the subtree rooted at each node, including the
+        // node itself
+        std::vector<uint32_t> subtree_sizes;
+        // Index of each node in the scene model
+        std::vector<size_t> node_indices;
+        // Position of each node of the scene model, no_position for nodes
+        // which aren't part of any scene
+        std::vector<uint32_t> positions;
+
+        std::vector<glm::mat4> local_matrices;
+        std::vector<glm::mat4> world_matrices;
+        // Nodes whose local matrix changed since the last update
+        std::vector<uint8_t> dirty;
+    };
+
+    // Nodes shared between scenes are stored once. Local matrices are taken
+    // from the model and all nodes are marked dirty.
+    [[nodiscard]] transform_hierarchy_t flatten_hierarchy(
+        scene_model_t const& model);
+
+    void set_local_matrix(transform_hierarchy_t& hierarchy,
+        uint32_t position,
+        glm::mat4 const& matrix);
+
+    // Recalculates world matrices of dirty nodes and their descendants in a
+    // single pass over the arrays and clears the dirty flags. Subtrees are
+    // processed in parallel when a thread pool is given, small consecutive
+    // subtrees are processed by the same task.
+    void update_world_matrices(transform_hierarchy_t& hierarchy,
+        BS::thread_pool<>* thread_pool = nullptr);
+
+    // Recalculates world matrices of the subtree rooted at position with the
+    // given world matrix of the root, dirty flags are ignored
+    void update_world_matrices(transform_hierarchy_t& hierarchy,
+        uint32_t position,
+        glm::mat4 const& root_matrix);
+} // namespace ngnast
+
+#endif
@@ -28,6 +28,8 @@ namespace
                 return "export failed";
             case ngnast::error_t::load_transform_failed:
                 return "load transformation failed";
+            case ngnast::error_t::cache_mismatch:
+                return "cached data is out of date";
             case ngnast::error_t::unknown:
                 return "unknown";
             default:
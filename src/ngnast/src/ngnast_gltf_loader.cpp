@@ -2,16 +2,22 @@
 
 #include <ngnast_error.hpp>
 #include <ngnast_gltf_fastgltf_adapter.hpp>
+#include <ngnast_mesh_attributes.hpp>
 #include <ngnast_mesh_transform.hpp>
+#include <ngnast_scene_cache.hpp>
 #include <ngnast_scene_model.hpp>
 
+#include <cppext_mapped_file.hpp>
 #include <cppext_numeric.hpp>
 #include <cppext_overloaded.hpp>
-#include <cppext_read_file.hpp>
 
 #include <vkrndr_sampler.hpp>
 #include <vkrndr_utility.hpp>
 
+#include <BS_thread_pool.hpp>
+
+#include <boost/hash2/md5.hpp>
+
 #include <fastgltf/core.hpp>
 #include <fastgltf/glm_element_traits.hpp> // IWYU pragma: keep
 #include <fastgltf/tools.hpp>
@@ -19,17 +25,12 @@
 
 #include <glm/common.hpp>
 #include <glm/geometric.hpp>
-#include <glm/gtc/type_ptr.hpp>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 
 #include <libbasisu/transcoder/basisu_transcoder.h>
 
-#include <meshoptimizer.h>
-
-#include <mikktspace.h>
-
 #include <spdlog/spdlog.h>
 
 #include <stb_image.h>
@@ -39,14 +40,20 @@
 #include <vulkan/utility/vk_format_utils.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception> // IWYU pragma: keep
 #include <expected>
+#include <filesystem>
+#include <future>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <numeric>
 #include <optional>
 #include <ranges>
@@ -59,6 +66,7 @@
 #include <variant>
 #include <vector>
 
+// IWYU pragma: no_include <boost/hash2/digest.hpp>
 // IWYU pragma: no_include <fastgltf/math.hpp>
 // IWYU pragma: no_include <fastgltf/util.hpp>
 // IWYU pragma: no_include <fmt/base.h>
@@ -213,125 +221,6 @@ namespace
     constexpr auto texcoord_0_attribute{"TEXCOORD_0"};
     constexpr auto color_attribute{"COLOR_0"};
 
-    void calculate_normals(ngnast::primitive_t& primitive)
-    {
-        bool const is_indexed{!primitive.indices.empty()};
-
-        auto& vertices{primitive.vertices};
-        auto const& indices{primitive.indices};
-
-        size_t const vertex_count{
-            is_indexed ? primitive.indices.size() : primitive.vertices.size()};
-        for (size_t i{}; i != vertex_count; i += 3)
-        {
-            auto& point1{is_indexed ? vertices[indices[i]] : vertices[i]};
-            auto& point2{
-                is_indexed ? vertices[indices[i + 1]] : vertices[i + 1]};
-            auto& point3{
-                is_indexed ? vertices[indices[i + 2]] : vertices[i + 2]};
-
-            glm::vec3 const edge1{point2.position - point1.position};
-            glm::vec3 const edge2{point3.position - point1.position};
-
-            // https://stackoverflow.com/a/57812028
-            glm::vec3 const face_normal{
-                glm::normalize(glm::cross(edge1, edge2))};
-            point1.normal = face_normal;
-            point2.normal = face_normal;
-            point3.normal = face_normal;
-        }
-
-        for (auto& vertex : primitive.vertices)
-        {
-            vertex.normal = glm::normalize(vertex.normal);
-        }
-    }
-
-    [[nodiscard]] bool calculate_tangents(ngnast::primitive_t& primitive)
-    {
-        auto const get_num_faces = [](SMikkTSpaceContext const* context) -> int
-        {
-            auto* const v{static_cast<std::vector<ngnast::vertex_t>*>(
-                context->m_pUserData)};
-
-            return cppext::narrow<int>(v->size() / 3);
-        };
-
-        auto const get_num_vertices_of_face =
-            []([[maybe_unused]] SMikkTSpaceContext const* context,
-                [[maybe_unused]] int const face) -> int { return 3; };
-
-        auto const get_position = [](SMikkTSpaceContext const* context,
-                                      float* const out,
-                                      int const face,
-                                      int const vertex)
-        {
-            auto const& v{*static_cast<std::vector<ngnast::vertex_t>*>(
-                context->m_pUserData)};
-
-            std::copy_n(
-                glm::value_ptr(
-                    v[cppext::narrow<size_t>(face * 3 + vertex)].position),
-                3,
-                out);
-        };
-
-        auto const get_normal = [](SMikkTSpaceContext const* context,
-                                    float* const out,
-                                    int const face,
-                                    int const vertex)
-        {
-            auto const& v{*static_cast<std::vector<ngnast::vertex_t>*>(
-                context->m_pUserData)};
-
-            std::copy_n(
-                glm::value_ptr(
-                    v[cppext::narrow<size_t>(face * 3 + vertex)].normal),
-                3,
-                out);
-        };
-
-        auto const get_uv = [](SMikkTSpaceContext const* context,
-                                float* const out,
-                                int const face,
-                                int const vertex)
-        {
-            auto const& v{*static_cast<std::vector<ngnast::vertex_t>*>(
-                context->m_pUserData)};
-
-            std::copy_n(
-                glm::value_ptr(v[cppext::narrow<size_t>(face * 3 + vertex)].uv),
-                2,
-                out);
-        };
-
-        auto const set_tangent = [](SMikkTSpaceContext const* context,
-                                     float const* const tangent,
-                                     float const sign,
-                                     int const face,
-                                     int const vertex)
-        {
-            auto& v{*static_cast<std::vector<ngnast::vertex_t>*>(
-                context->m_pUserData)};
-
-            v[cppext::narrow<size_t>(face * 3 + vertex)].tangent =
-                glm::vec4{tangent[0], tangent[1], tangent[2], -sign};
-        };
-
-        SMikkTSpaceInterface interface{.m_getNumFaces = get_num_faces,
-            .m_getNumVerticesOfFace = get_num_vertices_of_face,
-            .m_getPosition = get_position,
-            .m_getNormal = get_normal,
-            .m_getTexCoord = get_uv,
-            .m_setTSpaceBasic = set_tangent,
-            .m_setTSpace = nullptr};
-
-        SMikkTSpaceContext const context{.m_pInterface = &interface,
-            .m_pUserData = &primitive.vertices};
-
-        return static_cast<bool>(genTangSpaceDefault(&context));
-    }
-
     template<typename T>
     [[nodiscard]] std::optional<uint32_t> copy_attribute(
         fastgltf::Asset const& asset,
@@ -545,6 +434,9 @@ namespace
                 }
             }
 
+            cppext::mapped_file_t file{path};
+            file.advise(cppext::access_hint_t::sequential);
+
             switch (effective_mime_type)
             {
             case fastgltf::MimeType::KTX2:
@@ -557,15 +449,17 @@ namespace
                         ngnast::error_t::load_transform_failed)};
                 }
 
-                std::vector<char> raw_bytes{cppext::read_file(path)};
-                return load_ktx_image(*format, raw_bytes);
+                return load_ktx_image(*format, file.chars());
             }
             default:
             {
                 int width; // NOLINT
                 int height; // NOLINT
                 int channels; // NOLINT
-                stbi_uc* const data{stbi_load(path.string().c_str(),
+                stbi_uc* const data{stbi_load_from_memory(
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                    reinterpret_cast<stbi_uc const*>(file.bytes().data()),
+                    cppext::narrow<int>(file.size()),
                     &width,
                     &height,
                     &channels,
@@ -588,9 +482,19 @@ namespace
             return std::unexpected{make_error_code(ngnast::error_t::unknown)};
         };
 
+        auto const load_from_byte_view =
+            [&load_from_container](fastgltf::MimeType const mime_type,
+                fastgltf::sources::ByteView const& container,
+                size_t const offset,
+                size_t const size)
+        { return load_from_container(mime_type, container, offset, size); };
+
         auto const load_from_buffer_view =
-            [&unsupported_variant, load_from_array, load_from_vector, &asset](
-                fastgltf::sources::BufferView const& view)
+            [&unsupported_variant,
+                load_from_array,
+                load_from_vector,
+                load_from_byte_view,
+                &asset](fastgltf::sources::BufferView const& view)
         {
             auto const& bufferView = asset.bufferViews[view.bufferViewIndex];
             auto const& buffer = asset.buffers[bufferView.bufferIndex];
@@ -607,6 +511,12 @@ namespace
                         &load_from_vector](
                         fastgltf::sources::Vector const& vector)
                     { return load_from_vector(mt, vector, off, size); },
+                    [mt = view.mimeType,
+                        off = bufferView.byteOffset,
+                        size = bufferView.byteLength,
+                        &load_from_byte_view](
+                        fastgltf::sources::ByteView const& byte_view)
+                    { return load_from_byte_view(mt, byte_view, off, size); },
                     unsupported_variant},
                 buffer.data);
         };
@@ -636,17 +546,51 @@ namespace
         std::filesystem::path const& parent_path,
         std::set<size_t> const& unorm_images,
         fastgltf::Asset const& asset,
+        BS::thread_pool<>* const thread_pool,
         ngnast::scene_model_t& model)
     {
-        for (size_t i{}; i != asset.images.size(); ++i)
+        auto const load_at = [&](size_t const i)
         {
-            auto const& image{asset.images[i]};
-
-            auto load_result{load_image(compressed_texture_formats,
+            return load_image(compressed_texture_formats,
                 parent_path,
                 unorm_images.contains(i),
                 asset,
-                image)};
+                asset.images[i]);
+        };
+
+        model.images.reserve(asset.images.size());
+
+        // Decoding of an image doesn't depend on any other image, each one
+        // can be decoded independently on a worker thread. Results are
+        // collected in the order of images in the asset.
+        if (thread_pool && thread_pool->get_thread_count() > 1)
+        {
+            BS::multi_future<std::expected<ngnast::image_t, std::error_code>>
+                futures{thread_pool->submit_sequence(size_t{},
+                    asset.images.size(),
+                    load_at)};
+
+            // Tasks reference local state, all of them have to be finished
+            // before results are inspected as inspection may throw
+            futures.wait();
+
+            for (auto& future : futures)
+            {
+                auto load_result{future.get()};
+                if (!load_result)
+                {
+                    throw std::system_error{load_result.error()};
+                }
+
+                model.images.push_back(std::move(load_result).value());
+            }
+
+            return;
+        }
+
+        for (size_t i{}; i != asset.images.size(); ++i)
+        {
+            auto load_result{load_at(i)};
             if (!load_result)
             {
                 throw std::system_error{load_result.error()};
@@ -656,6 +600,70 @@ namespace
         }
     }
 
+    [[nodiscard]] ngnast::image_t placeholder_image(
+        std::array<std::byte, 4> const& texel,
+        bool const as_unorm)
+    {
+        ngnast::image_t rv{
+            .data = std::unique_ptr<std::byte[], void (*)(std::byte*)>{
+                // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+                new std::byte[texel.size()],
+                [](std::byte* const p)
+                {
+                    delete[] p; // NOLINT(cppcoreguidelines-owning-memory)
+                }},
+            .data_size = texel.size(),
+            .format =
+                as_unorm ? VK_FORMAT_R8G8B8A8_UNORM : VK_FORMAT_R8G8B8A8_SRGB,
+            .mip_levels = std::vector{ngnast::image_mip_level_t{
+                .extent = {1, 1},
+                .data_offset = 0,
+                .data_size = texel.size()}}};
+
+        std::ranges::copy(texel, rv.data.get());
+
+        return rv;
+    }
+
+    // Images used while full resolution images are being decoded. Normal
+    // maps get a flat normal, every other image is white so that material
+    // factors are used as they are.
+    void load_placeholder_images(std::set<size_t> const& unorm_images,
+        size_t const image_count,
+        ngnast::scene_model_t& model)
+    {
+        static constexpr std::array white{std::byte{255},
+            std::byte{255},
+            std::byte{255},
+            std::byte{255}};
+        static constexpr std::array flat_normal{std::byte{128},
+            std::byte{128},
+            std::byte{255},
+            std::byte{255}};
+
+        std::set<size_t> normal_images;
+        for (ngnast::material_t const& material : model.materials)
+        {
+            if (material.normal_texture)
+            {
+                for (auto const& [type, index] :
+                    material.normal_texture->image_indices)
+                {
+                    normal_images.emplace(index);
+                }
+            }
+        }
+
+        model.images.reserve(image_count);
+        for (size_t i{}; i != image_count; ++i)
+        {
+            model.images.push_back(
+                placeholder_image(normal_images.contains(i) ? flat_normal
+                                                            : white,
+                    unorm_images.contains(i)));
+        }
+    }
+
     void load_samplers(fastgltf::Asset const& asset,
         ngnast::scene_model_t& model)
     {
@@ -671,9 +679,13 @@ namespace
     void load_textures(fastgltf::Asset const& asset,
         ngnast::scene_model_t& model)
     {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
         for (fastgltf::Texture const& texture : asset.textures)
         {
-            ngnast::texture_t t{.name = std::string{texture.name}};
+            ngnast::texture_t t{
+                .name{std::string_view{texture.name}, resource},
+                .image_indices{resource}};
 
             if (texture.imageIndex)
             {
@@ -697,10 +709,13 @@ namespace
     [[nodiscard]] std::set<size_t> load_materials(fastgltf::Asset const& asset,
         ngnast::scene_model_t& model)
     {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
         std::set<size_t> unorm_images;
         for (fastgltf::Material const& material : asset.materials)
         {
-            ngnast::material_t m{.name = std::string{material.name},
+            ngnast::material_t m{
+                .name{std::string_view{material.name}, resource},
                 .alpha_mode = ngnast::gltf::to_alpha_mode(material.alphaMode),
                 .alpha_cutoff = material.alphaCutoff,
                 .double_sided = material.doubleSided};
@@ -764,9 +779,12 @@ namespace
     [[nodiscard]] std::expected<ngnast::mesh_t, std::error_code> load_mesh(
         fastgltf::Asset const& asset,
         fastgltf::Mesh const& mesh,
+        BS::thread_pool<>* const thread_pool,
+        std::pmr::memory_resource* const resource,
         std::vector<ngnast::primitive_t>& primitives)
     {
-        ngnast::mesh_t rv{.name = std::string{mesh.name}};
+        ngnast::mesh_t rv{.name{std::string_view{mesh.name}, resource},
+            .primitive_indices{resource}};
         rv.primitive_indices.reserve(mesh.primitives.size());
 
         assert(!mesh.primitives.empty());
@@ -892,14 +910,14 @@ namespace
 
             if (!normals_loaded)
             {
-                calculate_normals(p);
+                ngnast::mesh::calculate_normals(p);
             }
 
             if (!tangents_loaded)
             {
                 bool const was_indexed{ngnast::mesh::make_unindexed(p)};
 
-                if (!calculate_tangents(p))
+                if (!ngnast::mesh::calculate_tangents(p, thread_pool))
                 {
                     spdlog::error("Tangent calculation in {} mesh failed",
                         rv.name);
@@ -914,33 +932,25 @@ namespace
                 }
             }
 
-            meshopt_optimizeVertexCache(p.indices.data(),
-                p.indices.data(),
-                p.indices.size(),
-                p.vertices.size());
-
-            meshopt_optimizeOverdraw(p.indices.data(),
-                p.indices.data(),
-                p.indices.size(),
-                &p.vertices[0].position[0],
-                p.vertices.size(),
-                sizeof(ngnast::vertex_t),
-                1.05f);
-
-            meshopt_optimizeVertexFetch(p.vertices.data(),
-                p.indices.data(),
-                p.indices.size(),
-                p.vertices.data(),
-                p.vertices.size(),
-                sizeof(ngnast::vertex_t));
+            ngnast::mesh::optimize(p);
 
             if (primitive.materialIndex)
             {
                 p.material_index = *primitive.materialIndex;
             }
 
+            // Geometry is processed in scratch storage, transformations
+            // reallocate it. Only the final buffers are copied to the arena.
             rv.primitive_indices.push_back(primitives.size());
-            primitives.push_back(std::move(p));
+            primitives.push_back({.topology = p.topology,
+                .vertices{p.vertices, resource},
+                .indices{p.indices, resource},
+                .material_index = p.material_index,
+                .bounding_box = p.bounding_box,
+                .meshlets{resource},
+                .meshlet_vertices{resource},
+                .meshlet_triangles{resource},
+                .lods{resource}});
         }
 
         rv.bounding_box = primitives[rv.primitive_indices.front()].bounding_box;
@@ -957,25 +967,34 @@ namespace
         return rv;
     }
 
-    [[nodiscard]] std::vector<ngnast::mesh_t> load_meshes(
-        fastgltf::Asset const& asset,
-        std::vector<ngnast::primitive_t>& primitives)
+    void load_meshes(fastgltf::Asset const& asset,
+        BS::thread_pool<>* const thread_pool,
+        ngnast::gltf::mesh_progress_callback_t const& mesh_progress,
+        ngnast::scene_model_t& model)
     {
-        std::vector<ngnast::mesh_t> rv;
-        rv.reserve(asset.meshes.size());
+        model.meshes.reserve(asset.meshes.size());
 
         for (fastgltf::Mesh const& mesh : asset.meshes)
         {
-            auto load_result{load_mesh(asset, mesh, primitives)};
+            auto load_result{load_mesh(asset,
+                mesh,
+                thread_pool,
+                model.arena.resource(),
+                model.primitives)};
             if (!load_result)
             {
                 throw std::system_error{load_result.error()};
             }
 
-            rv.push_back(std::move(*load_result));
-        }
+            model.meshes.push_back(std::move(*load_result));
 
-        return rv;
+            if (mesh_progress)
+            {
+                mesh_progress(model.meshes.size() - 1,
+                    model.meshes.size(),
+                    asset.meshes.size());
+            }
+        }
     }
 
     void load_node(fastgltf::Asset const& asset,
@@ -984,7 +1003,10 @@ namespace
     {
         fastgltf::Node const& node{asset.nodes[node_index]};
 
-        ngnast::node_t n{.name = std::string{node.name}};
+        // Nodes are filled in place, move assignment would copy arena
+        // allocated members to the allocator of the placeholder node
+        ngnast::node_t& n{model.nodes[node_index]};
+        n.name = std::string_view{node.name};
 
         if (node.meshIndex)
         {
@@ -996,26 +1018,38 @@ namespace
 
         n.matrix = ngnast::gltf::to_glm(fastgltf::getTransformMatrix(node));
 
-        n.child_indices.reserve(node.children.size());
-        std::ranges::copy(node.children, std::back_inserter(n.child_indices));
+        n.child_indices.assign(node.children.cbegin(), node.children.cend());
 
         for (size_t const i : n.child_indices)
         {
             load_node(asset, i, model);
         }
+    }
+
+    void allocate_nodes(fastgltf::Asset const& asset,
+        ngnast::scene_model_t& model)
+    {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
 
-        model.nodes[node_index] = std::move(n);
+        model.nodes.reserve(asset.nodes.size());
+        for (size_t i{}; i != asset.nodes.size(); ++i)
+        {
+            model.nodes.push_back(
+                {.name{resource}, .child_indices{resource}});
+        }
     }
 
     void load_scenes(fastgltf::Asset const& asset, ngnast::scene_model_t& model)
     {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
         for (fastgltf::Scene const& scene : asset.scenes)
         {
-            ngnast::scene_graph_t s{.name = std::string{scene.name}};
-
-            s.root_indices.reserve(scene.nodeIndices.size());
-            std::ranges::copy(scene.nodeIndices,
-                std::back_inserter(s.root_indices));
+            ngnast::scene_graph_t s{
+                .name{std::string_view{scene.name}, resource},
+                .root_indices{scene.nodeIndices.cbegin(),
+                    scene.nodeIndices.cend(),
+                    resource}};
 
             model.scenes.push_back(std::move(s));
 
@@ -1025,12 +1059,260 @@ namespace
             }
         }
     }
+
+    // External buffers are mapped to memory instead of being read by the
+    // parser. Buffers of the asset reference mapped contents, returned files
+    // have to outlive any access to buffer data.
+    [[nodiscard]] std::vector<cppext::mapped_file_t> map_external_buffers(
+        std::filesystem::path const& parent_path,
+        fastgltf::Asset& asset)
+    {
+        std::vector<cppext::mapped_file_t> rv;
+        rv.reserve(asset.buffers.size());
+
+        for (fastgltf::Buffer& buffer : asset.buffers)
+        {
+            auto const* const uri{
+                std::get_if<fastgltf::sources::URI>(&buffer.data)};
+            if (!uri || !uri->uri.isLocalPath())
+            {
+                continue;
+            }
+
+            std::filesystem::path path{uri->uri.fspath()};
+            if (path.is_relative())
+            {
+                path = parent_path / path;
+            }
+
+            cppext::mapped_file_t& file{rv.emplace_back(path)};
+            if (uri->fileByteOffset > file.size() ||
+                buffer.byteLength > file.size() - uri->fileByteOffset)
+            {
+                throw std::system_error{
+                    make_error_code(ngnast::error_t::invalid_file)};
+            }
+
+            // Vertex data is read through accessors in the order of meshes,
+            // which doesn't follow the layout of the buffer
+            file.advise(cppext::access_hint_t::will_need);
+
+            std::span<std::byte const> const bytes{
+                file.bytes().subspan(uri->fileByteOffset, buffer.byteLength)};
+            buffer.data = fastgltf::sources::ByteView{
+                .bytes = {bytes.data(), bytes.size()},
+                .mimeType = uri->mimeType};
+        }
+
+        return rv;
+    }
+
+    [[nodiscard]] fastgltf::Parser create_parser()
+    {
+        return fastgltf::Parser{
+            fastgltf::Extensions::KHR_materials_emissive_strength |
+            fastgltf::Extensions::KHR_texture_basisu};
+    }
+
+    [[nodiscard]] std::expected<ngnast::cache::cache_key_t, std::error_code>
+    calculate_cache_key(std::filesystem::path const& path,
+        std::span<VkFormat const> const& compressed_texture_formats)
+    {
+        cppext::mapped_file_t file;
+        try
+        {
+            file = cppext::mapped_file_t{path};
+        }
+        catch (std::system_error const& ex)
+        {
+            return std::unexpected{ex.code()};
+        }
+        file.advise(cppext::access_hint_t::sequential);
+
+        boost::hash2::md5_128 hash;
+        hash.update(file.bytes().data(), file.size());
+
+        // Selected compressed formats change the result of KTX2 transcoding
+        hash.update(compressed_texture_formats.data(),
+            compressed_texture_formats.size_bytes());
+
+        ngnast::cache::cache_key_t rv{};
+        std::ranges::copy(hash.result(), rv.begin());
+        return rv;
+    }
+
+    // External buffers are replaced with their contents when the asset is
+    // loaded, URIs of the referenced files are taken from an asset which is
+    // only parsed.
+    [[nodiscard]] std::expected<std::vector<ngnast::cache::dependency_t>,
+        std::error_code>
+    collect_dependencies(std::filesystem::path const& path)
+    {
+        auto data{fastgltf::GltfDataBuffer::FromPath(path)};
+        if (data.error() != fastgltf::Error::None)
+        {
+            return std::unexpected{make_error_code(
+                ngnast::gltf::translate_error(data.error()))};
+        }
+
+        auto const parent_path{path.parent_path()};
+
+        fastgltf::Parser parser{create_parser()};
+        auto asset{
+            parser.loadGltf(data.get(), parent_path, fastgltf::Options::None)};
+        if (asset.error() != fastgltf::Error::None)
+        {
+            return std::unexpected{make_error_code(
+                ngnast::gltf::translate_error(asset.error()))};
+        }
+
+        std::vector<ngnast::cache::dependency_t> rv;
+        std::error_code ec;
+        auto const add_dependency =
+            [&parent_path, &rv, &ec](fastgltf::DataSource const& source)
+        {
+            auto const* const uri{std::get_if<fastgltf::sources::URI>(&source)};
+            if (ec || !uri || !uri->uri.isLocalPath())
+            {
+                return;
+            }
+
+            std::filesystem::path dependency{uri->uri.fspath()};
+            if (dependency.is_relative())
+            {
+                dependency = parent_path / dependency;
+            }
+
+            if (auto d{ngnast::cache::make_dependency(dependency)})
+            {
+                rv.push_back(std::move(d).value());
+            }
+            else
+            {
+                ec = d.error();
+            }
+        };
+
+        for (fastgltf::Buffer const& buffer : asset->buffers)
+        {
+            add_dependency(buffer.data);
+        }
+
+        for (fastgltf::Image const& image : asset->images)
+        {
+            add_dependency(image.data);
+        }
+
+        if (ec)
+        {
+            return std::unexpected{ec};
+        }
+
+        return rv;
+    }
+
+    [[nodiscard]] std::expected<void, std::error_code> check_source_file(
+        std::filesystem::path const& path)
+    {
+        std::error_code ec;
+        if (auto const file_exists{exists(path, ec)}; !file_exists || ec)
+        {
+            return std::unexpected{
+                ec ? ec : make_error_code(ngnast::error_t::invalid_file)};
+        }
+
+        if (auto const regular_file{is_regular_file(path, ec)};
+            !regular_file || ec)
+        {
+            return std::unexpected{
+                ec ? ec : make_error_code(ngnast::error_t::invalid_file)};
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] std::expected<fastgltf::Asset, std::error_code> parse_asset(
+        std::filesystem::path const& path,
+        std::filesystem::path const& parent_path)
+    {
+        fastgltf::Parser parser{create_parser()};
+
+        auto data{fastgltf::GltfDataBuffer::FromPath(path)};
+        if (data.error() != fastgltf::Error::None)
+        {
+            spdlog::error("Failed to create data buffer: {}", data.error());
+            return std::unexpected{make_error_code(
+                ngnast::gltf::translate_error(data.error()))};
+        }
+
+        auto asset{
+            parser.loadGltf(data.get(), parent_path, fastgltf::Options::None)};
+        if (asset.error() != fastgltf::Error::None)
+        {
+            spdlog::error("Failed to load asset: {}", asset.error());
+            return std::unexpected{make_error_code(
+                ngnast::gltf::translate_error(data.error()))};
+        }
+
+        return std::move(asset.get());
+    }
+
+    [[nodiscard]] std::expected<ngnast::scene_model_t, std::error_code>
+    read_cooked_cache(std::filesystem::path const& path,
+        ngnast::cache::cache_key_t const& key)
+    {
+        auto rv{ngnast::cache::read(ngnast::cache::cooked_path(path), key)};
+        if (!rv)
+        {
+            spdlog::debug("Cooked cache not used for {}: {}",
+                path.string(),
+                rv.error().message());
+        }
+        return rv;
+    }
+
+    void log_allocations(std::filesystem::path const& path,
+        ngnast::scene_model_t const& model)
+    {
+        ngnast::arena_statistics_t const statistics{model.arena.statistics()};
+        spdlog::debug("Model {} allocated {} bytes in {} arena blocks",
+            path.string(),
+            statistics.allocated_bytes,
+            statistics.allocations);
+    }
+
+    void write_cooked_cache(std::filesystem::path const& path,
+        ngnast::cache::cache_key_t const& key,
+        ngnast::scene_model_t const& model)
+    {
+        std::expected<void, std::error_code> result{
+            collect_dependencies(path).and_then(
+                [&path, &key, &model](
+                    std::vector<ngnast::cache::dependency_t> const& d)
+                {
+                    return ngnast::cache::write(
+                        ngnast::cache::cooked_path(path),
+                        key,
+                        d,
+                        model);
+                })};
+        if (!result)
+        {
+            spdlog::warn("Failed to write cooked cache for {}: {}",
+                path.string(),
+                result.error().message());
+        }
+    }
 } // namespace
 
 ngnast::gltf::loader_t::loader_t(
-    std::span<VkFormat const> const& compressed_texture_formats)
+    std::span<VkFormat const> const& compressed_texture_formats,
+    BS::thread_pool<>* const thread_pool,
+    bool const use_cooked_cache)
     : compressed_texture_formats_{std::cbegin(compressed_texture_formats),
           std::cend(compressed_texture_formats)}
+    , thread_pool_{thread_pool}
+    , use_cooked_cache_{use_cooked_cache}
 {
     if (!compressed_texture_formats.empty())
     {
@@ -1038,60 +1320,286 @@ ngnast::gltf::loader_t::loader_t(
     }
 }
 
-std::expected<ngnast::scene_model_t, std::error_code>
-ngnast::gltf::loader_t::load(std::filesystem::path const& path)
+struct [[nodiscard]] ngnast::gltf::image_stream_t::impl_t final
 {
-    std::error_code ec;
-    if (auto const file_exists{exists(path, ec)}; !file_exists || ec)
+    // Image data is read from the asset and from mapped external buffers
+    fastgltf::Asset asset;
+    std::vector<cppext::mapped_file_t> external_buffers;
+
+    std::vector<VkFormat> compressed_texture_formats;
+    std::filesystem::path parent_path;
+    std::set<size_t> unorm_images;
+
+    std::vector<
+        std::pair<size_t, std::future<std::expected<image_t, std::error_code>>>>
+        pending;
+    size_t next_image{};
+    size_t loaded{};
+
+    std::atomic<bool> cancelled{};
+
+    impl_t() = default;
+
+    impl_t(impl_t const&) = delete;
+
+    impl_t(impl_t&&) noexcept = delete;
+
+    ~impl_t();
+
+    [[nodiscard]] std::expected<image_t, std::error_code> load(size_t index);
+
+    impl_t& operator=(impl_t const&) = delete;
+
+    impl_t& operator=(impl_t&&) noexcept = delete;
+};
+
+ngnast::gltf::image_stream_t::impl_t::~impl_t()
+{
+    // Decoding tasks reference this object
+    cancelled = true;
+    for (auto const& [index, future] : pending)
     {
-        return std::unexpected{
-            ec ? ec : make_error_code(error_t::invalid_file)};
+        future.wait();
     }
+}
 
-    if (auto const regular_file{is_regular_file(path, ec)}; !regular_file || ec)
+std::expected<ngnast::image_t, std::error_code>
+ngnast::gltf::image_stream_t::impl_t::load(size_t const index)
+{
+    if (cancelled)
     {
         return std::unexpected{
-            ec ? ec : make_error_code(error_t::invalid_file)};
+            std::make_error_code(std::errc::operation_canceled)};
+    }
+
+    try
+    {
+        return load_image(compressed_texture_formats,
+            parent_path,
+            unorm_images.contains(index),
+            asset,
+            asset.images[index]);
+    }
+    catch (std::exception const& ex)
+    {
+        spdlog::error("Failed to load image {}: {}", index, ex.what());
+        return std::unexpected{make_error_code(error_t::unknown)};
+    }
+}
+
+ngnast::gltf::image_stream_t::image_stream_t() = default;
+
+ngnast::gltf::image_stream_t::image_stream_t(std::unique_ptr<impl_t> impl,
+    BS::thread_pool<>* const thread_pool)
+    : impl_{std::move(impl)}
+{
+    if (thread_pool)
+    {
+        impl_->pending.reserve(impl_->asset.images.size());
+        for (size_t i{}; i != impl_->asset.images.size(); ++i)
+        {
+            impl_->pending.emplace_back(i,
+                thread_pool->submit_task([impl = impl_.get(), i]()
+                    { return impl->load(i); }));
+        }
+        impl_->next_image = impl_->asset.images.size();
+    }
+}
+
+ngnast::gltf::image_stream_t::image_stream_t(
+    image_stream_t&&) noexcept = default;
+
+ngnast::gltf::image_stream_t::~image_stream_t() = default;
+
+ngnast::gltf::image_stream_t& ngnast::gltf::image_stream_t::operator=(
+    image_stream_t&&) noexcept = default;
+
+size_t ngnast::gltf::image_stream_t::poll(image_callback_t const& callback)
+{
+    if (done())
+    {
+        return 0;
+    }
+
+    size_t rv{};
+    auto const deliver = [this, &callback, &rv](size_t const index,
+                             std::expected<image_t, std::error_code>&& image)
+    {
+        ++impl_->loaded;
+
+        // Placeholder remains in use for images which failed to load
+        if (!image)
+        {
+            spdlog::warn("Image {} not streamed: {}",
+                index,
+                image.error().message());
+            return;
+        }
+
+        callback(index, std::move(image).value());
+        ++rv;
+    };
+
+    // Without a thread pool each poll decodes a single image
+    if (impl_->next_image != impl_->asset.images.size())
+    {
+        size_t const index{impl_->next_image++};
+        deliver(index, impl_->load(index));
+        return rv;
+    }
+
+    for (auto it{std::begin(impl_->pending)};
+        it != std::end(impl_->pending);)
+    {
+        if (it->second.wait_for(std::chrono::seconds{0}) !=
+            std::future_status::ready)
+        {
+            ++it;
+            continue;
+        }
+
+        deliver(it->first, it->second.get());
+        it = impl_->pending.erase(it);
     }
 
-    fastgltf::Parser parser{
-        fastgltf::Extensions::KHR_materials_emissive_strength |
-        fastgltf::Extensions::KHR_texture_basisu};
+    return rv;
+}
+
+size_t ngnast::gltf::image_stream_t::loaded() const
+{
+    return impl_ ? impl_->loaded : 0;
+}
 
-    auto data{fastgltf::GltfDataBuffer::FromPath(path)};
-    if (data.error() != fastgltf::Error::None)
+size_t ngnast::gltf::image_stream_t::total() const
+{
+    return impl_ ? impl_->asset.images.size() : 0;
+}
+
+bool ngnast::gltf::image_stream_t::done() const
+{
+    return loaded() == total();
+}
+
+std::expected<ngnast::scene_model_t, std::error_code>
+ngnast::gltf::loader_t::load(std::filesystem::path const& path)
+{
+    if (auto const checked{check_source_file(path)}; !checked)
+    {
+        return std::unexpected{checked.error()};
+    }
+
+    std::optional<cache::cache_key_t> cache_key;
+    if (use_cooked_cache_)
     {
-        spdlog::error("Failed to create data buffer: {}", data.error());
-        return std::unexpected{make_error_code(translate_error(data.error()))};
+        if (auto key{calculate_cache_key(path, compressed_texture_formats_)})
+        {
+            cache_key = *key;
+
+            if (auto cooked{read_cooked_cache(path, *key)})
+            {
+                log_allocations(path, *cooked);
+                return std::move(cooked).value();
+            }
+        }
     }
 
     auto const parent_path{path.parent_path()};
-    auto asset{parser.loadGltf(data.get(),
-        parent_path,
-        fastgltf::Options::LoadExternalBuffers)};
-    if (asset.error() != fastgltf::Error::None)
+    auto asset{parse_asset(path, parent_path)};
+    if (!asset)
     {
-        spdlog::error("Failed to load asset: {}", asset.error());
-        return std::unexpected{make_error_code(translate_error(data.error()))};
+        return std::unexpected{asset.error()};
     }
 
     scene_model_t rv;
 
     try
     {
-        load_samplers(asset.get(), rv);
-        load_textures(asset.get(), rv);
-        std::set<size_t> const unorm_images{load_materials(asset.get(), rv)};
+        std::vector<cppext::mapped_file_t> const external_buffers{
+            map_external_buffers(parent_path, *asset)};
+
+        load_samplers(*asset, rv);
+        load_textures(*asset, rv);
+        std::set<size_t> const unorm_images{load_materials(*asset, rv)};
         load_images(compressed_texture_formats_,
             parent_path,
             unorm_images,
-            asset.get(),
+            *asset,
+            thread_pool_,
             rv);
 
-        rv.nodes.resize(asset->nodes.size());
+        allocate_nodes(*asset, rv);
+
+        load_meshes(*asset, thread_pool_, {}, rv);
+        load_scenes(*asset, rv);
+    }
+    catch (std::exception const& ex)
+    {
+        spdlog::error("Failed to load model: {}", ex.what());
+        return std::unexpected{make_error_code(error_t::unknown)};
+    }
+
+    log_allocations(path, rv);
+
+    if (cache_key)
+    {
+        write_cooked_cache(path, *cache_key, rv);
+    }
+
+    return rv;
+}
+
+std::expected<ngnast::gltf::streamed_model_t, std::error_code>
+ngnast::gltf::loader_t::load_streaming(std::filesystem::path const& path,
+    mesh_progress_callback_t const& mesh_progress)
+{
+    if (auto const checked{check_source_file(path)}; !checked)
+    {
+        return std::unexpected{checked.error()};
+    }
+
+    // Cooked data contains full resolution images, there is nothing to stream
+    if (use_cooked_cache_)
+    {
+        if (auto key{calculate_cache_key(path, compressed_texture_formats_)})
+        {
+            if (auto cooked{read_cooked_cache(path, *key)})
+            {
+                log_allocations(path, *cooked);
+                return streamed_model_t{.model = std::move(cooked).value()};
+            }
+        }
+    }
 
-        rv.meshes = load_meshes(asset.get(), rv.primitives);
-        load_scenes(asset.get(), rv);
+    auto const parent_path{path.parent_path()};
+    auto asset{parse_asset(path, parent_path)};
+    if (!asset)
+    {
+        return std::unexpected{asset.error()};
+    }
+
+    auto impl{std::make_unique<image_stream_t::impl_t>()};
+    impl->asset = std::move(asset).value();
+    impl->compressed_texture_formats = compressed_texture_formats_;
+    impl->parent_path = parent_path;
+
+    streamed_model_t rv;
+
+    try
+    {
+        impl->external_buffers = map_external_buffers(parent_path, impl->asset);
+
+        load_samplers(impl->asset, rv.model);
+        load_textures(impl->asset, rv.model);
+        impl->unorm_images = load_materials(impl->asset, rv.model);
+
+        allocate_nodes(impl->asset, rv.model);
+
+        load_meshes(impl->asset, thread_pool_, mesh_progress, rv.model);
+        load_scenes(impl->asset, rv.model);
+
+        load_placeholder_images(impl->unorm_images,
+            impl->asset.images.size(),
+            rv.model);
     }
     catch (std::exception const& ex)
     {
@@ -1099,5 +1607,9 @@ ngnast::gltf::loader_t::load(std::filesystem::path const& path)
         return std::unexpected{make_error_code(error_t::unknown)};
     }
 
+    log_allocations(path, rv.model);
+
+    rv.images = image_stream_t{std::move(impl), thread_pool_};
+
     return rv;
 }
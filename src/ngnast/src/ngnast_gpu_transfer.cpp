@@ -18,29 +18,39 @@
 #include <boost/scope/scope_exit.hpp>
 #include <boost/scope/scope_fail.hpp>
 
+#include <glm/common.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/packing.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/mat4x4.hpp>
 #include <glm/matrix.hpp>
+#include <glm/packing.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vector_relational.hpp>
 
 #include <vulkan/utility/vk_struct_helper.hpp>
 
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <expected>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <system_error>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 // IWYU pragma: no_include <boost/scope/exception_checker.hpp>
-// IWYU pragma: no_include <span>
 // IWYU pragma: no_include <tuple>
 
 namespace
@@ -55,9 +65,135 @@ namespace
             .color = v.color};
     }
 
+    [[nodiscard]] uint16_t quantize_unorm16(float const value)
+    {
+        return static_cast<uint16_t>(
+            std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    [[nodiscard]] int16_t quantize_snorm16(float const value)
+    {
+        return static_cast<int16_t>(
+            std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    [[nodiscard]] std::array<int16_t, 2> octahedral_encode(
+        glm::vec3 const& direction)
+    {
+        float const length{std::abs(direction.x) + std::abs(direction.y) +
+            std::abs(direction.z)};
+        if (length == 0.0f)
+        {
+            return {};
+        }
+
+        glm::vec3 const n{direction / length};
+
+        glm::vec2 rv{n.x, n.y};
+        if (n.z < 0.0f)
+        {
+            glm::vec2 const sign{rv.x >= 0.0f ? 1.0f : -1.0f,
+                rv.y >= 0.0f ? 1.0f : -1.0f};
+            rv = (1.0f - glm::abs(glm::vec2{rv.y, rv.x})) * sign;
+        }
+
+        return {quantize_snorm16(rv.x), quantize_snorm16(rv.y)};
+    }
+
+    [[nodiscard]] ngnast::gpu::packed_vertex_t to_packed_vertex(
+        ngnast::vertex_t const& v,
+        ngnast::gpu::primitive_t const& primitive)
+    {
+        glm::vec3 const relative{glm::clamp(
+            (v.position - primitive.position_offset) /
+                glm::max(primitive.position_scale,
+                    glm::vec3{std::numeric_limits<float>::min()}),
+            0.0f,
+            1.0f)};
+
+        return {.position = {quantize_unorm16(relative.x),
+                    quantize_unorm16(relative.y),
+                    quantize_unorm16(relative.z),
+                    v.tangent.w < 0.0f ? uint16_t{0} : uint16_t{65535}},
+            .normal = octahedral_encode(v.normal),
+            .tangent = octahedral_encode(glm::vec3{v.tangent}),
+            .uv = {glm::packHalf1x16(v.uv.x), glm::packHalf1x16(v.uv.y)}};
+    }
+
+    [[nodiscard]] uint32_t to_packed_color(glm::vec4 const& color)
+    {
+        return glm::packUnorm4x8(color);
+    }
+
+    [[nodiscard]] bool has_vertex_colors(ngnast::scene_model_t const& model)
+    {
+        return std::ranges::any_of(model.primitives,
+            [](ngnast::primitive_t const& p)
+            {
+                return std::ranges::any_of(p.vertices,
+                    [](ngnast::vertex_t const& v)
+                    { return v.color != glm::vec4{1.0f}; });
+            });
+    }
+
+    // Packed positions of all primitives of a mesh are quantized relative to
+    // the same bounds, so that the mesh can be dequantized with a single
+    // transformation.
+    [[nodiscard]] std::vector<ngnast::bounding_box_t> quantization_bounds(
+        ngnast::scene_model_t const& model)
+    {
+        auto const vertex_bounds = [](ngnast::primitive_t const& p,
+                                       ngnast::bounding_box_t& box)
+        {
+            for (ngnast::vertex_t const& v : p.vertices)
+            {
+                box.min = glm::min(box.min, v.position);
+                box.max = glm::max(box.max, v.position);
+            }
+        };
+
+        ngnast::bounding_box_t const empty{
+            .min = glm::vec3{std::numeric_limits<float>::max()},
+            .max = glm::vec3{std::numeric_limits<float>::lowest()}};
+
+        std::vector<ngnast::bounding_box_t> rv(model.primitives.size(), empty);
+        std::vector<bool> assigned(model.primitives.size());
+
+        for (ngnast::mesh_t const& mesh : model.meshes)
+        {
+            ngnast::bounding_box_t box{empty};
+            for (size_t const index : mesh.primitive_indices)
+            {
+                vertex_bounds(model.primitives[index], box);
+            }
+
+            for (size_t const index : mesh.primitive_indices)
+            {
+                rv[index] = box;
+                assigned[index] = true;
+            }
+        }
+
+        for (size_t i{}; i != rv.size(); ++i)
+        {
+            if (!assigned[i])
+            {
+                vertex_bounds(model.primitives[i], rv[i]);
+            }
+
+            if (glm::any(glm::greaterThan(rv[i].min, rv[i].max)))
+            {
+                rv[i] = {};
+            }
+        }
+
+        return rv;
+    }
+
+    template<typename WriteVertices>
     [[nodiscard]] std::vector<ngnast::gpu::primitive_t> transfer_primitives(
         ngnast::scene_model_t const& model,
-        ngnast::gpu::vertex_t* vertices,
+        WriteVertices&& write_vertices,
         uint32_t* indices)
     {
         int32_t running_vertex_count{};
@@ -75,27 +211,28 @@ namespace
                     .vertex_count = cppext::narrow<uint32_t>(p.vertices.size()),
                     .is_indexed = !p.indices.empty()};
 
-                // clang-format off
-                // cppcheck-suppress uselessAssignmentPtrArg
-                vertices = std::ranges::transform(p.vertices, 
-                    vertices,
-                    to_gpu_vertex).out;
-                // clang-format on
+                write_vertices(rv.size(), p, gp);
 
-                if constexpr (std::is_same_v<uint32_t, unsigned int>)
+                auto const copy_indices =
+                    [&indices](std::span<unsigned int const> const source)
                 {
-                    // cppcheck-suppress uselessAssignmentPtrArg
-                    indices = std::ranges::copy(p.indices, indices).out;
-                }
-                else
-                {
-                    // clang-format off
-                    // cppcheck-suppress uselessAssignmentPtrArg
-                    indices = std::ranges::transform(p.indices,
-                        indices,
-                        cppext::narrow<uint32_t, unsigned int>).out;
-                    // clang-format on
-                }
+                    if constexpr (std::is_same_v<uint32_t, unsigned int>)
+                    {
+                        // cppcheck-suppress uselessAssignmentPtrArg
+                        indices = std::ranges::copy(source, indices).out;
+                    }
+                    else
+                    {
+                        // clang-format off
+                        // cppcheck-suppress uselessAssignmentPtrArg
+                        indices = std::ranges::transform(source,
+                            indices,
+                            cppext::narrow<uint32_t, unsigned int>).out;
+                        // clang-format on
+                    }
+                };
+
+                copy_indices(p.indices);
 
                 if (gp.is_indexed)
                 {
@@ -117,6 +254,24 @@ namespace
                     running_index_count)};
                 assert(overflow);
 
+                // Levels of detail follow full detail indices of the
+                // primitive and share its vertices
+                gp.lods.reserve(p.lods.size());
+                for (ngnast::lod_t const& lod : p.lods)
+                {
+                    copy_indices(lod.indices);
+
+                    gp.lods.push_back(
+                        {.count = cppext::narrow<uint32_t>(lod.indices.size()),
+                            .first = running_index_count,
+                            .error = lod.error});
+
+                    overflow = cppext::add(running_index_count,
+                        cppext::narrow<uint32_t>(lod.indices.size()),
+                        running_index_count);
+                    assert(overflow);
+                }
+
                 overflow = cppext::add(running_vertex_count,
                     cppext::narrow<int32_t>(p.vertices.size()),
                     running_vertex_count);
@@ -204,18 +359,42 @@ namespace
     }
 } // namespace
 
+glm::mat4 ngnast::gpu::dequantization_matrix(primitive_t const& primitive)
+{
+    return glm::scale(glm::translate(glm::mat4{1.0f}, primitive.position_offset),
+        primitive.position_scale);
+}
+
+ngnast::gpu::lod_t ngnast::gpu::select_lod(primitive_t const& primitive,
+    float const pixels_per_unit,
+    float const threshold)
+{
+    lod_t rv{.count = primitive.count, .first = primitive.first};
+    for (lod_t const& lod : primitive.lods)
+    {
+        if (lod.error * pixels_per_unit > threshold)
+        {
+            break;
+        }
+        rv = lod;
+    }
+    return rv;
+}
+
 void ngnast::gpu::destroy(vkrndr::device_t const& device,
     geometry_transfer_result_t const& model)
 {
     destroy(device, model.vertex_buffer);
+    destroy(device, model.color_buffer);
     destroy(device, model.index_buffer);
 }
 
 ngnast::gpu::geometry_transfer_result_t ngnast::gpu::transfer_geometry(
     vkrndr::device_t const& device,
-    scene_model_t const& model)
+    scene_model_t const& model,
+    geometry_transfer_options_t const& options)
 {
-    geometry_transfer_result_t rv;
+    geometry_transfer_result_t rv{.vertex_format = options.vertex_format};
 
     std::ranges::for_each(model.meshes,
         [&model, &vc = rv.vertex_count, &ic = rv.index_count](
@@ -235,16 +414,42 @@ ngnast::gpu::geometry_transfer_result_t ngnast::gpu::transfer_geometry(
                         cppext::narrow<uint32_t>(primitive.indices.size()),
                         ic);
                     assert(overflow);
+
+                    for (ngnast::lod_t const& lod : primitive.lods)
+                    {
+                        overflow = cppext::add(ic,
+                            cppext::narrow<uint32_t>(lod.indices.size()),
+                            ic);
+                        assert(overflow);
+                    }
                 });
         });
 
+    bool const packed{options.vertex_format == vertex_format_t::packed};
+
     rv.vertex_buffer = vkrndr::create_staging_buffer(device,
-        sizeof(gpu::vertex_t) * rv.vertex_count);
+        (packed ? sizeof(packed_vertex_t) : sizeof(gpu::vertex_t)) *
+            rv.vertex_count);
     auto vertex_map{vkrndr::map_memory(device, rv.vertex_buffer)};
     boost::scope::defer_guard unmap_vertex{
         [&device, &vertex_map]() { unmap_memory(device, &vertex_map); }};
 
-    auto* const vertices{vertex_map.as<gpu::vertex_t>()};
+    vkrndr::mapped_memory_t color_map;
+    boost::scope::scope_exit unmap_color{
+        [&device, &color_map]() { unmap_memory(device, &color_map); }};
+
+    uint32_t* colors{};
+    if (packed && (options.require_color_stream || has_vertex_colors(model)))
+    {
+        rv.color_buffer = vkrndr::create_staging_buffer(device,
+            sizeof(uint32_t) * rv.vertex_count);
+        color_map = vkrndr::map_memory(device, rv.color_buffer);
+        colors = color_map.as<uint32_t>();
+    }
+    else
+    {
+        unmap_color.set_active(false);
+    }
 
     vkrndr::mapped_memory_t index_map;
     boost::scope::scope_exit unmap_index{
@@ -263,7 +468,149 @@ ngnast::gpu::geometry_transfer_result_t ngnast::gpu::transfer_geometry(
         unmap_index.set_active(false);
     }
 
-    rv.primitives = transfer_primitives(model, vertices, indices);
+    if (packed)
+    {
+        std::vector<bounding_box_t> const bounds{quantization_bounds(model)};
+
+        auto* vertices{vertex_map.as<packed_vertex_t>()};
+        rv.primitives = transfer_primitives(model,
+            [&bounds, &vertices, &colors](size_t const index,
+                ngnast::primitive_t const& p,
+                gpu::primitive_t& gp)
+            {
+                gp.position_offset = bounds[index].min;
+                gp.position_scale = bounds[index].max - bounds[index].min;
+
+                vertices = std::ranges::transform(p.vertices,
+                    vertices,
+                    [&gp](ngnast::vertex_t const& v)
+                    { return to_packed_vertex(v, gp); })
+                               .out;
+
+                if (colors)
+                {
+                    colors = std::ranges::transform(p.vertices,
+                        colors,
+                        to_packed_color,
+                        &ngnast::vertex_t::color)
+                                 .out;
+                }
+            },
+            indices);
+    }
+    else
+    {
+        auto* vertices{vertex_map.as<gpu::vertex_t>()};
+        rv.primitives = transfer_primitives(model,
+            [&vertices](size_t,
+                ngnast::primitive_t const& p,
+                gpu::primitive_t const&)
+            {
+                vertices =
+                    std::ranges::transform(p.vertices, vertices, to_gpu_vertex)
+                        .out;
+            },
+            indices);
+    }
+
+    return rv;
+}
+
+void ngnast::gpu::destroy(vkrndr::device_t const& device,
+    cluster_transfer_result_t const& clusters)
+{
+    destroy(device, clusters.meshlet_buffer);
+    destroy(device, clusters.meshlet_vertex_buffer);
+    destroy(device, clusters.meshlet_triangle_buffer);
+}
+
+ngnast::gpu::cluster_transfer_result_t ngnast::gpu::transfer_clusters(
+    vkrndr::device_t const& device,
+    scene_model_t const& model)
+{
+    cluster_transfer_result_t rv;
+    rv.primitives.reserve(model.primitives.size());
+
+    size_t meshlet_vertex_count{};
+    size_t meshlet_triangle_size{};
+    for (ngnast::primitive_t const& p : model.primitives)
+    {
+        rv.primitives.push_back({.first = rv.meshlet_count,
+            .count = cppext::narrow<uint32_t>(p.meshlets.size())});
+
+        rv.meshlet_count += rv.primitives.back().count;
+        meshlet_vertex_count += p.meshlet_vertices.size();
+        meshlet_triangle_size += p.meshlet_triangles.size();
+    }
+
+    if (rv.meshlet_count == 0)
+    {
+        return rv;
+    }
+
+    rv.meshlet_buffer = vkrndr::create_staging_buffer(device,
+        sizeof(gpu::meshlet_t) * rv.meshlet_count);
+    auto meshlet_map{vkrndr::map_memory(device, rv.meshlet_buffer)};
+    boost::scope::defer_guard unmap_meshlet{
+        [&device, &meshlet_map]() { unmap_memory(device, &meshlet_map); }};
+
+    rv.meshlet_vertex_buffer = vkrndr::create_staging_buffer(device,
+        sizeof(uint32_t) * meshlet_vertex_count);
+    auto vertex_map{vkrndr::map_memory(device, rv.meshlet_vertex_buffer)};
+    boost::scope::defer_guard unmap_vertex{
+        [&device, &vertex_map]() { unmap_memory(device, &vertex_map); }};
+
+    rv.meshlet_triangle_buffer =
+        vkrndr::create_staging_buffer(device, meshlet_triangle_size);
+    auto triangle_map{vkrndr::map_memory(device, rv.meshlet_triangle_buffer)};
+    boost::scope::defer_guard unmap_triangle{
+        [&device, &triangle_map]() { unmap_memory(device, &triangle_map); }};
+
+    auto* meshlets{meshlet_map.as<gpu::meshlet_t>()};
+    auto* vertices{vertex_map.as<uint32_t>()};
+    auto* triangles{triangle_map.as<uint8_t>()};
+
+    // Vertices of primitives are laid out sequentially by transfer_geometry
+    uint32_t running_vertex_count{};
+    uint32_t running_meshlet_vertex_count{};
+    uint32_t running_meshlet_triangle_size{};
+    for (size_t index{}; index != model.primitives.size(); ++index)
+    {
+        ngnast::primitive_t const& p{model.primitives[index]};
+
+        meshlets = std::ranges::transform(p.meshlets,
+            meshlets,
+            [&](ngnast::meshlet_t const& m)
+            {
+                return gpu::meshlet_t{.center = m.center,
+                    .radius = m.radius,
+                    .cone_apex = m.cone_apex,
+                    .cone_cutoff = m.cone_cutoff,
+                    .cone_axis = m.cone_axis,
+                    .primitive_index = cppext::narrow<uint32_t>(index),
+                    .vertex_offset =
+                        running_meshlet_vertex_count + m.vertex_offset,
+                    .triangle_offset =
+                        running_meshlet_triangle_size + m.triangle_offset,
+                    .vertex_count = m.vertex_count,
+                    .triangle_count = m.triangle_count};
+            })
+                       .out;
+
+        vertices = std::ranges::transform(p.meshlet_vertices,
+            vertices,
+            [&running_vertex_count](unsigned int const v)
+            { return running_vertex_count + cppext::narrow<uint32_t>(v); })
+                       .out;
+
+        triangles = std::ranges::copy(p.meshlet_triangles, triangles).out;
+
+        running_vertex_count += cppext::narrow<uint32_t>(p.vertices.size());
+        running_meshlet_vertex_count +=
+            cppext::narrow<uint32_t>(p.meshlet_vertices.size());
+        running_meshlet_triangle_size +=
+            cppext::narrow<uint32_t>(p.meshlet_triangles.size());
+    }
 
     return rv;
 }
@@ -312,7 +659,7 @@ ngnast::gpu::build_acceleration_structures(vkrndr::backend_t& backend,
         .index_buffer = intermediate.index_count > 0
             ? vkrndr::create_buffer(backend.device(),
                   {
-                      .size = intermediate.vertex_buffer.size,
+                      .size = intermediate.index_buffer.size,
                       .usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
                           VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT |
                           VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR |
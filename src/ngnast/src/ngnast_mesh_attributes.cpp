@@ -0,0 +1,544 @@
+#include <ngnast_mesh_attributes.hpp>
+
+#include <ngnast_scene_model.hpp>
+
+#include <cppext_numeric.hpp>
+
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <glm/geometric.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <mikktspace.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NGNAST_MESH_ATTRIBUTES_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NGNAST_MESH_ATTRIBUTES_SSE2
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Positions and face normals are kept in separate streams per component
+    // so that consecutive faces map to consecutive SIMD lanes
+    struct [[nodiscard]] streams_t final
+    {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+
+        explicit streams_t(size_t const size) : x(size), y(size), z(size) { }
+    };
+
+    [[nodiscard]] streams_t to_streams(
+        std::span<ngnast::vertex_t const> const vertices)
+    {
+        streams_t rv{vertices.size()};
+        for (size_t i{}; i != vertices.size(); ++i)
+        {
+            rv.x[i] = vertices[i].position.x;
+            rv.y[i] = vertices[i].position.y;
+            rv.z[i] = vertices[i].position.z;
+        }
+        return rv;
+    }
+
+    // Operations match glm::normalize(glm::cross(edge1, edge2)) exactly, SIMD
+    // paths do the same operations in the same order
+    void face_normals_scalar(streams_t const& positions,
+        unsigned int const* const indices,
+        size_t const first_face,
+        size_t const last_face,
+        streams_t& normals)
+    {
+        for (size_t face{first_face}; face != last_face; ++face)
+        {
+            size_t const c{face * 3};
+            size_t const i0{indices ? indices[c] : c};
+            size_t const i1{indices ? indices[c + 1] : c + 1};
+            size_t const i2{indices ? indices[c + 2] : c + 2};
+
+            float const e1x{positions.x[i1] - positions.x[i0]};
+            float const e1y{positions.y[i1] - positions.y[i0]};
+            float const e1z{positions.z[i1] - positions.z[i0]};
+            float const e2x{positions.x[i2] - positions.x[i0]};
+            float const e2y{positions.y[i2] - positions.y[i0]};
+            float const e2z{positions.z[i2] - positions.z[i0]};
+
+            float const nx{e1y * e2z - e2y * e1z};
+            float const ny{e1z * e2x - e2z * e1x};
+            float const nz{e1x * e2y - e2x * e1y};
+
+            float const inverse_length{
+                1.0f / std::sqrt(nx * nx + ny * ny + nz * nz)};
+
+            normals.x[face] = nx * inverse_length;
+            normals.y[face] = ny * inverse_length;
+            normals.z[face] = nz * inverse_length;
+        }
+    }
+
+#if defined(NGNAST_MESH_ATTRIBUTES_AVX2)
+    constexpr size_t lane_count{8};
+
+    size_t face_normals_simd(streams_t const& positions,
+        unsigned int const* const indices,
+        size_t const face_count,
+        streams_t& normals)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        __m256i const stride{_mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21)};
+
+        size_t const simd_faces{face_count - face_count % lane_count};
+        for (size_t face{}; face != simd_faces; face += lane_count)
+        {
+            __m256i const base{_mm256_add_epi32(stride,
+                _mm256_set1_epi32(cppext::narrow<int>(face * 3)))};
+
+            std::array<__m256i, 3> corners{base,
+                _mm256_add_epi32(base, _mm256_set1_epi32(1)),
+                _mm256_add_epi32(base, _mm256_set1_epi32(2))};
+            if (indices)
+            {
+                for (__m256i& corner : corners)
+                {
+                    corner = _mm256_i32gather_epi32(
+                        reinterpret_cast<int const*>(indices),
+                        corner,
+                        4);
+                }
+            }
+
+            auto const gather = [](std::vector<float> const& stream,
+                                    __m256i const& index)
+            { return _mm256_i32gather_ps(stream.data(), index, 4); };
+
+            __m256 const x0{gather(positions.x, corners[0])};
+            __m256 const y0{gather(positions.y, corners[0])};
+            __m256 const z0{gather(positions.z, corners[0])};
+
+            __m256 const e1x{
+                _mm256_sub_ps(gather(positions.x, corners[1]), x0)};
+            __m256 const e1y{
+                _mm256_sub_ps(gather(positions.y, corners[1]), y0)};
+            __m256 const e1z{
+                _mm256_sub_ps(gather(positions.z, corners[1]), z0)};
+            __m256 const e2x{
+                _mm256_sub_ps(gather(positions.x, corners[2]), x0)};
+            __m256 const e2y{
+                _mm256_sub_ps(gather(positions.y, corners[2]), y0)};
+            __m256 const e2z{
+                _mm256_sub_ps(gather(positions.z, corners[2]), z0)};
+
+            __m256 const nx{_mm256_sub_ps(_mm256_mul_ps(e1y, e2z),
+                _mm256_mul_ps(e2y, e1z))};
+            __m256 const ny{_mm256_sub_ps(_mm256_mul_ps(e1z, e2x),
+                _mm256_mul_ps(e2z, e1x))};
+            __m256 const nz{_mm256_sub_ps(_mm256_mul_ps(e1x, e2y),
+                _mm256_mul_ps(e2x, e1y))};
+
+            __m256 const length_squared{_mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(nx, nx), _mm256_mul_ps(ny, ny)),
+                _mm256_mul_ps(nz, nz))};
+            __m256 const inverse_length{_mm256_div_ps(_mm256_set1_ps(1.0f),
+                _mm256_sqrt_ps(length_squared))};
+
+            _mm256_storeu_ps(&normals.x[face],
+                _mm256_mul_ps(nx, inverse_length));
+            _mm256_storeu_ps(&normals.y[face],
+                _mm256_mul_ps(ny, inverse_length));
+            _mm256_storeu_ps(&normals.z[face],
+                _mm256_mul_ps(nz, inverse_length));
+        }
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        return simd_faces;
+    }
+#elif defined(NGNAST_MESH_ATTRIBUTES_SSE2)
+    constexpr size_t lane_count{4};
+
+    size_t face_normals_simd(streams_t const& positions,
+        unsigned int const* const indices,
+        size_t const face_count,
+        streams_t& normals)
+    {
+        size_t const simd_faces{face_count - face_count % lane_count};
+        for (size_t face{}; face != simd_faces; face += lane_count)
+        {
+            // SSE2 has no gather, lanes are loaded individually
+            std::array<std::array<size_t, lane_count>, 3> corners; // NOLINT
+            for (size_t lane{}; lane != lane_count; ++lane)
+            {
+                size_t const c{(face + lane) * 3};
+                for (size_t k{}; k != 3; ++k)
+                {
+                    corners[k][lane] = indices ? indices[c + k] : c + k;
+                }
+            }
+
+            auto const gather = [](std::vector<float> const& stream,
+                                    std::array<size_t, lane_count> const& i)
+            {
+                return _mm_setr_ps(stream[i[0]],
+                    stream[i[1]],
+                    stream[i[2]],
+                    stream[i[3]]);
+            };
+
+            __m128 const x0{gather(positions.x, corners[0])};
+            __m128 const y0{gather(positions.y, corners[0])};
+            __m128 const z0{gather(positions.z, corners[0])};
+
+            __m128 const e1x{_mm_sub_ps(gather(positions.x, corners[1]), x0)};
+            __m128 const e1y{_mm_sub_ps(gather(positions.y, corners[1]), y0)};
+            __m128 const e1z{_mm_sub_ps(gather(positions.z, corners[1]), z0)};
+            __m128 const e2x{_mm_sub_ps(gather(positions.x, corners[2]), x0)};
+            __m128 const e2y{_mm_sub_ps(gather(positions.y, corners[2]), y0)};
+            __m128 const e2z{_mm_sub_ps(gather(positions.z, corners[2]), z0)};
+
+            __m128 const nx{
+                _mm_sub_ps(_mm_mul_ps(e1y, e2z), _mm_mul_ps(e2y, e1z))};
+            __m128 const ny{
+                _mm_sub_ps(_mm_mul_ps(e1z, e2x), _mm_mul_ps(e2z, e1x))};
+            __m128 const nz{
+                _mm_sub_ps(_mm_mul_ps(e1x, e2y), _mm_mul_ps(e2x, e1y))};
+
+            __m128 const length_squared{
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)),
+                    _mm_mul_ps(nz, nz))};
+            __m128 const inverse_length{
+                _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(length_squared))};
+
+            _mm_storeu_ps(&normals.x[face], _mm_mul_ps(nx, inverse_length));
+            _mm_storeu_ps(&normals.y[face], _mm_mul_ps(ny, inverse_length));
+            _mm_storeu_ps(&normals.z[face], _mm_mul_ps(nz, inverse_length));
+        }
+
+        return simd_faces;
+    }
+#else
+    size_t face_normals_simd(streams_t const&,
+        unsigned int const*,
+        size_t,
+        streams_t&)
+    {
+        return 0;
+    }
+#endif
+
+    // Triangle list and the chunk of it processed by one MikkTSpace run
+    struct [[nodiscard]] tangent_context_t final
+    {
+        ngnast::vertex_t* vertices;
+        ngnast::mesh::detail::tangent_chunk_t const* chunk;
+
+        [[nodiscard]] uint32_t face(int const index) const
+        {
+            return chunk->faces[cppext::narrow<size_t>(index)];
+        }
+
+        [[nodiscard]] bool owns(int const index) const
+        {
+            uint32_t const f{face(index)};
+            return f >= chunk->first_owned && f < chunk->last_owned;
+        }
+
+        [[nodiscard]] ngnast::vertex_t& corner(int const index,
+            int const vertex) const
+        {
+            return vertices[size_t{face(index)} * 3 +
+                cppext::narrow<size_t>(vertex)];
+        }
+    };
+
+    [[nodiscard]] tangent_context_t const& context_of(
+        SMikkTSpaceContext const* const context)
+    {
+        return *static_cast<tangent_context_t const*>(context->m_pUserData);
+    }
+
+    [[nodiscard]] bool generate_tangents(
+        tangent_context_t const& tangent_context)
+    {
+        SMikkTSpaceInterface interface{
+            .m_getNumFaces = [](SMikkTSpaceContext const* context) -> int
+            {
+                return cppext::narrow<int>(
+                    context_of(context).chunk->faces.size());
+            },
+            .m_getNumVerticesOfFace =
+                []([[maybe_unused]] SMikkTSpaceContext const* context,
+                    [[maybe_unused]] int const face) -> int { return 3; },
+            .m_getPosition =
+                [](SMikkTSpaceContext const* context,
+                    float* const out,
+                    int const face,
+                    int const vertex)
+            {
+                glm::vec3 const& p{
+                    context_of(context).corner(face, vertex).position};
+                out[0] = p.x;
+                out[1] = p.y;
+                out[2] = p.z;
+            },
+            .m_getNormal =
+                [](SMikkTSpaceContext const* context,
+                    float* const out,
+                    int const face,
+                    int const vertex)
+            {
+                glm::vec3 const& n{
+                    context_of(context).corner(face, vertex).normal};
+                out[0] = n.x;
+                out[1] = n.y;
+                out[2] = n.z;
+            },
+            .m_getTexCoord =
+                [](SMikkTSpaceContext const* context,
+                    float* const out,
+                    int const face,
+                    int const vertex)
+            {
+                glm::vec2 const& uv{
+                    context_of(context).corner(face, vertex).uv};
+                out[0] = uv.x;
+                out[1] = uv.y;
+            },
+            .m_setTSpaceBasic =
+                [](SMikkTSpaceContext const* context,
+                    float const* const tangent,
+                    float const sign,
+                    int const face,
+                    int const vertex)
+            {
+                tangent_context_t const& c{context_of(context)};
+                if (c.owns(face))
+                {
+                    c.corner(face, vertex).tangent =
+                        glm::vec4{tangent[0], tangent[1], tangent[2], -sign};
+                }
+            },
+            .m_setTSpace = nullptr};
+
+        SMikkTSpaceContext const context{.m_pInterface = &interface,
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            .m_pUserData = const_cast<tangent_context_t*>(&tangent_context)};
+
+        return static_cast<bool>(genTangSpaceDefault(&context));
+    }
+
+    // Chunks smaller than this aren't worth a task
+    constexpr size_t min_chunk_faces{16384};
+
+    // Faces referencing each welded vertex, in ascending order
+    struct [[nodiscard]] vertex_faces_t final
+    {
+        std::vector<uint32_t> corner_vertices;
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> faces;
+
+        [[nodiscard]] std::span<uint32_t const> of_corner(
+            size_t const corner) const
+        {
+            uint32_t const vertex{corner_vertices[corner]};
+            return std::span{faces}.subspan(offsets[vertex],
+                offsets[vertex + 1] - offsets[vertex]);
+        }
+    };
+
+    // MikkTSpace welds corners with equal position, normal and texture
+    // coordinate, tangents of a corner depend only on faces sharing its
+    // welded vertex
+    [[nodiscard]] vertex_faces_t weld_corners(
+        std::span<ngnast::vertex_t const> const vertices)
+    {
+        using key_t = std::array<float, 8>;
+        boost::unordered_flat_map<key_t, uint32_t, boost::hash<key_t>> welded;
+        welded.reserve(vertices.size());
+
+        vertex_faces_t rv;
+        rv.corner_vertices.reserve(vertices.size());
+        for (ngnast::vertex_t const& v : vertices)
+        {
+            // Adding zero maps negative zero to positive zero, both compare
+            // equal when welding
+            key_t const key{v.position.x + 0.0f,
+                v.position.y + 0.0f,
+                v.position.z + 0.0f,
+                v.normal.x + 0.0f,
+                v.normal.y + 0.0f,
+                v.normal.z + 0.0f,
+                v.uv.x + 0.0f,
+                v.uv.y + 0.0f};
+
+            auto const it{welded
+                    .try_emplace(key, cppext::narrow<uint32_t>(welded.size()))
+                    .first};
+            rv.corner_vertices.push_back(it->second);
+        }
+
+        rv.offsets.resize(welded.size() + 1);
+        for (uint32_t const vertex : rv.corner_vertices)
+        {
+            ++rv.offsets[vertex + 1];
+        }
+        std::partial_sum(rv.offsets.cbegin(),
+            rv.offsets.cend(),
+            rv.offsets.begin());
+
+        std::vector<uint32_t> next(rv.offsets.cbegin(),
+            std::prev(rv.offsets.cend()));
+        rv.faces.resize(vertices.size());
+        for (size_t corner{}; corner != vertices.size(); ++corner)
+        {
+            rv.faces[next[rv.corner_vertices[corner]]++] =
+                cppext::narrow<uint32_t>(corner / 3);
+        }
+
+        return rv;
+    }
+} // namespace
+
+void ngnast::mesh::calculate_normals(primitive_t& primitive)
+{
+    bool const is_indexed{!primitive.indices.empty()};
+
+    auto& vertices{primitive.vertices};
+    unsigned int const* const indices{
+        is_indexed ? primitive.indices.data() : nullptr};
+
+    size_t const face_count{
+        (is_indexed ? primitive.indices.size() : vertices.size()) / 3};
+
+    streams_t const positions{to_streams(vertices)};
+    streams_t normals{face_count};
+
+    size_t const simd_faces{
+        face_normals_simd(positions, indices, face_count, normals)};
+    face_normals_scalar(positions, indices, simd_faces, face_count, normals);
+
+    // Scattered in order of faces, last face referencing a vertex wins
+    for (size_t face{}; face != face_count; ++face)
+    {
+        glm::vec3 const normal{normals.x[face],
+            normals.y[face],
+            normals.z[face]};
+
+        size_t const c{face * 3};
+        for (size_t k{}; k != 3; ++k)
+        {
+            vertices[is_indexed ? indices[c + k] : c + k].normal = normal;
+        }
+    }
+
+    for (auto& vertex : vertices)
+    {
+        vertex.normal = glm::normalize(vertex.normal);
+    }
+}
+
+std::vector<ngnast::mesh::detail::tangent_chunk_t>
+ngnast::mesh::detail::split_to_tangent_chunks(
+    std::span<vertex_t const> const vertices,
+    size_t const thread_count)
+{
+    size_t const face_count{vertices.size() / 3};
+    if (thread_count < 2 || face_count < 2 * min_chunk_faces)
+    {
+        return {};
+    }
+
+    size_t const chunk_faces{std::max(min_chunk_faces,
+        (face_count + thread_count - 1) / thread_count)};
+
+    vertex_faces_t const vertex_faces{weld_corners(vertices)};
+
+    std::vector<tangent_chunk_t> rv;
+    for (size_t first{}; first < face_count; first += chunk_faces)
+    {
+        size_t const last{std::min(first + chunk_faces, face_count)};
+
+        tangent_chunk_t chunk{.first_owned = cppext::narrow<uint32_t>(first),
+            .last_owned = cppext::narrow<uint32_t>(last)};
+        chunk.faces.resize(last - first);
+        std::iota(chunk.faces.begin(), chunk.faces.end(), chunk.first_owned);
+
+        // Boundary faces of neighbouring chunks are duplicated, tangents of
+        // their corners are discarded
+        for (size_t corner{first * 3}; corner != last * 3; ++corner)
+        {
+            std::ranges::copy_if(vertex_faces.of_corner(corner),
+                std::back_inserter(chunk.faces),
+                [&chunk](uint32_t const face)
+                {
+                    return face < chunk.first_owned ||
+                        face >= chunk.last_owned;
+                });
+        }
+
+        std::ranges::sort(chunk.faces);
+        auto const duplicates{std::ranges::unique(chunk.faces)};
+        chunk.faces.erase(duplicates.begin(), duplicates.end());
+
+        rv.push_back(std::move(chunk));
+    }
+
+    return rv;
+}
+
+bool ngnast::mesh::calculate_tangents(primitive_t& primitive,
+    BS::thread_pool<>* const thread_pool)
+{
+    std::vector<detail::tangent_chunk_t> const chunks{
+        detail::split_to_tangent_chunks(primitive.vertices,
+            thread_pool ? thread_pool->get_thread_count() : 1)};
+
+    if (chunks.empty())
+    {
+        auto const face_count{
+            cppext::narrow<uint32_t>(primitive.vertices.size() / 3)};
+
+        detail::tangent_chunk_t chunk{
+            .faces = std::vector<uint32_t>(face_count),
+            .last_owned = face_count};
+        std::iota(chunk.faces.begin(), chunk.faces.end(), uint32_t{0});
+
+        return generate_tangents(
+            {.vertices = primitive.vertices.data(), .chunk = &chunk});
+    }
+
+    // Chunks write tangents of disjoint faces, faces shared between chunks
+    // are only read
+    BS::multi_future<bool> futures{thread_pool->submit_sequence(size_t{},
+        chunks.size(),
+        [&chunks, vertices = primitive.vertices.data()](size_t const i)
+        {
+            return generate_tangents(
+                {.vertices = vertices, .chunk = &chunks[i]});
+        })};
+    futures.wait();
+
+    bool rv{true};
+    for (auto& future : futures)
+    {
+        rv = future.get() && rv;
+    }
+    return rv;
+}
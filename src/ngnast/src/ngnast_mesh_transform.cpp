@@ -6,9 +6,15 @@
 
 #include <meshoptimizer.h>
 
+#include <volk.h>
+
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <memory_resource>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -19,7 +25,7 @@ bool ngnast::mesh::make_unindexed(primitive_t& primitive)
         return false;
     }
 
-    std::vector<vertex_t> new_vertices;
+    std::pmr::vector<vertex_t> new_vertices{primitive.vertices.get_allocator()};
     new_vertices.reserve(primitive.indices.size());
     std::ranges::transform(primitive.indices,
         std::back_inserter(new_vertices),
@@ -55,7 +61,7 @@ bool ngnast::mesh::make_indexed(primitive_t& primitive)
         unindexed_vertex_count,
         sizeof(vertex_t))};
 
-    std::vector<vertex_t> new_vertices;
+    std::pmr::vector<vertex_t> new_vertices{primitive.vertices.get_allocator()};
     new_vertices.resize(vertex_count);
     meshopt_remapVertexBuffer(new_vertices.data(),
         primitive.vertices.data(),
@@ -72,3 +78,207 @@ bool ngnast::mesh::make_indexed(primitive_t& primitive)
 
     return true;
 }
+
+bool ngnast::mesh::optimize(primitive_t& primitive)
+{
+    if (primitive.topology != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST ||
+        primitive.indices.empty())
+    {
+        return false;
+    }
+
+    meshopt_optimizeVertexCache(primitive.indices.data(),
+        primitive.indices.data(),
+        primitive.indices.size(),
+        primitive.vertices.size());
+
+    meshopt_optimizeOverdraw(primitive.indices.data(),
+        primitive.indices.data(),
+        primitive.indices.size(),
+        &primitive.vertices[0].position[0],
+        primitive.vertices.size(),
+        sizeof(vertex_t),
+        1.05f);
+
+    size_t const vertex_count{meshopt_optimizeVertexFetch(
+        primitive.vertices.data(),
+        primitive.indices.data(),
+        primitive.indices.size(),
+        primitive.vertices.data(),
+        primitive.vertices.size(),
+        sizeof(vertex_t))};
+    primitive.vertices.resize(vertex_count);
+
+    return true;
+}
+
+bool ngnast::mesh::build_meshlets(primitive_t& primitive,
+    meshlet_options_t const& options)
+{
+    if (primitive.topology != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST ||
+        primitive.indices.size() < 3 || primitive.vertices.empty())
+    {
+        return false;
+    }
+
+    size_t const max_meshlets{meshopt_buildMeshletsBound(
+        primitive.indices.size(),
+        options.max_vertices,
+        options.max_triangles)};
+
+    std::vector<meshopt_Meshlet> meshlets(max_meshlets);
+    std::vector<unsigned int> meshlet_vertices(
+        max_meshlets * options.max_vertices);
+    std::vector<uint8_t> meshlet_triangles(
+        max_meshlets * options.max_triangles * 3);
+
+    size_t const meshlet_count{meshopt_buildMeshlets(meshlets.data(),
+        meshlet_vertices.data(),
+        meshlet_triangles.data(),
+        primitive.indices.data(),
+        primitive.indices.size(),
+        &primitive.vertices[0].position[0],
+        primitive.vertices.size(),
+        sizeof(vertex_t),
+        options.max_vertices,
+        options.max_triangles,
+        options.cone_weight)};
+    if (meshlet_count == 0)
+    {
+        return false;
+    }
+    meshlets.resize(meshlet_count);
+
+    // Triangles of each meshlet start at a four byte boundary
+    meshopt_Meshlet const& last{meshlets.back()};
+    meshlet_vertices.resize(last.vertex_offset + last.vertex_count);
+    meshlet_triangles.resize(
+        last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3u));
+
+    primitive.meshlets.clear();
+    primitive.meshlets.reserve(meshlet_count);
+    for (meshopt_Meshlet const& meshlet : meshlets)
+    {
+        meshopt_optimizeMeshlet(&meshlet_vertices[meshlet.vertex_offset],
+            &meshlet_triangles[meshlet.triangle_offset],
+            meshlet.triangle_count,
+            meshlet.vertex_count);
+
+        meshopt_Bounds const bounds{meshopt_computeMeshletBounds(
+            &meshlet_vertices[meshlet.vertex_offset],
+            &meshlet_triangles[meshlet.triangle_offset],
+            meshlet.triangle_count,
+            &primitive.vertices[0].position[0],
+            primitive.vertices.size(),
+            sizeof(vertex_t))};
+
+        primitive.meshlets.push_back({.vertex_offset = meshlet.vertex_offset,
+            .triangle_offset = meshlet.triangle_offset,
+            .vertex_count = meshlet.vertex_count,
+            .triangle_count = meshlet.triangle_count,
+            .center = {bounds.center[0], bounds.center[1], bounds.center[2]},
+            .radius = bounds.radius,
+            .cone_apex = {bounds.cone_apex[0],
+                bounds.cone_apex[1],
+                bounds.cone_apex[2]},
+            .cone_axis = {bounds.cone_axis[0],
+                bounds.cone_axis[1],
+                bounds.cone_axis[2]},
+            .cone_cutoff = bounds.cone_cutoff});
+    }
+
+    // Buffers were sized for the worst case, only the used part is kept by
+    // the primitive
+    primitive.meshlet_vertices.assign(meshlet_vertices.cbegin(),
+        meshlet_vertices.cend());
+    primitive.meshlet_triangles.assign(meshlet_triangles.cbegin(),
+        meshlet_triangles.cend());
+
+    return true;
+}
+
+bool ngnast::mesh::generate_lods(primitive_t& primitive,
+    lod_options_t const& options)
+{
+    if (primitive.topology != VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST ||
+        primitive.indices.empty())
+    {
+        return false;
+    }
+
+    float const* const positions{&primitive.vertices[0].position[0]};
+    float const scale{meshopt_simplifyScale(positions,
+        primitive.vertices.size(),
+        sizeof(vertex_t))};
+
+    // Normals contribute to the error so that shading discontinuities
+    // aren't collapsed
+    std::array const normal_weights{0.5f, 0.5f, 0.5f};
+
+    primitive.lods.clear();
+    primitive.lods.reserve(options.max_lods);
+
+    // Simplification writes up to the source index count, levels are copied
+    // out at their final size
+    std::vector<unsigned int> simplified(primitive.indices.size());
+    auto const allocator{primitive.lods.get_allocator()};
+
+    std::span<unsigned int const> source{primitive.indices};
+    float source_error{};
+    while (primitive.lods.size() != options.max_lods)
+    {
+        auto const target_count{
+            static_cast<size_t>(
+                static_cast<float>(source.size()) * options.reduction) /
+            3 * 3};
+        if (target_count < 3)
+        {
+            break;
+        }
+
+        float relative_error{};
+        size_t const index_count{meshopt_simplifyWithAttributes(
+            simplified.data(),
+            source.data(),
+            source.size(),
+            positions,
+            primitive.vertices.size(),
+            sizeof(vertex_t),
+            &primitive.vertices[0].normal[0],
+            sizeof(vertex_t),
+            normal_weights.data(),
+            normal_weights.size(),
+            nullptr,
+            target_count,
+            options.max_error,
+            0,
+            &relative_error)};
+
+        // Level which doesn't reduce the triangle count noticeably isn't
+        // worth the memory
+        if (index_count == 0 ||
+            static_cast<float>(index_count) >
+                static_cast<float>(source.size()) * 0.95f)
+        {
+            break;
+        }
+
+        meshopt_optimizeVertexCache(simplified.data(),
+            simplified.data(),
+            index_count,
+            primitive.vertices.size());
+
+        // Errors are relative to the previous level, accumulate them to get
+        // a conservative bound on the distance from full detail
+        source_error += relative_error * scale;
+
+        std::span<unsigned int const> const level{simplified.data(),
+            index_count};
+        primitive.lods.push_back(
+            {.indices{level.begin(), level.end(), allocator},
+                .error = source_error});
+        source = primitive.lods.back().indices;
+    }
+
+    return !primitive.lods.empty();
+}
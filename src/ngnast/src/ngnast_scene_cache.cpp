@@ -0,0 +1,881 @@
+#include <ngnast_scene_cache.hpp>
+
+#include <ngnast_error.hpp>
+#include <ngnast_scene_model.hpp>
+
+#include <cppext_mapped_file.hpp>
+#include <cppext_numeric.hpp>
+
+#include <vkrndr_sampler.hpp>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <volk.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <ios>
+#include <limits>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// IWYU pragma: no_include <glm/detail/qualifier.hpp>
+
+// Cooked file layout, all values are stored in native byte order:
+//   header: magic, version, key
+//   dependencies
+//   samplers, images, textures, materials, primitives, meshes, nodes, scenes
+// Variable sized data is prefixed with an element count. Enumerations and
+// bools are validated when read, optionals are stored as a bool followed by
+// the value.
+
+namespace
+{
+    constexpr std::array<char, 8> magic{'N', 'G', 'N', 'A', 'S', 'T', 'C', 0};
+
+    // Increment when layout of the file or of any stored type changes
+    constexpr uint32_t version{4};
+
+    constexpr uint64_t no_index{std::numeric_limits<uint64_t>::max()};
+
+    static_assert(sizeof(size_t) == sizeof(uint64_t));
+
+    class [[nodiscard]] writer_t final
+    {
+    public:
+        explicit writer_t(std::ostream& stream) : stream_{&stream} { }
+
+    public:
+        template<typename T>
+        requires(std::is_trivially_copyable_v<T>)
+        void value(T const& v)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            stream_->write(reinterpret_cast<char const*>(&v), sizeof(T));
+        }
+
+        template<typename T>
+        requires(std::is_trivially_copyable_v<T>)
+        void values(std::span<T const> const& v)
+        {
+            value(uint64_t{v.size()});
+            bytes(std::as_bytes(v));
+        }
+
+        void bytes(std::span<std::byte const> const& v)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            stream_->write(reinterpret_cast<char const*>(v.data()),
+                cppext::narrow<std::streamsize>(v.size()));
+        }
+
+        void string(std::string_view const v)
+        {
+            values(std::span{v.data(), v.size()});
+        }
+
+        void boolean(bool const v) { value(uint8_t{v}); }
+
+        template<typename T>
+        requires(std::is_trivially_copyable_v<T>)
+        void optional(std::optional<T> const& v)
+        {
+            boolean(v.has_value());
+            value(v.value_or(T{}));
+        }
+
+        void index(std::optional<size_t> const& v)
+        {
+            value(v ? uint64_t{*v} : no_index);
+        }
+
+    private:
+        std::ostream* stream_;
+    };
+
+    class [[nodiscard]] reader_t final
+    {
+    public:
+        explicit reader_t(std::span<std::byte const> const& data)
+            : data_{data}
+        {
+        }
+
+    public:
+        template<typename T>
+        requires(std::is_trivially_copyable_v<T>)
+        [[nodiscard]] T value()
+        {
+            T rv{};
+            bytes(std::as_writable_bytes(std::span{&rv, 1}));
+            return rv;
+        }
+
+        // Element count of data that follows, every element takes at least
+        // one byte in the file
+        [[nodiscard]] size_t count(size_t const element_size = 1)
+        {
+            auto const rv{value<uint64_t>()};
+            if (rv > data_.size() / element_size)
+            {
+                throw std::system_error{
+                    make_error_code(ngnast::error_t::parse_failed)};
+            }
+            return rv;
+        }
+
+        template<typename T>
+        requires(std::is_trivially_copyable_v<T>)
+        [[nodiscard]] std::vector<T> values()
+        {
+            std::vector<T> rv(count(sizeof(T)));
+            bytes(std::as_writable_bytes(std::span{rv}));
+            return rv;
+        }
+
+        template<typename T>
+        requires(std::is_trivially_copyable_v<T>)
+        [[nodiscard]] std::pmr::vector<T> values(
+            std::pmr::memory_resource* const resource)
+        {
+            std::pmr::vector<T> rv(count(sizeof(T)), resource);
+            bytes(std::as_writable_bytes(std::span{rv}));
+            return rv;
+        }
+
+        void bytes(std::span<std::byte> const& v)
+        {
+            if (v.size() > data_.size())
+            {
+                throw std::system_error{
+                    make_error_code(ngnast::error_t::parse_failed)};
+            }
+
+            if (!v.empty())
+            {
+                std::memcpy(v.data(), data_.data(), v.size());
+                data_ = data_.subspan(v.size());
+            }
+        }
+
+        [[nodiscard]] bool boolean()
+        {
+            auto const rv{value<uint8_t>()};
+            if (rv > 1)
+            {
+                throw std::system_error{
+                    make_error_code(ngnast::error_t::parse_failed)};
+            }
+            return rv == 1;
+        }
+
+        // Accepts only one of the listed enumerators
+        template<typename T>
+        requires(std::is_enum_v<T>)
+        [[nodiscard]] T enumeration(std::initializer_list<T> const valid)
+        {
+            auto const rv{value<T>()};
+            if (std::ranges::find(valid, rv) == valid.end())
+            {
+                throw std::system_error{
+                    make_error_code(ngnast::error_t::parse_failed)};
+            }
+            return rv;
+        }
+
+        // Accepts enumerators in the contiguous range [first, last]
+        template<typename T>
+        requires(std::is_enum_v<T>)
+        [[nodiscard]] T enumeration(T const first, T const last)
+        {
+            auto const rv{value<T>()};
+            if (std::to_underlying(rv) < std::to_underlying(first) ||
+                std::to_underlying(rv) > std::to_underlying(last))
+            {
+                throw std::system_error{
+                    make_error_code(ngnast::error_t::parse_failed)};
+            }
+            return rv;
+        }
+
+        [[nodiscard]] std::pmr::string string(
+            std::pmr::memory_resource* const resource)
+        {
+            std::pmr::string rv(count(), '\0', resource);
+            bytes(std::as_writable_bytes(std::span{rv}));
+            return rv;
+        }
+
+        [[nodiscard]] std::optional<size_t> index()
+        {
+            if (auto const rv{value<uint64_t>()}; rv != no_index)
+            {
+                return rv;
+            }
+            return std::nullopt;
+        }
+
+    private:
+        std::span<std::byte const> data_;
+    };
+
+    [[nodiscard]] std::optional<size_t> texture_index(
+        ngnast::scene_model_t const& model,
+        ngnast::texture_t const* const texture)
+    {
+        if (texture == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        return cppext::narrow<size_t>(texture - model.textures.data());
+    }
+
+    [[nodiscard]] ngnast::texture_t* texture_pointer(
+        ngnast::scene_model_t& model,
+        std::optional<size_t> const& index)
+    {
+        if (!index)
+        {
+            return nullptr;
+        }
+
+        if (*index >= model.textures.size())
+        {
+            throw std::system_error{
+                make_error_code(ngnast::error_t::parse_failed)};
+        }
+
+        return &model.textures[*index];
+    }
+
+    void write_samplers(writer_t& writer, ngnast::scene_model_t const& model)
+    {
+        writer.value(uint64_t{model.samplers.size()});
+        for (vkrndr::sampler_properties_t const& sampler : model.samplers)
+        {
+            writer.value(sampler.magnification_filter);
+            writer.value(sampler.minification_filter);
+            writer.value(sampler.mipmap_mode);
+            writer.value(sampler.address_mode_u);
+            writer.value(sampler.address_mode_v);
+            writer.value(sampler.address_mode_w);
+            writer.value(sampler.mip_lod_bias);
+            writer.optional(sampler.max_anisotropy);
+            writer.optional(sampler.compare_op);
+            writer.value(sampler.min_lod);
+            writer.value(sampler.max_lod);
+            writer.value(sampler.border_color);
+            writer.boolean(sampler.unnormalized_coordinates);
+        }
+    }
+
+    [[nodiscard]] VkFilter read_filter(reader_t& reader)
+    {
+        return reader.enumeration(
+            {VK_FILTER_NEAREST, VK_FILTER_LINEAR, VK_FILTER_CUBIC_EXT});
+    }
+
+    [[nodiscard]] VkSamplerAddressMode read_address_mode(reader_t& reader)
+    {
+        return reader.enumeration(VK_SAMPLER_ADDRESS_MODE_REPEAT,
+            VK_SAMPLER_ADDRESS_MODE_MIRROR_CLAMP_TO_EDGE);
+    }
+
+    void read_samplers(reader_t& reader, ngnast::scene_model_t& model)
+    {
+        size_t const count{reader.count()};
+        model.samplers.reserve(count);
+        for (size_t i{}; i != count; ++i)
+        {
+            vkrndr::sampler_properties_t sampler{
+                .magnification_filter = read_filter(reader),
+                .minification_filter = read_filter(reader),
+                .mipmap_mode = reader.enumeration(
+                    VK_SAMPLER_MIPMAP_MODE_NEAREST,
+                    VK_SAMPLER_MIPMAP_MODE_LINEAR),
+                .address_mode_u = read_address_mode(reader),
+                .address_mode_v = read_address_mode(reader),
+                .address_mode_w = read_address_mode(reader),
+                .mip_lod_bias = reader.value<float>(),
+            };
+
+            bool const has_max_anisotropy{reader.boolean()};
+            auto const max_anisotropy{reader.value<float>()};
+            if (has_max_anisotropy)
+            {
+                sampler.max_anisotropy = max_anisotropy;
+            }
+
+            bool const has_compare_op{reader.boolean()};
+            auto const compare_op{reader.enumeration(VK_COMPARE_OP_NEVER,
+                VK_COMPARE_OP_ALWAYS)};
+            if (has_compare_op)
+            {
+                sampler.compare_op = compare_op;
+            }
+
+            sampler.min_lod = reader.value<float>();
+            sampler.max_lod = reader.value<float>();
+            sampler.border_color =
+                reader.enumeration(VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK,
+                    VK_BORDER_COLOR_INT_OPAQUE_WHITE);
+            sampler.unnormalized_coordinates = reader.boolean();
+
+            model.samplers.push_back(sampler);
+        }
+    }
+
+    void write_images(writer_t& writer, ngnast::scene_model_t const& model)
+    {
+        writer.value(uint64_t{model.images.size()});
+        for (ngnast::image_t const& image : model.images)
+        {
+            writer.value(image.format);
+            writer.values(std::span{image.mip_levels});
+            writer.value(uint64_t{image.data_size});
+            writer.bytes({image.data.get(), image.data_size});
+        }
+    }
+
+    void read_images(reader_t& reader, ngnast::scene_model_t& model)
+    {
+        size_t const count{reader.count()};
+        model.images.reserve(count);
+        for (size_t i{}; i != count; ++i)
+        {
+            ngnast::image_t image{
+                .data = std::unique_ptr<std::byte[], void (*)(std::byte*)>{
+                    nullptr,
+                    [](std::byte* const p)
+                    {
+                        delete[] p; // NOLINT(cppcoreguidelines-owning-memory)
+                    }},
+                .format = reader.value<VkFormat>(),
+                .mip_levels = reader.values<ngnast::image_mip_level_t>(),
+            };
+
+            image.data_size = reader.count();
+            // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+            image.data.reset(new std::byte[image.data_size]);
+            reader.bytes({image.data.get(), image.data_size});
+
+            model.images.push_back(std::move(image));
+        }
+    }
+
+    void write_textures(writer_t& writer, ngnast::scene_model_t const& model)
+    {
+        writer.value(uint64_t{model.textures.size()});
+        for (ngnast::texture_t const& texture : model.textures)
+        {
+            writer.string(texture.name);
+            writer.value(uint64_t{texture.image_indices.size()});
+            for (auto const& [type, index] : texture.image_indices)
+            {
+                writer.value(type);
+                writer.value(uint64_t{index});
+            }
+            writer.value(uint64_t{texture.sampler_index});
+        }
+    }
+
+    void read_textures(reader_t& reader, ngnast::scene_model_t& model)
+    {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
+        size_t const count{reader.count()};
+        model.textures.reserve(count);
+        for (size_t i{}; i != count; ++i)
+        {
+            ngnast::texture_t texture{.name = reader.string(resource),
+                .image_indices{resource}};
+
+            size_t const image_count{reader.count()};
+            for (size_t j{}; j != image_count; ++j)
+            {
+                auto const type{
+                    reader.enumeration(ngnast::texture_image_type_t::regular,
+                        ngnast::texture_image_type_t::basisu)};
+                texture.image_indices.emplace(type, reader.value<uint64_t>());
+            }
+            texture.sampler_index = reader.value<uint64_t>();
+
+            model.textures.push_back(std::move(texture));
+        }
+    }
+
+    void write_materials(writer_t& writer, ngnast::scene_model_t const& model)
+    {
+        writer.value(uint64_t{model.materials.size()});
+        for (ngnast::material_t const& material : model.materials)
+        {
+            auto const& pbr{material.pbr_metallic_roughness};
+
+            writer.string(material.name);
+            writer.value(pbr.base_color_factor);
+            writer.index(texture_index(model, pbr.base_color_texture));
+            writer.index(texture_index(model, pbr.metallic_roughness_texture));
+            writer.value(pbr.metallic_factor);
+            writer.value(pbr.roughness_factor);
+            writer.index(texture_index(model, material.normal_texture));
+            writer.index(texture_index(model, material.emissive_texture));
+            writer.index(texture_index(model, material.occlusion_texture));
+            writer.value(material.normal_scale);
+            writer.value(material.emissive_factor);
+            writer.value(material.emissive_strength);
+            writer.value(material.occlusion_strength);
+            writer.value(material.alpha_mode);
+            writer.value(material.alpha_cutoff);
+            writer.boolean(material.double_sided);
+        }
+    }
+
+    void read_materials(reader_t& reader, ngnast::scene_model_t& model)
+    {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
+        size_t const count{reader.count()};
+        model.materials.reserve(count);
+        for (size_t i{}; i != count; ++i)
+        {
+            ngnast::material_t material{.name = reader.string(resource)};
+            auto& pbr{material.pbr_metallic_roughness};
+
+            pbr.base_color_factor = reader.value<glm::vec4>();
+            pbr.base_color_texture = texture_pointer(model, reader.index());
+            pbr.metallic_roughness_texture =
+                texture_pointer(model, reader.index());
+            pbr.metallic_factor = reader.value<float>();
+            pbr.roughness_factor = reader.value<float>();
+            material.normal_texture = texture_pointer(model, reader.index());
+            material.emissive_texture = texture_pointer(model, reader.index());
+            material.occlusion_texture = texture_pointer(model, reader.index());
+            material.normal_scale = reader.value<float>();
+            material.emissive_factor = reader.value<glm::vec3>();
+            material.emissive_strength = reader.value<float>();
+            material.occlusion_strength = reader.value<float>();
+            material.alpha_mode =
+                reader.enumeration({ngnast::alpha_mode_t::opaque,
+                    ngnast::alpha_mode_t::mask,
+                    ngnast::alpha_mode_t::blend});
+            material.alpha_cutoff = reader.value<float>();
+            material.double_sided = reader.boolean();
+
+            model.materials.push_back(std::move(material));
+        }
+    }
+
+    void write_primitives(writer_t& writer, ngnast::scene_model_t const& model)
+    {
+        writer.value(uint64_t{model.primitives.size()});
+        for (ngnast::primitive_t const& primitive : model.primitives)
+        {
+            writer.value(primitive.topology);
+            writer.values(std::span{primitive.vertices});
+            writer.values(std::span{primitive.indices});
+            writer.index(primitive.material_index);
+            writer.value(primitive.bounding_box);
+            writer.values(std::span{primitive.meshlets});
+            writer.values(std::span{primitive.meshlet_vertices});
+            writer.values(std::span{primitive.meshlet_triangles});
+
+            writer.value(uint64_t{primitive.lods.size()});
+            for (ngnast::lod_t const& lod : primitive.lods)
+            {
+                writer.values(std::span{lod.indices});
+                writer.value(lod.error);
+            }
+        }
+    }
+
+    void read_primitives(reader_t& reader, ngnast::scene_model_t& model)
+    {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
+        size_t const count{reader.count()};
+        model.primitives.reserve(count);
+        for (size_t i{}; i != count; ++i)
+        {
+            ngnast::primitive_t primitive{
+                .topology = reader.enumeration(VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
+                    VK_PRIMITIVE_TOPOLOGY_PATCH_LIST),
+                .vertices = reader.values<ngnast::vertex_t>(resource),
+                .indices = reader.values<unsigned int>(resource),
+                .material_index = reader.index(),
+                .bounding_box = reader.value<ngnast::bounding_box_t>(),
+                .meshlets = reader.values<ngnast::meshlet_t>(resource),
+                .meshlet_vertices = reader.values<unsigned int>(resource),
+                .meshlet_triangles = reader.values<uint8_t>(resource),
+                .lods{resource},
+            };
+
+            size_t const lod_count{reader.count()};
+            primitive.lods.reserve(lod_count);
+            for (size_t j{}; j != lod_count; ++j)
+            {
+                ngnast::lod_t lod{
+                    .indices = reader.values<unsigned int>(resource),
+                    .error = reader.value<float>()};
+                primitive.lods.push_back(std::move(lod));
+            }
+
+            model.primitives.push_back(std::move(primitive));
+        }
+    }
+
+    void write_meshes(writer_t& writer, ngnast::scene_model_t const& model)
+    {
+        writer.value(uint64_t{model.meshes.size()});
+        for (ngnast::mesh_t const& mesh : model.meshes)
+        {
+            writer.string(mesh.name);
+            writer.values(std::span{mesh.primitive_indices});
+            writer.value(mesh.bounding_box);
+        }
+    }
+
+    void read_meshes(reader_t& reader, ngnast::scene_model_t& model)
+    {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
+        size_t const count{reader.count()};
+        model.meshes.reserve(count);
+        for (size_t i{}; i != count; ++i)
+        {
+            ngnast::mesh_t mesh{
+                .name = reader.string(resource),
+                .primitive_indices = reader.values<size_t>(resource),
+                .bounding_box = reader.value<ngnast::bounding_box_t>(),
+            };
+
+            model.meshes.push_back(std::move(mesh));
+        }
+    }
+
+    void write_nodes(writer_t& writer, ngnast::scene_model_t const& model)
+    {
+        writer.value(uint64_t{model.nodes.size()});
+        for (ngnast::node_t const& node : model.nodes)
+        {
+            writer.string(node.name);
+            writer.index(node.mesh_index);
+            writer.value(node.matrix);
+            writer.value(node.aabb);
+            writer.values(std::span{node.child_indices});
+        }
+    }
+
+    void read_nodes(reader_t& reader, ngnast::scene_model_t& model)
+    {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
+        size_t const count{reader.count()};
+        model.nodes.reserve(count);
+        for (size_t i{}; i != count; ++i)
+        {
+            ngnast::node_t node{
+                .name = reader.string(resource),
+                .mesh_index = reader.index(),
+                .matrix = reader.value<glm::mat4>(),
+                .aabb = reader.value<ngnast::bounding_box_t>(),
+                .child_indices = reader.values<size_t>(resource),
+            };
+
+            model.nodes.push_back(std::move(node));
+        }
+    }
+
+    void write_scenes(writer_t& writer, ngnast::scene_model_t const& model)
+    {
+        writer.value(uint64_t{model.scenes.size()});
+        for (ngnast::scene_graph_t const& scene : model.scenes)
+        {
+            writer.string(scene.name);
+            writer.values(std::span{scene.root_indices});
+        }
+    }
+
+    void read_scenes(reader_t& reader, ngnast::scene_model_t& model)
+    {
+        std::pmr::memory_resource* const resource{model.arena.resource()};
+
+        size_t const count{reader.count()};
+        model.scenes.reserve(count);
+        for (size_t i{}; i != count; ++i)
+        {
+            ngnast::scene_graph_t scene{
+                .name = reader.string(resource),
+                .root_indices = reader.values<size_t>(resource),
+            };
+
+            model.scenes.push_back(std::move(scene));
+        }
+    }
+
+    void check(bool const valid)
+    {
+        if (!valid)
+        {
+            throw std::system_error{
+                make_error_code(ngnast::error_t::parse_failed)};
+        }
+    }
+
+    void check_indices(std::span<unsigned int const> const indices,
+        size_t const count)
+    {
+        check(indices.empty() || std::ranges::max(indices) < count);
+    }
+
+    // Sections are read in order of their dependencies, indices between
+    // them are validated once all of them are read. A file passing the
+    // dependency check can still be truncated or corrupted, users of the
+    // model index into sections without bounds checks.
+    void validate_indices(ngnast::scene_model_t const& model)
+    {
+        for (ngnast::texture_t const& texture : model.textures)
+        {
+            for (size_t const index :
+                texture.image_indices | std::views::values)
+            {
+                check(index < model.images.size());
+            }
+            check(texture.sampler_index < model.samplers.size());
+        }
+
+        for (ngnast::primitive_t const& primitive : model.primitives)
+        {
+            if (primitive.material_index)
+            {
+                check(*primitive.material_index < model.materials.size());
+            }
+
+            check_indices(primitive.indices, primitive.vertices.size());
+            for (ngnast::lod_t const& lod : primitive.lods)
+            {
+                check_indices(lod.indices, primitive.vertices.size());
+            }
+        }
+
+        for (ngnast::mesh_t const& mesh : model.meshes)
+        {
+            for (size_t const index : mesh.primitive_indices)
+            {
+                check(index < model.primitives.size());
+            }
+        }
+
+        // Nodes form a forest, every node has at most one parent and roots
+        // have none. Cycles can't be reached from roots then.
+        std::vector<uint8_t> has_parent(model.nodes.size());
+        for (ngnast::node_t const& node : model.nodes)
+        {
+            if (node.mesh_index)
+            {
+                check(*node.mesh_index < model.meshes.size());
+            }
+
+            for (size_t const index : node.child_indices)
+            {
+                check(index < model.nodes.size() && !has_parent[index]);
+                has_parent[index] = 1;
+            }
+        }
+
+        for (ngnast::scene_graph_t const& scene : model.scenes)
+        {
+            for (size_t const index : scene.root_indices)
+            {
+                check(index < model.nodes.size() && !has_parent[index]);
+            }
+        }
+    }
+
+    [[nodiscard]] bool is_up_to_date(ngnast::cache::dependency_t const& stored)
+    {
+        std::expected<ngnast::cache::dependency_t, std::error_code> const
+            current{ngnast::cache::make_dependency(stored.path)};
+
+        return current && current->size == stored.size &&
+            current->last_write_time == stored.last_write_time;
+    }
+} // namespace
+
+std::expected<ngnast::cache::dependency_t, std::error_code>
+ngnast::cache::make_dependency(std::filesystem::path const& path)
+{
+    std::error_code ec;
+
+    uintmax_t const size{file_size(path, ec)};
+    if (ec)
+    {
+        return std::unexpected{ec};
+    }
+
+    std::filesystem::file_time_type const time{last_write_time(path, ec)};
+    if (ec)
+    {
+        return std::unexpected{ec};
+    }
+
+    return dependency_t{.path = path,
+        .size = size,
+        .last_write_time =
+            cppext::narrow<int64_t>(time.time_since_epoch().count())};
+}
+
+std::filesystem::path ngnast::cache::cooked_path(
+    std::filesystem::path const& source)
+{
+    std::filesystem::path rv{source};
+    rv += ".ngnast";
+    return rv;
+}
+
+std::expected<ngnast::scene_model_t, std::error_code> ngnast::cache::read(
+    std::filesystem::path const& cooked,
+    cache_key_t const& key)
+{
+    try
+    {
+        // Throws std::system_error when the file can't be opened or mapped
+        cppext::mapped_file_t file{cooked};
+        file.advise(cppext::access_hint_t::sequential);
+
+        reader_t reader{file.bytes()};
+
+        if (reader.value<std::remove_cvref_t<decltype(magic)>>() != magic ||
+            reader.value<uint32_t>() != version ||
+            reader.value<cache_key_t>() != key)
+        {
+            return std::unexpected{make_error_code(error_t::cache_mismatch)};
+        }
+
+        size_t const dependency_count{reader.count()};
+        for (size_t i{}; i != dependency_count; ++i)
+        {
+            std::vector<char8_t> const path{reader.values<char8_t>()};
+            dependency_t const dependency{
+                .path = std::u8string{path.cbegin(), path.cend()},
+                .size = reader.value<uint64_t>(),
+                .last_write_time = reader.value<int64_t>(),
+            };
+
+            if (!is_up_to_date(dependency))
+            {
+                return std::unexpected{
+                    make_error_code(error_t::cache_mismatch)};
+            }
+        }
+
+        scene_model_t rv;
+        read_samplers(reader, rv);
+        read_images(reader, rv);
+        read_textures(reader, rv);
+        read_materials(reader, rv);
+        read_primitives(reader, rv);
+        read_meshes(reader, rv);
+        read_nodes(reader, rv);
+        read_scenes(reader, rv);
+
+        validate_indices(rv);
+
+        return rv;
+    }
+    catch (std::system_error const& ex)
+    {
+        return std::unexpected{ex.code()};
+    }
+    catch (std::exception const&)
+    {
+        return std::unexpected{make_error_code(error_t::unknown)};
+    }
+}
+
+std::expected<void, std::error_code> ngnast::cache::write(
+    std::filesystem::path const& cooked,
+    cache_key_t const& key,
+    std::span<dependency_t const> const& dependencies,
+    scene_model_t const& model)
+{
+    // Write to a temporary file and replace the previous one only when
+    // everything is written, readers never observe a partially written file
+    std::filesystem::path temporary{cooked};
+    temporary += ".tmp";
+
+    {
+        std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+        if (!stream.is_open())
+        {
+            return std::unexpected{make_error_code(error_t::export_failed)};
+        }
+
+        writer_t writer{stream};
+
+        writer.value(magic);
+        writer.value(version);
+        writer.value(key);
+
+        writer.value(uint64_t{dependencies.size()});
+        for (dependency_t const& dependency : dependencies)
+        {
+            std::u8string const path{dependency.path.u8string()};
+            writer.values(std::span{path.data(), path.size()});
+            writer.value(uint64_t{dependency.size});
+            writer.value(dependency.last_write_time);
+        }
+
+        write_samplers(writer, model);
+        write_images(writer, model);
+        write_textures(writer, model);
+        write_materials(writer, model);
+        write_primitives(writer, model);
+        write_meshes(writer, model);
+        write_nodes(writer, model);
+        write_scenes(writer, model);
+
+        stream.flush();
+        if (!stream)
+        {
+            stream.close();
+
+            std::error_code ec;
+            remove(temporary, ec);
+
+            return std::unexpected{make_error_code(error_t::export_failed)};
+        }
+    }
+
+    std::error_code ec;
+    rename(temporary, cooked, ec);
+    if (ec)
+    {
+        std::error_code remove_ec;
+        remove(temporary, remove_ec);
+
+        return std::unexpected{ec};
+    }
+
+    return {};
+}
@@ -7,9 +7,54 @@
 #include <glm/mat4x4.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
 
 namespace
 {
+    // First block of the arena, subsequent blocks grow geometrically
+    constexpr size_t initial_arena_size{64 * 1024};
+
+    class [[nodiscard]] counting_resource_t final
+        : public std::pmr::memory_resource
+    {
+    public:
+        [[nodiscard]] ngnast::arena_statistics_t const& statistics() const
+        {
+            return statistics_;
+        }
+
+    private:
+        void* do_allocate(size_t const bytes, size_t const alignment) override
+        {
+            void* const rv{upstream_->allocate(bytes, alignment)};
+
+            ++statistics_.allocations;
+            statistics_.allocated_bytes += bytes;
+
+            return rv;
+        }
+
+        void do_deallocate(void* const p,
+            size_t const bytes,
+            size_t const alignment) override
+        {
+            upstream_->deallocate(p, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(
+            std::pmr::memory_resource const& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        std::pmr::memory_resource* upstream_{
+            std::pmr::new_delete_resource()};
+        ngnast::arena_statistics_t statistics_;
+    };
     void calculate_node_matrices(ngnast::scene_model_t& model,
         ngnast::node_t& node,
         glm::mat4 const& matrix)
@@ -42,6 +87,35 @@ namespace
     }
 } // namespace
 
+struct [[nodiscard]] ngnast::arena_t::impl_t final
+{
+    counting_resource_t upstream;
+    std::pmr::monotonic_buffer_resource resource{initial_arena_size,
+        &upstream};
+};
+
+ngnast::arena_t::arena_t() : impl_{std::make_unique<impl_t>()} { }
+
+ngnast::arena_t::arena_t(arena_t&& other) noexcept = default;
+
+ngnast::arena_t::~arena_t() = default;
+
+std::pmr::memory_resource* ngnast::arena_t::resource() const
+{
+    return impl_ ? &impl_->resource : std::pmr::get_default_resource();
+}
+
+ngnast::arena_statistics_t ngnast::arena_t::statistics() const
+{
+    return impl_ ? impl_->upstream.statistics() : arena_statistics_t{};
+}
+
+ngnast::arena_t& ngnast::arena_t::operator=(arena_t&& other) noexcept
+{
+    std::swap(impl_, other.impl_);
+    return *this;
+}
+
 ngnast::bounding_box_t ngnast::calculate_aabb(bounding_box_t const& box,
     glm::mat4 const& matrix)
 {
@@ -0,0 +1,197 @@
+#include <ngnast_transform_hierarchy.hpp>
+
+#include <ngnast_scene_model.hpp>
+
+#include <cppext_numeric.hpp>
+
+#include <glm/mat4x4.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+// IWYU pragma: no_include <ranges>
+
+namespace
+{
+    // Subtrees smaller than this aren't split further between threads
+    constexpr uint32_t min_task_nodes{256};
+
+    struct [[nodiscard]] range_t final
+    {
+        uint32_t first;
+        uint32_t last;
+    };
+
+    void append_subtree(ngnast::scene_model_t const& model,
+        size_t const root,
+        ngnast::transform_hierarchy_t& hierarchy)
+    {
+        // Pairs of node index and position of its parent
+        std::vector<std::pair<size_t, uint32_t>> stack{
+            {root, ngnast::transform_hierarchy_t::no_parent}};
+        while (!stack.empty())
+        {
+            auto const [index, parent]{stack.back()};
+            stack.pop_back();
+
+            auto const position{
+                cppext::narrow<uint32_t>(hierarchy.node_indices.size())};
+            hierarchy.positions[index] = position;
+            hierarchy.parents.push_back(parent);
+            hierarchy.node_indices.push_back(index);
+            hierarchy.local_matrices.push_back(model.nodes[index].matrix);
+
+            // Pushed in reverse so that children keep their order
+            auto const& children{model.nodes[index].child_indices};
+            for (auto it{children.rbegin()}; it != children.rend(); ++it)
+            {
+                stack.emplace_back(*it, position);
+            }
+        }
+    }
+
+    // Positions are in depth first order, the loop visits each node after
+    // its parent
+    void propagate(ngnast::transform_hierarchy_t& hierarchy,
+        range_t const range)
+    {
+        std::span const parents{hierarchy.parents};
+        std::span const local{hierarchy.local_matrices};
+        std::span const world{hierarchy.world_matrices};
+        std::span const dirty{hierarchy.dirty};
+
+        for (uint32_t i{range.first}; i != range.last; ++i)
+        {
+            uint32_t const parent{parents[i]};
+            if (parent == ngnast::transform_hierarchy_t::no_parent)
+            {
+                if (dirty[i])
+                {
+                    world[i] = local[i];
+                }
+            }
+            else if (dirty[i] || dirty[parent])
+            {
+                world[i] = world[parent] * local[i];
+                // Descendants of a changed node change too
+                dirty[i] = 1;
+            }
+        }
+    }
+} // namespace
+
+ngnast::transform_hierarchy_t ngnast::flatten_hierarchy(
+    scene_model_t const& model)
+{
+    transform_hierarchy_t rv;
+    rv.positions.resize(model.nodes.size(), transform_hierarchy_t::no_position);
+    rv.parents.reserve(model.nodes.size());
+    rv.node_indices.reserve(model.nodes.size());
+    rv.local_matrices.reserve(model.nodes.size());
+
+    for (scene_graph_t const& scene : model.scenes)
+    {
+        for (size_t const root : scene.root_indices)
+        {
+            if (rv.positions[root] == transform_hierarchy_t::no_position)
+            {
+                append_subtree(model, root, rv);
+            }
+        }
+    }
+
+    size_t const count{rv.node_indices.size()};
+
+    // Accumulated in reverse order, children are visited before parents
+    rv.subtree_sizes.resize(count, 1);
+    for (size_t i{count}; i-- != 0;)
+    {
+        if (rv.parents[i] != transform_hierarchy_t::no_parent)
+        {
+            rv.subtree_sizes[rv.parents[i]] += rv.subtree_sizes[i];
+        }
+    }
+
+    rv.world_matrices.resize(count, glm::mat4{1.0f});
+    rv.dirty.resize(count, 1);
+
+    return rv;
+}
+
+void ngnast::set_local_matrix(transform_hierarchy_t& hierarchy,
+    uint32_t const position,
+    glm::mat4 const& matrix)
+{
+    hierarchy.local_matrices[position] = matrix;
+    hierarchy.dirty[position] = 1;
+}
+
+void ngnast::update_world_matrices(transform_hierarchy_t& hierarchy,
+    BS::thread_pool<>* const thread_pool)
+{
+    auto const count{cppext::narrow<uint32_t>(hierarchy.parents.size())};
+
+    if (!thread_pool || thread_pool->get_thread_count() < 2 ||
+        count < 2 * min_task_nodes)
+    {
+        propagate(hierarchy, {0, count});
+    }
+    else
+    {
+        uint32_t const task_nodes{std::max(min_task_nodes,
+            count / cppext::narrow<uint32_t>(thread_pool->get_thread_count()))};
+
+        // Nodes with large subtrees are updated in order on this thread,
+        // remaining subtrees hang off of them and don't depend on each other
+        std::vector<range_t> tasks;
+        for (uint32_t i{}; i != count;)
+        {
+            uint32_t const size{hierarchy.subtree_sizes[i]};
+            if (size > task_nodes)
+            {
+                propagate(hierarchy, {i, i + 1});
+                ++i;
+            }
+            else if (!tasks.empty() && tasks.back().last == i &&
+                tasks.back().last - tasks.back().first + size <= task_nodes)
+            {
+                // Consecutive small subtrees are merged, a wide node with
+                // many leaf children would otherwise submit a task per leaf
+                tasks.back().last += size;
+                i += size;
+            }
+            else
+            {
+                tasks.push_back({i, i + size});
+                i += size;
+            }
+        }
+
+        BS::multi_future<void> futures{thread_pool->submit_sequence(size_t{},
+            tasks.size(),
+            [&hierarchy, &tasks](size_t const i)
+            { propagate(hierarchy, tasks[i]); })};
+        futures.wait();
+    }
+
+    std::ranges::fill(hierarchy.dirty, uint8_t{0});
+}
+
+void ngnast::update_world_matrices(transform_hierarchy_t& hierarchy,
+    uint32_t const position,
+    glm::mat4 const& root_matrix)
+{
+    hierarchy.world_matrices[position] = root_matrix;
+
+    uint32_t const last{position + hierarchy.subtree_sizes[position]};
+    for (uint32_t i{position + 1}; i != last; ++i)
+    {
+        hierarchy.world_matrices[i] =
+            hierarchy.world_matrices[hierarchy.parents[i]] *
+            hierarchy.local_matrices[i];
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef NGNAST_TEST_HIERARCHY_HELPERS_INCLUDED
+#define NGNAST_TEST_HIERARCHY_HELPERS_INCLUDED
+
+#include <ngnast_scene_model.hpp>
+
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace test
+{
+    // Every node has up to branching children, node 0 is the only root.
+    // Branching equal to node count gives a root with only leaf children.
+    [[nodiscard]] inline ngnast::scene_model_t make_hierarchy(
+        size_t const node_count,
+        size_t const branching)
+    {
+        ngnast::scene_model_t rv;
+        rv.nodes.resize(node_count);
+        for (size_t i{}; i != node_count; ++i)
+        {
+            auto const f{static_cast<float>(i)};
+            rv.nodes[i].matrix = glm::rotate(
+                glm::translate(glm::mat4{1.0f}, glm::vec3{f, 0.5f, -f}),
+                0.01f * f,
+                glm::vec3{0.0f, 1.0f, 0.0f});
+
+            if (i != 0)
+            {
+                rv.nodes[(i - 1) / branching].child_indices.push_back(i);
+            }
+        }
+
+        rv.scenes.emplace_back().root_indices.push_back(0);
+
+        return rv;
+    }
+
+    // Recursive traversal of child indices used by the demos, matrices are
+    // appended in depth first order
+    inline void reference_world_matrices(ngnast::scene_model_t const& model,
+        ngnast::node_t const& node,
+        glm::mat4 const& parent,
+        std::vector<glm::mat4>& world)
+    {
+        glm::mat4 const matrix{parent * node.matrix};
+        world.push_back(matrix);
+        for (ngnast::node_t const& child : node.children(model))
+        {
+            reference_world_matrices(model, child, matrix, world);
+        }
+    }
+
+    [[nodiscard]] inline std::vector<glm::mat4> reference_world_matrices(
+        ngnast::scene_model_t const& model)
+    {
+        std::vector<glm::mat4> rv;
+        rv.reserve(model.nodes.size());
+        reference_world_matrices(model, model.nodes[0], glm::mat4{1.0f}, rv);
+        return rv;
+    }
+} // namespace test
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef NGNAST_TEST_MESH_HELPERS_INCLUDED
+#define NGNAST_TEST_MESH_HELPERS_INCLUDED
+
+#include <ngnast_scene_model.hpp>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <mikktspace.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace test
+{
+    // Wavy grid resembling a dense scanned surface, all triangles are
+    // connected through shared vertices
+    [[nodiscard]] inline ngnast::primitive_t make_wavy_grid(size_t const size)
+    {
+        ngnast::primitive_t rv;
+        rv.vertices.reserve(size * size);
+        for (size_t y{}; y != size; ++y)
+        {
+            for (size_t x{}; x != size; ++x)
+            {
+                auto const fx{static_cast<float>(x)};
+                auto const fy{static_cast<float>(y)};
+
+                rv.vertices.push_back({.position = {fx,
+                                           std::sin(fx * 0.1f) *
+                                               std::cos(fy * 0.07f) * 4.0f,
+                                           fy},
+                    .uv = {fx / static_cast<float>(size),
+                        fy / static_cast<float>(size)}});
+            }
+        }
+
+        rv.indices.reserve((size - 1) * (size - 1) * 6);
+        for (size_t y{}; y != size - 1; ++y)
+        {
+            for (size_t x{}; x != size - 1; ++x)
+            {
+                auto const i{static_cast<unsigned int>(y * size + x)};
+                auto const s{static_cast<unsigned int>(size)};
+                rv.indices.insert(rv.indices.end(),
+                    {i, i + s, i + 1, i + 1, i + s, i + s + 1});
+            }
+        }
+
+        return rv;
+    }
+
+    // Scalar normal generation previously done by the glTF loader
+    inline void reference_calculate_normals(ngnast::primitive_t& primitive)
+    {
+        bool const is_indexed{!primitive.indices.empty()};
+
+        auto& vertices{primitive.vertices};
+        auto const& indices{primitive.indices};
+
+        size_t const vertex_count{
+            is_indexed ? primitive.indices.size() : primitive.vertices.size()};
+        for (size_t i{}; i != vertex_count; i += 3)
+        {
+            auto& point1{is_indexed ? vertices[indices[i]] : vertices[i]};
+            auto& point2{
+                is_indexed ? vertices[indices[i + 1]] : vertices[i + 1]};
+            auto& point3{
+                is_indexed ? vertices[indices[i + 2]] : vertices[i + 2]};
+
+            glm::vec3 const edge1{point2.position - point1.position};
+            glm::vec3 const edge2{point3.position - point1.position};
+
+            glm::vec3 const face_normal{
+                glm::normalize(glm::cross(edge1, edge2))};
+            point1.normal = face_normal;
+            point2.normal = face_normal;
+            point3.normal = face_normal;
+        }
+
+        for (auto& vertex : primitive.vertices)
+        {
+            vertex.normal = glm::normalize(vertex.normal);
+        }
+    }
+
+    // Single MikkTSpace run over the whole unindexed triangle list
+    [[nodiscard]] inline bool reference_calculate_tangents(
+        ngnast::primitive_t& primitive)
+    {
+        using vertices_t = decltype(ngnast::primitive_t::vertices);
+
+        SMikkTSpaceInterface interface{
+            .m_getNumFaces = [](SMikkTSpaceContext const* context) -> int
+            {
+                auto const* const v{
+                    static_cast<vertices_t*>(context->m_pUserData)};
+                return static_cast<int>(v->size() / 3);
+            },
+            .m_getNumVerticesOfFace = [](SMikkTSpaceContext const*,
+                                          int) -> int { return 3; },
+            .m_getPosition =
+                [](SMikkTSpaceContext const* context,
+                    float* const out,
+                    int const face,
+                    int const vertex)
+            {
+                auto const& v{*static_cast<vertices_t*>(context->m_pUserData)};
+                auto const& p{v[static_cast<size_t>(face * 3 + vertex)]};
+                std::copy_n(&p.position[0], 3, out);
+            },
+            .m_getNormal =
+                [](SMikkTSpaceContext const* context,
+                    float* const out,
+                    int const face,
+                    int const vertex)
+            {
+                auto const& v{*static_cast<vertices_t*>(context->m_pUserData)};
+                auto const& p{v[static_cast<size_t>(face * 3 + vertex)]};
+                std::copy_n(&p.normal[0], 3, out);
+            },
+            .m_getTexCoord =
+                [](SMikkTSpaceContext const* context,
+                    float* const out,
+                    int const face,
+                    int const vertex)
+            {
+                auto const& v{*static_cast<vertices_t*>(context->m_pUserData)};
+                auto const& p{v[static_cast<size_t>(face * 3 + vertex)]};
+                std::copy_n(&p.uv[0], 2, out);
+            },
+            .m_setTSpaceBasic =
+                [](SMikkTSpaceContext const* context,
+                    float const* const tangent,
+                    float const sign,
+                    int const face,
+                    int const vertex)
+            {
+                auto& v{*static_cast<vertices_t*>(context->m_pUserData)};
+                v[static_cast<size_t>(face * 3 + vertex)].tangent =
+                    glm::vec4{tangent[0], tangent[1], tangent[2], -sign};
+            },
+            .m_setTSpace = nullptr};
+
+        SMikkTSpaceContext const context{.m_pInterface = &interface,
+            .m_pUserData = &primitive.vertices};
+
+        return static_cast<bool>(genTangSpaceDefault(&context));
+    }
+
+    // Vectorized results can differ in rounding when the compiler contracts
+    // operations of either implementation
+    [[nodiscard]] inline bool same_normals(ngnast::primitive_t const& lhs,
+        ngnast::primitive_t const& rhs,
+        float const epsilon)
+    {
+        return std::ranges::equal(lhs.vertices,
+            rhs.vertices,
+            [epsilon](ngnast::vertex_t const& l, ngnast::vertex_t const& r)
+            {
+                glm::vec3 const difference{glm::abs(l.normal - r.normal)};
+                return std::max({difference.x, difference.y, difference.z}) <=
+                    epsilon;
+            });
+    }
+
+    [[nodiscard]] inline bool same_tangents(ngnast::primitive_t const& lhs,
+        ngnast::primitive_t const& rhs,
+        float const epsilon)
+    {
+        return std::ranges::equal(lhs.vertices,
+            rhs.vertices,
+            [epsilon](ngnast::vertex_t const& l, ngnast::vertex_t const& r)
+            {
+                glm::vec4 const difference{glm::abs(l.tangent - r.tangent)};
+                return std::max({difference.x,
+                           difference.y,
+                           difference.z,
+                           difference.w}) <= epsilon;
+            });
+    }
+} // namespace test
+
+#endif
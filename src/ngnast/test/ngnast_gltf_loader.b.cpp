@@ -0,0 +1,73 @@
+#include <ngnast_gltf_loader.hpp>
+
+#include <ngnast_scene_model.hpp>
+
+#include <BS_thread_pool.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstdlib>
+#include <expected>
+#include <filesystem>
+#include <system_error>
+
+// Measures load times of models from KhronosGroup/glTF-Sample-Assets.
+// Set NIKU_GLTF_SAMPLE_ASSETS to the Models directory of the repository.
+
+namespace
+{
+    [[nodiscard]] std::filesystem::path sample_model(
+        std::filesystem::path const& relative)
+    {
+        // NOLINTNEXTLINE(concurrency-mt-unsafe)
+        char const* const root{std::getenv("NIKU_GLTF_SAMPLE_ASSETS")};
+        if (root == nullptr)
+        {
+            return {};
+        }
+
+        return std::filesystem::path{root} / relative;
+    }
+} // namespace
+
+TEST_CASE("Load sample models", "[ngnast][gltf][benchmark]")
+{
+    std::filesystem::path const model{sample_model(GENERATE(
+        "Sponza/glTF/Sponza.gltf",
+        "FlightHelmet/glTF/FlightHelmet.gltf",
+        "ABeautifulGame/glTF/ABeautifulGame.gltf",
+        "DamagedHelmet/glTF-Binary/DamagedHelmet.glb"))};
+    if (model.empty() || !exists(model))
+    {
+        SKIP("Sample model not available: " << model);
+    }
+
+    BS::thread_pool<> thread_pool;
+
+    // Measure parsing, not cooked cache hits
+    constexpr bool use_cooked_cache{false};
+    ngnast::gltf::loader_t serial_loader{{}, nullptr, use_cooked_cache};
+    ngnast::gltf::loader_t parallel_loader{{},
+        &thread_pool,
+        use_cooked_cache};
+
+    BENCHMARK("Serial " + model.filename().string())
+    {
+        return serial_loader.load(model);
+    };
+
+    BENCHMARK("Parallel " + model.filename().string())
+    {
+        return parallel_loader.load(model);
+    };
+
+    std::expected<ngnast::scene_model_t, std::error_code> const serial{
+        serial_loader.load(model)};
+    std::expected<ngnast::scene_model_t, std::error_code> const parallel{
+        parallel_loader.load(model)};
+    REQUIRE(serial);
+    REQUIRE(parallel);
+    CHECK(serial->images.size() == parallel->images.size());
+}
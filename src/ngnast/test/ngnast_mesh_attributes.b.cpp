@@ -0,0 +1,81 @@
+#include <ngnast_mesh_attributes.hpp>
+#include <ngnast_mesh_transform.hpp>
+#include <ngnast_scene_model.hpp>
+
+#include <BS_thread_pool.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <mesh_helpers.hpp>
+
+// Compares vectorized normal and parallel tangent generation with the scalar
+// implementations they replaced in the glTF loader. Results are checked by
+// ngnast_test.
+
+TEST_CASE("Normal generation", "[ngnast][mesh][benchmark]")
+{
+    ngnast::primitive_t const indexed{test::make_wavy_grid(1024)};
+
+    ngnast::primitive_t unindexed{indexed};
+    ngnast::mesh::make_unindexed(unindexed);
+
+    BENCHMARK_ADVANCED("Scalar indexed")(Catch::Benchmark::Chronometer meter)
+    {
+        ngnast::primitive_t p{indexed};
+        meter.measure([&p] { test::reference_calculate_normals(p); });
+    };
+
+    BENCHMARK_ADVANCED("Vectorized indexed")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        ngnast::primitive_t p{indexed};
+        meter.measure([&p] { ngnast::mesh::calculate_normals(p); });
+    };
+
+    BENCHMARK_ADVANCED("Scalar unindexed")(Catch::Benchmark::Chronometer meter)
+    {
+        ngnast::primitive_t p{unindexed};
+        meter.measure([&p] { test::reference_calculate_normals(p); });
+    };
+
+    BENCHMARK_ADVANCED("Vectorized unindexed")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        ngnast::primitive_t p{unindexed};
+        meter.measure([&p] { ngnast::mesh::calculate_normals(p); });
+    };
+}
+
+TEST_CASE("Tangent generation", "[ngnast][mesh][benchmark]")
+{
+    ngnast::primitive_t source{test::make_wavy_grid(512)};
+    ngnast::mesh::calculate_normals(source);
+    ngnast::mesh::make_unindexed(source);
+
+    BS::thread_pool<> thread_pool;
+
+    // Connected grid is split to ranges of faces, one per thread
+    REQUIRE(ngnast::mesh::detail::split_to_tangent_chunks(source.vertices,
+                thread_pool.get_thread_count())
+            .size() > 1);
+
+    BENCHMARK_ADVANCED("Reference")(Catch::Benchmark::Chronometer meter)
+    {
+        ngnast::primitive_t p{source};
+        meter.measure([&p] { return test::reference_calculate_tangents(p); });
+    };
+
+    BENCHMARK_ADVANCED("Serial")(Catch::Benchmark::Chronometer meter)
+    {
+        ngnast::primitive_t p{source};
+        meter.measure([&p] { return ngnast::mesh::calculate_tangents(p); });
+    };
+
+    BENCHMARK_ADVANCED("Parallel")(Catch::Benchmark::Chronometer meter)
+    {
+        ngnast::primitive_t p{source};
+        meter.measure([&p, &thread_pool]
+            { return ngnast::mesh::calculate_tangents(p, &thread_pool); });
+    };
+}
@@ -0,0 +1,118 @@
+#include <ngnast_mesh_attributes.hpp>
+#include <ngnast_mesh_transform.hpp>
+#include <ngnast_scene_model.hpp>
+
+#include <BS_thread_pool.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <mesh_helpers.hpp>
+
+TEST_CASE("calculate normals matches scalar reference",
+    "[ngnast][mesh_attributes]")
+{
+    ngnast::primitive_t source{test::make_wavy_grid(67)};
+
+    SECTION("indexed") { }
+
+    SECTION("unindexed") { ngnast::mesh::make_unindexed(source); }
+
+    ngnast::primitive_t reference{source};
+    test::reference_calculate_normals(reference);
+
+    ngnast::primitive_t vectorized{source};
+    ngnast::mesh::calculate_normals(vectorized);
+
+    CHECK(test::same_normals(reference, vectorized, 1e-5f));
+}
+
+TEST_CASE("calculate tangents matches single MikkTSpace run",
+    "[ngnast][mesh_attributes]")
+{
+    ngnast::primitive_t source{test::make_wavy_grid(256)};
+    ngnast::mesh::calculate_normals(source);
+    ngnast::mesh::make_unindexed(source);
+
+    ngnast::primitive_t reference{source};
+    REQUIRE(test::reference_calculate_tangents(reference));
+
+    SECTION("serial")
+    {
+        ngnast::primitive_t serial{source};
+        REQUIRE(ngnast::mesh::calculate_tangents(serial));
+        CHECK(test::same_tangents(reference, serial, 0.0f));
+    }
+
+    SECTION("parallel")
+    {
+        BS::thread_pool<> thread_pool{4};
+
+        // Grid is connected, it still has to be split between threads
+        REQUIRE(ngnast::mesh::detail::split_to_tangent_chunks(
+                    source.vertices,
+                    thread_pool.get_thread_count())
+                .size() > 1);
+
+        ngnast::primitive_t parallel{source};
+        REQUIRE(ngnast::mesh::calculate_tangents(parallel, &thread_pool));
+        CHECK(test::same_tangents(reference, parallel, 1e-5f));
+    }
+}
+
+TEST_CASE("tangent chunks own consecutive ranges of faces",
+    "[ngnast][mesh_attributes]")
+{
+    ngnast::primitive_t source{test::make_wavy_grid(256)};
+    ngnast::mesh::calculate_normals(source);
+    ngnast::mesh::make_unindexed(source);
+
+    auto const face_count{static_cast<uint32_t>(source.vertices.size() / 3)};
+
+    SECTION("small triangle lists aren't split")
+    {
+        CHECK(ngnast::mesh::detail::split_to_tangent_chunks(
+            std::span{source.vertices}.first(3 * 1024),
+            4)
+                .empty());
+        CHECK(ngnast::mesh::detail::split_to_tangent_chunks(source.vertices, 1)
+                .empty());
+    }
+
+    SECTION("owned faces cover the triangle list")
+    {
+        std::vector<ngnast::mesh::detail::tangent_chunk_t> const chunks{
+            ngnast::mesh::detail::split_to_tangent_chunks(source.vertices,
+                4)};
+        REQUIRE(chunks.size() == 4);
+
+        uint32_t next{};
+        for (ngnast::mesh::detail::tangent_chunk_t const& chunk : chunks)
+        {
+            CHECK(chunk.first_owned == next);
+            CHECK(chunk.first_owned < chunk.last_owned);
+            next = chunk.last_owned;
+
+            CHECK(std::ranges::is_sorted(chunk.faces));
+            CHECK(std::ranges::adjacent_find(chunk.faces) ==
+                chunk.faces.cend());
+
+            // Owned faces and boundary faces of neighbouring chunks
+            auto const owned{static_cast<size_t>(
+                std::ranges::count_if(chunk.faces,
+                    [&chunk](uint32_t const face)
+                    {
+                        return face >= chunk.first_owned &&
+                            face < chunk.last_owned;
+                    }))};
+            CHECK(owned == size_t{chunk.last_owned - chunk.first_owned});
+            CHECK(chunk.faces.size() > owned);
+        }
+        CHECK(next == face_count);
+    }
+}
@@ -0,0 +1,208 @@
+#include <ngnast_mesh_transform.hpp>
+#include <ngnast_scene_model.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <glm/geometric.hpp>
+#include <glm/vec3.hpp>
+
+#include <volk.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace
+{
+    // Flat grid in the z = 0 plane, triangles face +z
+    [[nodiscard]] ngnast::primitive_t make_grid(size_t const size)
+    {
+        ngnast::primitive_t rv;
+        rv.vertices.reserve(size * size);
+        for (size_t y{}; y != size; ++y)
+        {
+            for (size_t x{}; x != size; ++x)
+            {
+                rv.vertices.push_back({.position = {static_cast<float>(x),
+                                           static_cast<float>(y),
+                                           0.0f},
+                    .normal = {0.0f, 0.0f, 1.0f}});
+            }
+        }
+
+        rv.indices.reserve((size - 1) * (size - 1) * 6);
+        for (size_t y{}; y != size - 1; ++y)
+        {
+            for (size_t x{}; x != size - 1; ++x)
+            {
+                auto const i{static_cast<unsigned int>(y * size + x)};
+                auto const s{static_cast<unsigned int>(size)};
+                rv.indices.insert(rv.indices.end(),
+                    {i, i + 1, i + s, i + 1, i + s + 1, i + s});
+            }
+        }
+
+        return rv;
+    }
+
+    using triangle_t = std::array<unsigned int, 3>;
+
+    // Rotates the smallest index to the front, winding is preserved
+    [[nodiscard]] triangle_t canonical(triangle_t t)
+    {
+        std::ranges::rotate(t, std::ranges::min_element(t));
+        return t;
+    }
+
+    [[nodiscard]] std::vector<triangle_t> source_triangles(
+        ngnast::primitive_t const& primitive)
+    {
+        std::vector<triangle_t> rv;
+        for (size_t i{}; i != primitive.indices.size(); i += 3)
+        {
+            rv.push_back(canonical({primitive.indices[i],
+                primitive.indices[i + 1],
+                primitive.indices[i + 2]}));
+        }
+        std::ranges::sort(rv);
+        return rv;
+    }
+
+    // Resolves meshlet triangles through meshlet vertices to vertex indices
+    [[nodiscard]] std::vector<triangle_t> meshlet_triangles(
+        ngnast::primitive_t const& primitive)
+    {
+        std::vector<triangle_t> rv;
+        for (ngnast::meshlet_t const& meshlet : primitive.meshlets)
+        {
+            for (size_t i{}; i != meshlet.triangle_count * 3; i += 3)
+            {
+                triangle_t local{};
+                for (size_t k{}; k != 3; ++k)
+                {
+                    local[k] = primitive.meshlet_triangles
+                                   [meshlet.triangle_offset + i + k];
+                    REQUIRE(local[k] < meshlet.vertex_count);
+                    local[k] = primitive.meshlet_vertices
+                                   [meshlet.vertex_offset + local[k]];
+                }
+                rv.push_back(canonical(local));
+            }
+        }
+        std::ranges::sort(rv);
+        return rv;
+    }
+
+    // Culling test documented on ngnast::meshlet_t
+    [[nodiscard]] bool is_backfacing(ngnast::meshlet_t const& meshlet,
+        glm::vec3 const& camera)
+    {
+        return glm::dot(glm::normalize(meshlet.cone_apex - camera),
+                   meshlet.cone_axis) >= meshlet.cone_cutoff;
+    }
+} // namespace
+
+TEST_CASE("build meshlets", "[ngnast][mesh_transform]")
+{
+    ngnast::mesh::meshlet_options_t const options{GENERATE(
+        ngnast::mesh::meshlet_options_t{},
+        ngnast::mesh::meshlet_options_t{.max_vertices = 32,
+            .max_triangles = 32})};
+
+    ngnast::primitive_t primitive{make_grid(33)};
+    REQUIRE(ngnast::mesh::build_meshlets(primitive, options));
+    REQUIRE_FALSE(primitive.meshlets.empty());
+
+    SECTION("meshlets respect limits")
+    {
+        for (ngnast::meshlet_t const& meshlet : primitive.meshlets)
+        {
+            CHECK(meshlet.vertex_count > 0);
+            CHECK(meshlet.vertex_count <= options.max_vertices);
+            CHECK(meshlet.triangle_count > 0);
+            CHECK(meshlet.triangle_count <= options.max_triangles);
+
+            CHECK(meshlet.triangle_offset % 4 == 0);
+            CHECK(meshlet.vertex_offset + meshlet.vertex_count <=
+                primitive.meshlet_vertices.size());
+            CHECK(meshlet.triangle_offset + meshlet.triangle_count * 3 <=
+                primitive.meshlet_triangles.size());
+        }
+    }
+
+    SECTION("meshlets cover all source triangles")
+    {
+        CHECK(meshlet_triangles(primitive) == source_triangles(primitive));
+    }
+
+    SECTION("bounding spheres contain meshlet vertices")
+    {
+        for (ngnast::meshlet_t const& meshlet : primitive.meshlets)
+        {
+            for (unsigned int const index :
+                std::span{primitive.meshlet_vertices}.subspan(
+                    meshlet.vertex_offset,
+                    meshlet.vertex_count))
+            {
+                CHECK(glm::distance(primitive.vertices[index].position,
+                          meshlet.center) <= meshlet.radius + 1e-3f);
+            }
+        }
+    }
+
+    SECTION("normal cones follow the surface")
+    {
+        for (ngnast::meshlet_t const& meshlet : primitive.meshlets)
+        {
+            CHECK(meshlet.cone_axis.z > 0.99f);
+
+            glm::vec3 const above{meshlet.center + glm::vec3{0, 0, 10}};
+            glm::vec3 const below{meshlet.center - glm::vec3{0, 0, 10}};
+            CHECK_FALSE(is_backfacing(meshlet, above));
+            CHECK(is_backfacing(meshlet, below));
+        }
+    }
+
+    SECTION("rebuilding replaces previous meshlets")
+    {
+        auto const count{primitive.meshlets.size()};
+        auto const vertices{primitive.meshlet_vertices.size()};
+        auto const triangles{primitive.meshlet_triangles.size()};
+
+        REQUIRE(ngnast::mesh::build_meshlets(primitive, options));
+        CHECK(primitive.meshlets.size() == count);
+        CHECK(primitive.meshlet_vertices.size() == vertices);
+        CHECK(primitive.meshlet_triangles.size() == triangles);
+    }
+}
+
+TEST_CASE("build meshlets skips unsupported primitives",
+    "[ngnast][mesh_transform]")
+{
+    ngnast::primitive_t primitive{make_grid(4)};
+
+    SECTION("unindexed")
+    {
+        primitive.indices.clear();
+        CHECK_FALSE(ngnast::mesh::build_meshlets(primitive));
+    }
+
+    SECTION("fewer indices than a triangle")
+    {
+        primitive.indices.resize(2);
+        CHECK_FALSE(ngnast::mesh::build_meshlets(primitive));
+    }
+
+    SECTION("not a triangle list")
+    {
+        primitive.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        CHECK_FALSE(ngnast::mesh::build_meshlets(primitive));
+    }
+
+    CHECK(primitive.meshlets.empty());
+    CHECK(primitive.meshlet_vertices.empty());
+    CHECK(primitive.meshlet_triangles.empty());
+}
@@ -0,0 +1,122 @@
+#include <ngnast_scene_model.hpp>
+#include <ngnast_transform_hierarchy.hpp>
+
+#include <BS_thread_pool.hpp>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <hierarchy_helpers.hpp>
+
+// Compares linear world matrix propagation over the flattened hierarchy with
+// the recursive traversal of child indices used by the demos. Results are
+// checked by ngnast_test.
+
+TEST_CASE("World matrix propagation", "[ngnast][hierarchy][benchmark]")
+{
+    // Every node has a few children, similar to a large architectural scene
+    ngnast::scene_model_t const model{
+        test::make_hierarchy(size_t{1} << 17, 4)};
+
+    BS::thread_pool<> thread_pool;
+
+    ngnast::transform_hierarchy_t serial{ngnast::flatten_hierarchy(model)};
+    ngnast::transform_hierarchy_t parallel{ngnast::flatten_hierarchy(model)};
+
+    BENCHMARK_ADVANCED("Recursive")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<glm::mat4> world;
+        world.reserve(model.nodes.size());
+        meter.measure(
+            [&model, &world]
+            {
+                world.clear();
+                test::reference_world_matrices(model,
+                    model.nodes[0],
+                    glm::mat4{1.0f},
+                    world);
+            });
+    };
+
+    BENCHMARK_ADVANCED("Linear")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure(
+            [&serial]
+            {
+                ngnast::set_local_matrix(serial,
+                    0,
+                    serial.local_matrices[0]);
+                ngnast::update_world_matrices(serial);
+            });
+    };
+
+    BENCHMARK_ADVANCED("Parallel")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure(
+            [&parallel, &thread_pool]
+            {
+                ngnast::set_local_matrix(parallel,
+                    0,
+                    parallel.local_matrices[0]);
+                ngnast::update_world_matrices(parallel, &thread_pool);
+            });
+    };
+
+    BENCHMARK_ADVANCED("Linear, single dirty leaf")
+    (Catch::Benchmark::Chronometer meter)
+    {
+        auto const leaf{static_cast<uint32_t>(serial.parents.size() - 1)};
+        meter.measure(
+            [&serial, leaf]
+            {
+                ngnast::set_local_matrix(serial,
+                    leaf,
+                    serial.local_matrices[leaf]);
+                ngnast::update_world_matrices(serial);
+            });
+    };
+}
+
+TEST_CASE("World matrix propagation of a wide hierarchy",
+    "[ngnast][hierarchy][benchmark]")
+{
+    // Single root with only leaf children, common in exported glTF scenes
+    size_t const node_count{size_t{1} << 17};
+    ngnast::scene_model_t const model{
+        test::make_hierarchy(node_count, node_count)};
+
+    BS::thread_pool<> thread_pool;
+
+    ngnast::transform_hierarchy_t serial{ngnast::flatten_hierarchy(model)};
+    ngnast::transform_hierarchy_t parallel{ngnast::flatten_hierarchy(model)};
+
+    BENCHMARK_ADVANCED("Linear")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure(
+            [&serial]
+            {
+                ngnast::set_local_matrix(serial,
+                    0,
+                    serial.local_matrices[0]);
+                ngnast::update_world_matrices(serial);
+            });
+    };
+
+    BENCHMARK_ADVANCED("Parallel")(Catch::Benchmark::Chronometer meter)
+    {
+        meter.measure(
+            [&parallel, &thread_pool]
+            {
+                ngnast::set_local_matrix(parallel,
+                    0,
+                    parallel.local_matrices[0]);
+                ngnast::update_world_matrices(parallel, &thread_pool);
+            });
+    };
+}
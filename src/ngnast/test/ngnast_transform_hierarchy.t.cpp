@@ -0,0 +1,86 @@
+#include <ngnast_scene_model.hpp>
+#include <ngnast_transform_hierarchy.hpp>
+
+#include <BS_thread_pool.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <hierarchy_helpers.hpp>
+
+TEST_CASE("world matrices match recursive traversal",
+    "[ngnast][transform_hierarchy]")
+{
+    // Balanced tree and a root with only leaf children
+    size_t const branching{GENERATE(size_t{4}, size_t{4096})};
+    ngnast::scene_model_t const model{test::make_hierarchy(4096, branching)};
+
+    std::vector<glm::mat4> const reference{
+        test::reference_world_matrices(model)};
+
+    ngnast::transform_hierarchy_t hierarchy{ngnast::flatten_hierarchy(model)};
+    REQUIRE(hierarchy.parents.size() == model.nodes.size());
+
+    SECTION("serial") { ngnast::update_world_matrices(hierarchy); }
+
+    SECTION("parallel")
+    {
+        BS::thread_pool<> thread_pool{4};
+        ngnast::update_world_matrices(hierarchy, &thread_pool);
+    }
+
+    CHECK(std::ranges::equal(reference, hierarchy.world_matrices));
+    CHECK(std::ranges::none_of(hierarchy.dirty,
+        [](uint8_t const d) { return d != 0; }));
+}
+
+TEST_CASE("world matrices are updated only for changed subtrees",
+    "[ngnast][transform_hierarchy]")
+{
+    size_t const branching{GENERATE(size_t{4}, size_t{4096})};
+    ngnast::scene_model_t model{test::make_hierarchy(4096, branching)};
+
+    ngnast::transform_hierarchy_t hierarchy{ngnast::flatten_hierarchy(model)};
+    ngnast::update_world_matrices(hierarchy);
+
+    // Node 1 is the first child of the root, the last node isn't its
+    // descendant
+    size_t const changed{1};
+    uint32_t const position{hierarchy.positions[changed]};
+    uint32_t const unrelated{hierarchy.positions[model.nodes.size() - 1]};
+    REQUIRE((unrelated < position ||
+        unrelated >= position + hierarchy.subtree_sizes[position]));
+
+    model.nodes[changed].matrix =
+        glm::translate(model.nodes[changed].matrix, glm::vec3{1.0f});
+    ngnast::set_local_matrix(hierarchy,
+        position,
+        model.nodes[changed].matrix);
+
+    // Clean nodes outside of the changed subtree keep their matrices
+    glm::mat4 const marker{0.0f};
+    hierarchy.world_matrices[unrelated] = marker;
+
+    SECTION("serial") { ngnast::update_world_matrices(hierarchy); }
+
+    SECTION("parallel")
+    {
+        BS::thread_pool<> thread_pool{4};
+        ngnast::update_world_matrices(hierarchy, &thread_pool);
+    }
+
+    std::vector<glm::mat4> reference{test::reference_world_matrices(model)};
+    CHECK(hierarchy.world_matrices[unrelated] == marker);
+
+    reference[unrelated] = marker;
+    CHECK(std::ranges::equal(reference, hierarchy.world_matrices));
+}
@@ -0,0 +1,54 @@
+#ifndef NGNGFX_FRUSTUM_INCLUDED
+#define NGNGFX_FRUSTUM_INCLUDED
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// IWYU pragma: no_include <glm/detail/qualifier.hpp>
+
+namespace ngngfx
+{
+    // Planes point inwards, xyz is the normal and w the distance from the
+    // origin. Default constructed frustum contains everything.
+    struct [[nodiscard]] frustum_t final
+    {
+        std::array<glm::vec4, 6> planes{};
+    };
+
+    // Planes of a view projection matrix with zero to one depth range
+    [[nodiscard]] frustum_t extract_frustum(glm::mat4 const& view_projection);
+
+    // Axis aligned bounding boxes stored per component so that consecutive
+    // boxes map to consecutive SIMD lanes
+    struct [[nodiscard]] aabb_array_t final
+    {
+        std::vector<float> min_x;
+        std::vector<float> min_y;
+        std::vector<float> min_z;
+        std::vector<float> max_x;
+        std::vector<float> max_y;
+        std::vector<float> max_z;
+
+        void push_back(glm::vec3 const& min, glm::vec3 const& max);
+
+        void clear();
+
+        [[nodiscard]] size_t size() const;
+    };
+
+    // Writes 1 for boxes intersecting the frustum and 0 for boxes outside of
+    // it. The test is conservative, boxes near the edges of the frustum can
+    // be reported visible while outside.
+    void frustum_cull(frustum_t const& frustum,
+        aabb_array_t const& boxes,
+        std::span<uint8_t> visible);
+} // namespace ngngfx
+
+#endif
@@ -0,0 +1,198 @@
+#include <ngngfx_frustum.hpp>
+
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/matrix.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NGNGFX_FRUSTUM_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NGNGFX_FRUSTUM_SSE2
+#endif
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace
+{
+    // Corner of the boxes furthest along the plane normal, a box is outside
+    // when this corner is behind the plane
+    struct [[nodiscard]] corner_t final
+    {
+        float const* x;
+        float const* y;
+        float const* z;
+    };
+
+    [[nodiscard]] corner_t positive_corner(glm::vec4 const& plane,
+        ngngfx::aabb_array_t const& boxes)
+    {
+        return {.x = plane.x > 0.0f ? boxes.max_x.data() : boxes.min_x.data(),
+            .y = plane.y > 0.0f ? boxes.max_y.data() : boxes.min_y.data(),
+            .z = plane.z > 0.0f ? boxes.max_z.data() : boxes.min_z.data()};
+    }
+
+    void frustum_cull_scalar(ngngfx::frustum_t const& frustum,
+        ngngfx::aabb_array_t const& boxes,
+        size_t const first,
+        std::span<uint8_t> const visible)
+    {
+        for (size_t i{first}; i != boxes.size(); ++i)
+        {
+            bool outside{false};
+            for (glm::vec4 const& plane : frustum.planes)
+            {
+                corner_t const c{positive_corner(plane, boxes)};
+                outside = outside ||
+                    plane.x * c.x[i] + plane.y * c.y[i] + plane.z * c.z[i] +
+                            plane.w <
+                        0.0f;
+            }
+            visible[i] = outside ? 0 : 1;
+        }
+    }
+
+#if defined(NGNGFX_FRUSTUM_AVX2)
+    constexpr size_t lane_count{8};
+
+    size_t frustum_cull_simd(ngngfx::frustum_t const& frustum,
+        ngngfx::aabb_array_t const& boxes,
+        std::span<uint8_t> const visible)
+    {
+        size_t const simd_boxes{boxes.size() - boxes.size() % lane_count};
+        for (size_t i{}; i != simd_boxes; i += lane_count)
+        {
+            __m256 outside{_mm256_setzero_ps()};
+            for (glm::vec4 const& plane : frustum.planes)
+            {
+                corner_t const c{positive_corner(plane, boxes)};
+
+                __m256 const dx{_mm256_mul_ps(_mm256_set1_ps(plane.x),
+                    _mm256_loadu_ps(c.x + i))};
+                __m256 const dy{_mm256_mul_ps(_mm256_set1_ps(plane.y),
+                    _mm256_loadu_ps(c.y + i))};
+                __m256 const dz{_mm256_mul_ps(_mm256_set1_ps(plane.z),
+                    _mm256_loadu_ps(c.z + i))};
+                __m256 const distance{_mm256_add_ps(_mm256_add_ps(dx, dy),
+                    _mm256_add_ps(dz, _mm256_set1_ps(plane.w)))};
+
+                outside = _mm256_or_ps(outside,
+                    _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_LT_OQ));
+            }
+
+            int const mask{_mm256_movemask_ps(outside)};
+            for (size_t lane{}; lane != lane_count; ++lane)
+            {
+                visible[i + lane] = ((mask >> lane) & 1) != 0 ? 0 : 1;
+            }
+        }
+
+        return simd_boxes;
+    }
+#elif defined(NGNGFX_FRUSTUM_SSE2)
+    constexpr size_t lane_count{4};
+
+    size_t frustum_cull_simd(ngngfx::frustum_t const& frustum,
+        ngngfx::aabb_array_t const& boxes,
+        std::span<uint8_t> const visible)
+    {
+        size_t const simd_boxes{boxes.size() - boxes.size() % lane_count};
+        for (size_t i{}; i != simd_boxes; i += lane_count)
+        {
+            __m128 outside{_mm_setzero_ps()};
+            for (glm::vec4 const& plane : frustum.planes)
+            {
+                corner_t const c{positive_corner(plane, boxes)};
+
+                __m128 const dx{
+                    _mm_mul_ps(_mm_set1_ps(plane.x), _mm_loadu_ps(c.x + i))};
+                __m128 const dy{
+                    _mm_mul_ps(_mm_set1_ps(plane.y), _mm_loadu_ps(c.y + i))};
+                __m128 const dz{
+                    _mm_mul_ps(_mm_set1_ps(plane.z), _mm_loadu_ps(c.z + i))};
+                __m128 const distance{_mm_add_ps(_mm_add_ps(dx, dy),
+                    _mm_add_ps(dz, _mm_set1_ps(plane.w)))};
+
+                outside = _mm_or_ps(outside,
+                    _mm_cmplt_ps(distance, _mm_setzero_ps()));
+            }
+
+            int const mask{_mm_movemask_ps(outside)};
+            for (size_t lane{}; lane != lane_count; ++lane)
+            {
+                visible[i + lane] = ((mask >> lane) & 1) != 0 ? 0 : 1;
+            }
+        }
+
+        return simd_boxes;
+    }
+#else
+    size_t frustum_cull_simd(ngngfx::frustum_t const&,
+        ngngfx::aabb_array_t const&,
+        std::span<uint8_t>)
+    {
+        return 0;
+    }
+#endif
+} // namespace
+
+ngngfx::frustum_t ngngfx::extract_frustum(glm::mat4 const& view_projection)
+{
+    // Rows of the matrix, clip space x and y are within [-w, w] and z within
+    // [0, w]
+    glm::mat4 const rows{glm::transpose(view_projection)};
+
+    frustum_t rv{.planes = {rows[3] + rows[0],
+                     rows[3] - rows[0],
+                     rows[3] + rows[1],
+                     rows[3] - rows[1],
+                     rows[2],
+                     rows[3] - rows[2]}};
+
+    for (glm::vec4& plane : rv.planes)
+    {
+        plane /= glm::length(glm::vec3{plane});
+    }
+
+    return rv;
+}
+
+void ngngfx::aabb_array_t::push_back(glm::vec3 const& min,
+    glm::vec3 const& max)
+{
+    min_x.push_back(min.x);
+    min_y.push_back(min.y);
+    min_z.push_back(min.z);
+    max_x.push_back(max.x);
+    max_y.push_back(max.y);
+    max_z.push_back(max.z);
+}
+
+void ngngfx::aabb_array_t::clear()
+{
+    min_x.clear();
+    min_y.clear();
+    min_z.clear();
+    max_x.clear();
+    max_y.clear();
+    max_z.clear();
+}
+
+size_t ngngfx::aabb_array_t::size() const { return min_x.size(); }
+
+void ngngfx::frustum_cull(frustum_t const& frustum,
+    aabb_array_t const& boxes,
+    std::span<uint8_t> const visible)
+{
+    assert(visible.size() >= boxes.size());
+
+    size_t const simd_boxes{frustum_cull_simd(frustum, boxes, visible)};
+    frustum_cull_scalar(frustum, boxes, simd_boxes, visible);
+}
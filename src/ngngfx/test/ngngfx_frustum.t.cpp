@@ -0,0 +1,197 @@
+#include <ngngfx_frustum.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // Value of entries past the last box, they must not be written
+    constexpr uint8_t untouched{2};
+
+    // Contains [-1, 1] on all axes
+    [[nodiscard]] ngngfx::frustum_t unit_cube()
+    {
+        return {.planes = {glm::vec4{1.0f, 0.0f, 0.0f, 1.0f},
+                    glm::vec4{-1.0f, 0.0f, 0.0f, 1.0f},
+                    glm::vec4{0.0f, 1.0f, 0.0f, 1.0f},
+                    glm::vec4{0.0f, -1.0f, 0.0f, 1.0f},
+                    glm::vec4{0.0f, 0.0f, 1.0f, 1.0f},
+                    glm::vec4{0.0f, 0.0f, -1.0f, 1.0f}}};
+    }
+
+    // Distance of the box corner furthest along the plane normal
+    [[nodiscard]] double corner_distance(glm::vec4 const& plane,
+        glm::vec3 const& min,
+        glm::vec3 const& max)
+    {
+        glm::vec3 const corner{plane.x > 0.0f ? max.x : min.x,
+            plane.y > 0.0f ? max.y : min.y,
+            plane.z > 0.0f ? max.z : min.z};
+        return double{plane.x} * corner.x + double{plane.y} * corner.y +
+            double{plane.z} * corner.z + double{plane.w};
+    }
+
+    [[nodiscard]] std::vector<uint8_t> reference_cull(
+        ngngfx::frustum_t const& frustum,
+        ngngfx::aabb_array_t const& boxes)
+    {
+        std::vector<uint8_t> rv;
+        for (size_t i{}; i != boxes.size(); ++i)
+        {
+            glm::vec3 const min{boxes.min_x[i],
+                boxes.min_y[i],
+                boxes.min_z[i]};
+            glm::vec3 const max{boxes.max_x[i],
+                boxes.max_y[i],
+                boxes.max_z[i]};
+
+            bool const inside{std::ranges::all_of(frustum.planes,
+                [&min, &max](glm::vec4 const& plane)
+                { return corner_distance(plane, min, max) >= 0; })};
+            rv.push_back(inside ? uint8_t{1} : uint8_t{0});
+        }
+        return rv;
+    }
+
+    // Culls into a buffer with one extra entry past the last box
+    [[nodiscard]] std::vector<uint8_t> cull(ngngfx::frustum_t const& frustum,
+        ngngfx::aabb_array_t const& boxes)
+    {
+        std::vector<uint8_t> rv(boxes.size() + 1, untouched);
+        ngngfx::frustum_cull(frustum, boxes, rv);
+
+        CHECK(rv.back() == untouched);
+        rv.pop_back();
+
+        return rv;
+    }
+
+    struct [[nodiscard]] box_t final
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+        uint8_t visible;
+    };
+
+    constexpr std::array boxes_of_unit_cube{
+        // Inside
+        box_t{{-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}, 1},
+        // Outside along +x
+        box_t{{1.5f, -0.5f, -0.5f}, {2.0f, 0.5f, 0.5f}, 0},
+        // Straddles the +y plane
+        box_t{{-0.5f, 0.5f, -0.5f}, {0.5f, 1.5f, 0.5f}, 1},
+        // Outside along -z
+        box_t{{-0.5f, -0.5f, -3.0f}, {0.5f, 0.5f, -2.0f}, 0},
+        // Encloses the frustum
+        box_t{{-2.0f, -2.0f, -2.0f}, {2.0f, 2.0f, 2.0f}, 1},
+        // Straddles the -x plane
+        box_t{{-1.5f, -0.5f, -0.5f}, {-0.5f, 0.5f, 0.5f}, 1},
+        // Outside along -y
+        box_t{{-0.5f, -2.0f, -0.5f}, {0.5f, -1.5f, 0.5f}, 0},
+    };
+} // namespace
+
+TEST_CASE("frustum cull matches scalar reference", "[ngngfx][frustum]")
+{
+    // Counts cover SIMD iterations with and without a scalar tail
+    size_t const count{GENERATE(0u, 1u, 3u, 4u, 5u, 7u, 8u, 9u, 13u, 33u)};
+
+    ngngfx::aabb_array_t boxes;
+    std::vector<uint8_t> expected;
+    for (size_t i{}; i != count; ++i)
+    {
+        box_t const& box{boxes_of_unit_cube[i % boxes_of_unit_cube.size()]};
+        boxes.push_back(box.min, box.max);
+        expected.push_back(box.visible);
+    }
+
+    ngngfx::frustum_t const frustum{unit_cube()};
+
+    std::vector<uint8_t> const visible{cull(frustum, boxes)};
+    CHECK(visible == reference_cull(frustum, boxes));
+    CHECK(visible == expected);
+}
+
+TEST_CASE("frustum cull reports boxes in their own lanes", "[ngngfx][frustum]")
+{
+    size_t const count{GENERATE(1u, 7u, 8u, 9u, 12u, 17u)};
+
+    ngngfx::frustum_t const frustum{unit_cube()};
+    box_t const& inside{boxes_of_unit_cube[0]};
+    box_t const& outside{boxes_of_unit_cube[1]};
+
+    for (size_t culled{}; culled != count; ++culled)
+    {
+        ngngfx::aabb_array_t boxes;
+        std::vector<uint8_t> expected(count, 1);
+        for (size_t i{}; i != count; ++i)
+        {
+            box_t const& box{i == culled ? outside : inside};
+            boxes.push_back(box.min, box.max);
+        }
+        expected[culled] = 0;
+
+        CHECK(cull(frustum, boxes) == expected);
+    }
+}
+
+TEST_CASE("frustum cull of perspective frustum matches scalar reference",
+    "[ngngfx][frustum]")
+{
+    size_t const count{GENERATE(37u, 101u, 253u)};
+
+    ngngfx::frustum_t const frustum{ngngfx::extract_frustum(
+        glm::perspectiveRH_ZO(glm::radians(60.0f), 1.5f, 0.1f, 100.0f) *
+        glm::lookAtRH(glm::vec3{0.0f, 2.0f, 10.0f},
+            glm::vec3{0.0f},
+            glm::vec3{0.0f, 1.0f, 0.0f}))};
+
+    std::mt19937 generator{static_cast<std::mt19937::result_type>(count)};
+    std::uniform_real_distribution<float> center{-20.0f, 20.0f};
+    std::uniform_real_distribution<float> extent{0.1f, 5.0f};
+
+    ngngfx::aabb_array_t boxes;
+    while (boxes.size() != count)
+    {
+        glm::vec3 const c{center(generator),
+            center(generator),
+            center(generator)};
+        glm::vec3 const e{extent(generator),
+            extent(generator),
+            extent(generator)};
+
+        // Boxes with a corner close to a plane are skipped, whether they are
+        // culled depends on the order of floating point operations
+        if (std::ranges::any_of(frustum.planes,
+                [&c, &e](glm::vec4 const& plane)
+                {
+                    return std::abs(corner_distance(plane, c - e, c + e)) <
+                        1e-3;
+                }))
+        {
+            continue;
+        }
+
+        boxes.push_back(c - e, c + e);
+    }
+
+    std::vector<uint8_t> const expected{reference_cull(frustum, boxes)};
+    REQUIRE(std::ranges::count(expected, 0) != 0);
+    REQUIRE(std::ranges::count(expected, 1) != 0);
+
+    CHECK(cull(frustum, boxes) == expected);
+}
@@ -13,6 +13,7 @@ namespace vkrndr
     struct instance_t;
     struct device_t;
     class execution_port_t;
+    class gpu_profiler_t;
     class swapchain_t;
 } // namespace vkrndr
 
@@ -57,6 +58,10 @@ namespace ngnwsi
 
         void remove_texture(VkDescriptorSet texture);
 
+        // Window with the last resolved timings of the profiler, has to be
+        // called between begin_frame and render
+        void draw_gpu_profiler(vkrndr::gpu_profiler_t const& profiler);
+
     public:
         imgui_layer_t& operator=(imgui_layer_t const&) = delete;
 
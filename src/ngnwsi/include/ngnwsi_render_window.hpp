@@ -10,6 +10,7 @@
 #include <volk.h>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <span>
@@ -58,6 +59,9 @@ namespace ngnwsi
 
         [[nodiscard]] vkrndr::frame_in_flight_t& frame_in_flight();
 
+        // Action runs once the device is done with frames that have begun
+        void defer(std::function<void()> action);
+
         [[nodiscard]] std::optional<vkrndr::image_t> acquire_next_image(
             uint64_t timeout = 0);
 
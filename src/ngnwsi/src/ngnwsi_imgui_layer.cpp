@@ -5,6 +5,7 @@
 #include <vkrndr_debug_utils.hpp>
 #include <vkrndr_device.hpp>
 #include <vkrndr_execution_port.hpp>
+#include <vkrndr_gpu_profiler.hpp>
 #include <vkrndr_image.hpp>
 #include <vkrndr_instance.hpp>
 #include <vkrndr_render_pass.hpp>
@@ -17,6 +18,7 @@
 #include <imgui.h>
 
 #include <cassert>
+#include <cstddef>
 #include <utility>
 
 // IWYU pragma: no_include <string_view>
@@ -106,7 +108,7 @@ ngnwsi::imgui_layer_t::imgui_layer_t(sdl_window_t const& window,
     init_info.Device = device;
     init_info.QueueFamily = present_queue.queue_family();
     init_info.Queue = present_queue;
-    init_info.PipelineCache = VK_NULL_HANDLE;
+    init_info.PipelineCache = device.pipeline_cache;
     init_info.DescriptorPool = descriptor_pool_;
     init_info.PipelineInfoMain.RenderPass = VK_NULL_HANDLE;
     init_info.PipelineInfoMain.Subpass = 0;
@@ -203,3 +205,53 @@ void ngnwsi::imgui_layer_t::remove_texture(VkDescriptorSet const texture)
     ImGui::SetCurrentContext(context_);
     ImGui_ImplVulkan_RemoveTexture(texture);
 }
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void ngnwsi::imgui_layer_t::draw_gpu_profiler(
+    vkrndr::gpu_profiler_t const& profiler)
+{
+    ImGui::SetCurrentContext(context_);
+
+    if (ImGui::Begin("GPU Profiler"))
+    {
+        double total{};
+        if (ImGui::BeginTable("Timings", 3, ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Scope");
+            ImGui::TableSetupColumn("ms");
+            ImGui::TableSetupColumn("Statistics");
+            ImGui::TableHeadersRow();
+
+            for (vkrndr::gpu_scope_timing_t const& timing : profiler.timings())
+            {
+                ImGui::TableNextRow();
+
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(timing.name.data(),
+                    timing.name.data() + timing.name.size());
+
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", timing.milliseconds);
+
+                ImGui::TableNextColumn();
+                for (size_t i{}; i != timing.statistics.size(); ++i)
+                {
+                    if (i != 0)
+                    {
+                        ImGui::SameLine();
+                    }
+                    ImGui::Text("%llu",
+                        static_cast<unsigned long long>(timing.statistics[i]));
+                }
+
+                total += timing.milliseconds;
+            }
+
+            ImGui::EndTable();
+        }
+
+        // Nested scopes are counted more than once
+        ImGui::Text("Sum: %.3f ms", total);
+    }
+    ImGui::End();
+}
@@ -13,7 +13,9 @@
 
 #include <spdlog/spdlog.h>
 
+#include <functional>
 #include <limits>
+#include <utility>
 
 ngnwsi::render_window_t::render_window_t(char const* title,
     SDL_WindowFlags window_flags,
@@ -57,6 +59,11 @@ vkrndr::frame_in_flight_t& ngnwsi::render_window_t::frame_in_flight()
     return pacing_->current();
 }
 
+void ngnwsi::render_window_t::defer(std::function<void()> action)
+{
+    pacing_->defer(std::move(action));
+}
+
 std::optional<vkrndr::image_t> ngnwsi::render_window_t::acquire_next_image(
     uint64_t timeout)
 {
@@ -113,7 +120,8 @@ void ngnwsi::render_window_t::present(
     vkrndr::frame_in_flight_t const& current{pacing_->current()};
     swapchain_->submit_command_buffers(command_buffers,
         current.index,
-        current.submit_fence);
+        pacing_->timeline(),
+        current.timeline_value);
 
     pacing_->end_frame();
 }
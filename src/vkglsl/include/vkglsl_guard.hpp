@@ -1,12 +1,16 @@
 #ifndef VKGLSL_GUARD_INCLUDED
 #define VKGLSL_GUARD_INCLUDED
 
+#include <filesystem>
+
 namespace vkglsl
 {
     struct [[nodiscard]] guard_t final
     {
     public:
-        guard_t();
+        // Compiled shaders are cached in the given directory, cache is
+        // disabled when no directory is given
+        explicit guard_t(std::filesystem::path const& cache_directory = {});
 
         guard_t(guard_t const&) = delete;
 
@@ -3,6 +3,8 @@
 
 #include <vkrndr_shader_module.hpp>
 
+#include <BS_thread_pool.hpp> // IWYU pragma: keep
+
 #include <volk.h>
 
 #include <cstdint>
@@ -21,6 +23,14 @@ namespace vkrndr
 
 namespace vkglsl
 {
+    struct [[nodiscard]] shader_source_t final
+    {
+        VkShaderStageFlagBits stage{};
+        std::filesystem::path file;
+        std::span<std::string_view const> preprocessor_defines;
+        std::string_view entry_point{"main"};
+    };
+
     class [[nodiscard]] shader_set_t final
     {
     public:
@@ -44,6 +54,22 @@ namespace vkglsl
             std::span<std::string_view const> const& preprocessor_defines = {},
             std::string_view entry_point = "main");
 
+        // Compiles source which is already in memory, name of the source is
+        // used in diagnostic messages
+        [[nodiscard]] std::expected<void, std::error_code> add_shader(
+            VkShaderStageFlagBits stage,
+            std::span<char const> const& glsl_source,
+            std::string_view source_name,
+            std::span<std::string_view const> const& preprocessor_defines = {},
+            std::string_view entry_point = "main");
+
+        // Compiles sources concurrently when a thread pool is given, every
+        // compilation uses its own glslang state. Stages of sources have to
+        // be distinct, no shader is added if any of them fails.
+        [[nodiscard]] std::expected<void, std::error_code> add_shaders(
+            std::span<shader_source_t const> const& sources,
+            BS::thread_pool<>* thread_pool = nullptr);
+
         [[nodiscard]] std::expected<void, std::error_code> add_shader_binary(
             VkShaderStageFlagBits stage,
             std::span<uint32_t const> const& binary,
@@ -78,6 +104,14 @@ namespace vkglsl
         std::span<std::string_view const> const& preprocessor_defines = {},
         std::string_view entry_point = "main");
 
+    // Modules are returned in the order of sources
+    [[nodiscard]] std::expected<std::vector<vkrndr::shader_module_t>,
+        std::error_code>
+    add_shader_modules_from_paths(shader_set_t& shader_set,
+        vkrndr::device_t const& device,
+        std::span<shader_source_t const> const& sources,
+        BS::thread_pool<>* thread_pool = nullptr);
+
     [[nodiscard]] std::expected<vkrndr::shader_module_t, std::error_code>
     add_shader_binary_from_path(shader_set_t& shader_set,
         vkrndr::device_t const& device,
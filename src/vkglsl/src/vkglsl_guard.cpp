@@ -1,7 +1,15 @@
 #include <vkglsl_guard.hpp>
 
+#include <vkglsl_shader_cache.hpp>
+
 #include <glslang/Public/ShaderLang.h>
 
-vkglsl::guard_t::guard_t() { glslang::InitializeProcess(); }
+#include <filesystem>
+
+vkglsl::guard_t::guard_t(std::filesystem::path const& cache_directory)
+{
+    glslang::InitializeProcess();
+    set_cache_directory(cache_directory);
+}
 
 vkglsl::guard_t::~guard_t() { glslang::FinalizeProcess(); }
@@ -0,0 +1,279 @@
+#include <vkglsl_shader_cache.hpp>
+
+#include <cppext_mapped_file.hpp>
+
+#include <boost/hash2/md5.hpp>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// IWYU pragma: no_include <boost/hash2/digest.hpp>
+// IWYU pragma: no_include <fmt/base.h>
+
+namespace
+{
+    constexpr uint32_t magic{0x5653'4B4E}; // NKSV
+    constexpr uint32_t version{1};
+
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    std::filesystem::path cache_directory_;
+
+    [[nodiscard]] std::filesystem::path cached_path(
+        vkglsl::shader_key_t const& key)
+    {
+        return cache_directory_ / fmt::format("{:02x}.spv", fmt::join(key, ""));
+    }
+
+    class [[nodiscard]] reader_t final
+    {
+    public:
+        explicit reader_t(std::span<std::byte const> const& data)
+            : data_{data}
+        {
+        }
+
+    public:
+        template<typename T>
+        [[nodiscard]] bool value(T& out)
+        {
+            if (data_.size() < sizeof(T))
+            {
+                return false;
+            }
+
+            std::memcpy(&out, data_.data(), sizeof(T));
+            data_ = data_.subspan(sizeof(T));
+            return true;
+        }
+
+        template<typename T>
+        [[nodiscard]] bool values(std::vector<T>& out)
+        {
+            uint64_t count{};
+            if (!value(count) || count > data_.size() / sizeof(T))
+            {
+                return false;
+            }
+
+            out.resize(count);
+            std::memcpy(out.data(), data_.data(), count * sizeof(T));
+            data_ = data_.subspan(count * sizeof(T));
+            return true;
+        }
+
+    private:
+        std::span<std::byte const> data_;
+    };
+
+    template<typename T>
+    void append(std::vector<std::byte>& buffer, T const& value)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto const* const bytes{reinterpret_cast<std::byte const*>(&value)};
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    void append(std::vector<std::byte>& buffer,
+        std::span<T const> const& values)
+    {
+        append(buffer, uint64_t{values.size()});
+
+        std::span const bytes{std::as_bytes(values)};
+        buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+    }
+} // namespace
+
+void vkglsl::set_cache_directory(std::filesystem::path const& directory)
+{
+    cache_directory_ =
+        directory.empty() ? directory : std::filesystem::absolute(directory);
+}
+
+std::filesystem::path const& vkglsl::cache_directory()
+{
+    return cache_directory_;
+}
+
+std::optional<vkglsl::shader_key_t> vkglsl::content_hash(
+    std::filesystem::path const& file)
+{
+    cppext::mapped_file_t mapped;
+    try
+    {
+        mapped = cppext::mapped_file_t{file};
+    }
+    catch (std::system_error const&)
+    {
+        return std::nullopt;
+    }
+
+    boost::hash2::md5_128 hash;
+    hash.update(mapped.bytes().data(), mapped.size());
+
+    shader_key_t rv{};
+    std::ranges::copy(hash.result(), rv.begin());
+    return rv;
+}
+
+std::optional<vkglsl::cached_shader_t> vkglsl::read_cached_shader(
+    shader_key_t const& key)
+{
+    if (cache_directory_.empty())
+    {
+        return std::nullopt;
+    }
+
+    std::filesystem::path const path{cached_path(key)};
+
+    std::error_code ec;
+    if (!exists(path, ec))
+    {
+        return std::nullopt;
+    }
+
+    cppext::mapped_file_t file;
+    try
+    {
+        file = cppext::mapped_file_t{path};
+    }
+    catch (std::system_error const&)
+    {
+        return std::nullopt;
+    }
+
+    reader_t reader{file.bytes()};
+
+    uint32_t file_magic{};
+    uint32_t file_version{};
+    shader_key_t file_key{};
+    if (!reader.value(file_magic) || file_magic != magic ||
+        !reader.value(file_version) || file_version != version ||
+        !reader.value(file_key) || file_key != key)
+    {
+        return std::nullopt;
+    }
+
+    uint64_t include_count{};
+    if (!reader.value(include_count))
+    {
+        return std::nullopt;
+    }
+
+    for (uint64_t i{}; i != include_count; ++i)
+    {
+        std::vector<char8_t> include_path;
+        shader_key_t include_hash{};
+        if (!reader.values(include_path) || !reader.value(include_hash))
+        {
+            return std::nullopt;
+        }
+
+        std::optional<shader_key_t> const current{content_hash(
+            std::u8string{include_path.cbegin(), include_path.cend()})};
+        if (!current || *current != include_hash)
+        {
+            return std::nullopt;
+        }
+    }
+
+    cached_shader_t rv;
+    if (!reader.values(rv.code) || !reader.values(rv.bindings))
+    {
+        return std::nullopt;
+    }
+
+    return rv;
+}
+
+std::expected<void, std::error_code> vkglsl::write_cached_shader(
+    shader_key_t const& key,
+    std::span<shader_include_t const> const& includes,
+    cached_shader_t const& shader)
+{
+    if (cache_directory_.empty())
+    {
+        return {};
+    }
+
+    std::error_code ec;
+    create_directories(cache_directory_, ec);
+    if (ec)
+    {
+        return std::unexpected{ec};
+    }
+
+    std::vector<std::byte> buffer;
+    append(buffer, magic);
+    append(buffer, version);
+    append(buffer, key);
+
+    append(buffer, uint64_t{includes.size()});
+    for (shader_include_t const& include : includes)
+    {
+        std::u8string const path{include.path.u8string()};
+        append(buffer, std::span{path.data(), path.size()});
+        append(buffer, include.content_hash);
+    }
+
+    append(buffer, std::span{shader.code});
+    append(buffer, std::span{shader.bindings});
+
+    std::filesystem::path const target{cached_path(key)};
+
+    // Same shader may be written by multiple threads, each one writes to its
+    // own temporary file and replaces the previous one when done
+    std::filesystem::path temporary{target};
+    temporary += fmt::format(".{}.tmp",
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    {
+        std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+        if (!stream.is_open())
+        {
+            return std::unexpected{std::make_error_code(std::errc::io_error)};
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        stream.write(reinterpret_cast<char const*>(buffer.data()),
+            static_cast<std::streamsize>(buffer.size()));
+
+        stream.flush();
+        if (!stream)
+        {
+            stream.close();
+
+            std::error_code remove_ec;
+            remove(temporary, remove_ec);
+
+            return std::unexpected{std::make_error_code(std::errc::io_error)};
+        }
+    }
+
+    rename(temporary, target, ec);
+    if (ec)
+    {
+        std::error_code remove_ec;
+        remove(temporary, remove_ec);
+
+        return std::unexpected{ec};
+    }
+
+    return {};
+}
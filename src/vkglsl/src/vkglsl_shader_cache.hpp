@@ -0,0 +1,60 @@
+#ifndef VKGLSL_SHADER_CACHE_INCLUDED
+#define VKGLSL_SHADER_CACHE_INCLUDED
+
+#include <volk.h>
+
+#include <array>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace vkglsl
+{
+    // Descriptor used by a shader, as reflected from its SPIR-V
+    struct [[nodiscard]] reflected_binding_t final
+    {
+        uint32_t set{};
+        uint32_t binding{};
+        VkDescriptorType type{};
+    };
+
+    // Content hash of the shader source and of every option that affects the
+    // result of compiling it
+    using shader_key_t = std::array<unsigned char, 16>;
+
+    // File included while compiling a shader, cached shader is considered
+    // stale if contents of any of its includes changed
+    struct [[nodiscard]] shader_include_t final
+    {
+        std::filesystem::path path;
+        shader_key_t content_hash{};
+    };
+
+    struct [[nodiscard]] cached_shader_t final
+    {
+        std::vector<uint32_t> code;
+        std::vector<reflected_binding_t> bindings;
+    };
+
+    // Empty path disables the cache
+    void set_cache_directory(std::filesystem::path const& directory);
+
+    [[nodiscard]] std::filesystem::path const& cache_directory();
+
+    [[nodiscard]] std::optional<shader_key_t> content_hash(
+        std::filesystem::path const& file);
+
+    [[nodiscard]] std::optional<cached_shader_t> read_cached_shader(
+        shader_key_t const& key);
+
+    [[nodiscard]] std::expected<void, std::error_code> write_cached_shader(
+        shader_key_t const& key,
+        std::span<shader_include_t const> const& includes,
+        cached_shader_t const& shader);
+} // namespace vkglsl
+
+#endif
@@ -1,11 +1,12 @@
 #include <vkglsl_shader_set.hpp>
 
 #include <vkglsl_glslang_adapter.hpp>
+#include <vkglsl_shader_cache.hpp>
 #include <vkglsl_spirv_cross_adapter.hpp>
 
+#include <cppext_mapped_file.hpp>
 #include <cppext_numeric.hpp>
 #include <cppext_pragma_warning.hpp>
-#include <cppext_read_file.hpp>
 
 #include <vkrndr_descriptors.hpp>
 #include <vkrndr_shader_module.hpp>
@@ -16,6 +17,10 @@ DISABLE_WARNING_STRINGOP_OVERFLOW
 #include <fmt/std.h> // IWYU pragma: keep
 DISABLE_WARNING_POP
 
+#include <BS_thread_pool.hpp>
+
+#include <boost/hash2/md5.hpp>
+
 #include <glslang/Public/ResourceLimits.h>
 #include <glslang/Public/ShaderLang.h>
 #include <glslang/SPIRV/GlslangToSpv.h>
@@ -33,12 +38,13 @@ DISABLE_WARNING_POP
 #include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
-#include <tuple>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -48,8 +54,8 @@ namespace glslang
     class TIntermediate;
 } // namespace glslang
 
+// IWYU pragma: no_include <boost/hash2/digest.hpp>
 // IWYU pragma: no_include <fmt/base.h>
-// IWYU pragma: no_include <optional>
 
 namespace
 {
@@ -57,8 +63,58 @@ namespace
     {
         std::string entry_point;
         std::vector<uint32_t> code;
+        std::vector<vkglsl::reflected_binding_t> bindings;
     };
 
+    [[nodiscard]] std::vector<vkglsl::reflected_binding_t> reflect(
+        std::span<uint32_t const> const& code)
+    {
+        std::vector<vkglsl::reflected_binding_t> rv;
+
+        spirv_cross::Compiler compiler{code.data(), code.size()};
+
+        auto const declare_resources =
+            [&](spirv_cross::SmallVector<spirv_cross::Resource> const&
+                    resources,
+                VkDescriptorType const type)
+        {
+            for (spirv_cross::Resource const& resource : resources)
+            {
+                std::optional<uint32_t> const set{
+                    vkglsl::resource_decoration(compiler,
+                        resource,
+                        spv::DecorationDescriptorSet)};
+                if (!set)
+                {
+                    continue;
+                }
+
+                rv.emplace_back(*set,
+                    compiler.get_decoration(resource.id,
+                        spv::DecorationBinding),
+                    type);
+            }
+        };
+
+        spirv_cross::ShaderResources const resources{
+            compiler.get_shader_resources()};
+
+        declare_resources(resources.sampled_images,
+            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+        declare_resources(resources.uniform_buffers,
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+        declare_resources(resources.storage_buffers,
+            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+        declare_resources(resources.separate_samplers,
+            VK_DESCRIPTOR_TYPE_SAMPLER);
+        declare_resources(resources.separate_images,
+            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+        declare_resources(resources.storage_images,
+            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+
+        return rv;
+    }
+
     [[nodiscard]] std::string preamble(
         std::span<std::string_view const> const& defines)
     {
@@ -87,6 +143,12 @@ namespace
     public:
         bool add_include_directory(std::filesystem::path const& path);
 
+        [[nodiscard]] std::span<std::filesystem::path const>
+        include_directories() const;
+
+        // Files resolved since the last call, with hashes of their contents
+        [[nodiscard]] std::vector<vkglsl::shader_include_t> take_includes();
+
     public: // Includer overrides
         IncludeResult* includeSystem(char const* header_name,
             char const* includer_name,
@@ -106,7 +168,7 @@ namespace
     private:
         struct [[nodiscard]] include_data_t final
         {
-            std::vector<char> data;
+            cppext::mapped_file_t file;
         };
 
     private:
@@ -116,6 +178,7 @@ namespace
     private:
         // cppcheck-suppress unusedStructMember
         std::vector<std::filesystem::path> include_directories_;
+        std::vector<vkglsl::shader_include_t> includes_;
     };
 
     bool includer_t::add_include_directory(std::filesystem::path const& path)
@@ -136,6 +199,17 @@ namespace
         return true;
     }
 
+    std::span<std::filesystem::path const>
+    includer_t::include_directories() const
+    {
+        return include_directories_;
+    }
+
+    std::vector<vkglsl::shader_include_t> includer_t::take_includes()
+    {
+        return std::exchange(includes_, {});
+    }
+
     glslang::TShader::Includer::IncludeResult* includer_t::includeSystem(
         [[maybe_unused]] char const* const header_name,
         [[maybe_unused]] char const* const includer_name,
@@ -183,17 +257,234 @@ namespace
     glslang::TShader::Includer::IncludeResult* includer_t::result_for_path(
         std::filesystem::path const& path)
     {
-        auto user_data{
-            std::make_unique<include_data_t>(cppext::read_file(path))};
+        auto user_data{std::make_unique<include_data_t>(
+            cppext::mapped_file_t{path})};
+
+        boost::hash2::md5_128 hash;
+        hash.update(user_data->file.bytes().data(), user_data->file.size());
+
+        vkglsl::shader_include_t& include{
+            includes_.emplace_back(absolute(path))};
+        std::ranges::copy(hash.result(), include.content_hash.begin());
+
         auto rv{std::make_unique<IncludeResult>(path.string(),
-            user_data->data.data(),
-            user_data->data.size(),
+            user_data->file.chars().data(),
+            user_data->file.size(),
             user_data.get())};
 
         static_cast<void>(user_data.release());
 
         return rv.release();
     }
+
+    [[nodiscard]] std::expected<cppext::mapped_file_t, std::error_code>
+    map_source(std::filesystem::path const& file)
+    {
+        try
+        {
+            return cppext::mapped_file_t{file};
+        }
+        catch (std::system_error const& ex)
+        {
+            spdlog::error("Shader source '{}' not loaded: {}", file, ex.what());
+            return std::unexpected{ex.code()};
+        }
+    }
+
+    // Bump when compilation settings which aren't part of the key change
+    constexpr uint32_t shader_key_version{1};
+
+    [[nodiscard]] vkglsl::shader_key_t shader_key(EShLanguage const language,
+        std::span<char const> const& glsl_source,
+        std::string_view const source_name,
+        std::span<std::string_view const> const& preprocessor_defines,
+        std::string_view const entry_point,
+        std::span<std::filesystem::path const> const& include_directories,
+        bool const with_debug_info,
+        bool const optimize)
+    {
+        boost::hash2::md5_128 hash;
+
+        auto const update_value = [&hash](auto const& value)
+        { hash.update(&value, sizeof(value)); };
+
+        // Strings are terminated to keep adjacent values apart
+        auto const update_string = [&hash](std::string_view const value)
+        {
+            hash.update(value.data(), value.size());
+            hash.update("", 1);
+        };
+
+        glslang::Version const glslang_version{glslang::GetVersion()};
+
+        update_value(shader_key_version);
+        update_value(glslang_version.major);
+        update_value(glslang_version.minor);
+        update_value(glslang_version.patch);
+        update_value(language);
+        update_value(with_debug_info);
+        update_value(optimize);
+        update_string(entry_point);
+        update_string(source_name);
+
+        update_value(preprocessor_defines.size());
+        for (std::string_view const define : preprocessor_defines)
+        {
+            update_string(define);
+        }
+
+        // Local includes are resolved relative to the working directory first
+        update_string(std::filesystem::current_path().string());
+        update_value(include_directories.size());
+        for (std::filesystem::path const& directory : include_directories)
+        {
+            update_string(directory.string());
+        }
+
+        hash.update(glsl_source.data(), glsl_source.size());
+
+        vkglsl::shader_key_t rv{};
+        std::ranges::copy(hash.result(), rv.begin());
+        return rv;
+    }
+
+    // Includer is taken by value, each compilation records its own includes
+    // and can run on any thread
+    [[nodiscard]] std::expected<compiled_shader_t, std::error_code> compile(
+        includer_t includer,
+        EShLanguage const language,
+        std::span<char const> const& glsl_source,
+        std::string_view const source_name,
+        std::span<std::string_view const> const& preprocessor_defines,
+        std::string_view const entry_point,
+        bool const with_debug_info,
+        bool const optimize)
+    {
+        // NOLINTNEXTLINE(misc-const-correctness)
+        std::string entry_point_str{entry_point};
+
+        std::optional<vkglsl::shader_key_t> key;
+        if (!vkglsl::cache_directory().empty())
+        {
+            key = shader_key(language,
+                glsl_source,
+                source_name,
+                preprocessor_defines,
+                entry_point,
+                includer.include_directories(),
+                with_debug_info,
+                optimize);
+
+            if (std::optional<vkglsl::cached_shader_t> cached{
+                    vkglsl::read_cached_shader(*key)})
+            {
+                return compiled_shader_t{
+                    .entry_point = std::move(entry_point_str),
+                    .code = std::move(cached->code),
+                    .bindings = std::move(cached->bindings)};
+            }
+        }
+
+        std::string const preamble_str{preamble(preprocessor_defines)};
+
+        glslang::TShader shader{language};
+
+        shader.setPreamble(preamble_str.c_str());
+
+        shader.setEnvInput(glslang::EShSourceGlsl,
+            language,
+            glslang::EShClientVulkan,
+            100);
+        shader.setEnvClient(glslang::EShClientVulkan,
+            glslang::EShTargetVulkan_1_3);
+        shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_6);
+        shader.setDebugInfo(with_debug_info);
+
+        std::string const source_name_str{source_name};
+
+        std::array const strings{glsl_source.data()};
+        std::array const lengths{cppext::narrow<int>(glsl_source.size())};
+        std::array const names{source_name_str.c_str()};
+        shader.setStringsWithLengthsAndNames(strings.data(),
+            lengths.data(),
+            names.data(),
+            1);
+        shader.setEntryPoint(entry_point_str.c_str());
+        shader.setSourceEntryPoint(entry_point_str.c_str());
+
+        EShMessages messages{
+            static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules)};
+        if (with_debug_info)
+        {
+            messages = static_cast<EShMessages>(messages | EShMsgDebugInfo);
+        }
+
+        if (!shader.parse(GetDefaultResources(),
+                460,
+                EProfile::ECoreProfile,
+                false,
+                false,
+                messages,
+                includer))
+        {
+            spdlog::error("Shader compilation failed: {}\n{}\n",
+                shader.getInfoLog(),
+                shader.getInfoDebugLog());
+            return std::unexpected{
+                std::make_error_code(std::errc::executable_format_error)};
+        }
+
+        glslang::TProgram program;
+        program.addShader(&shader);
+
+        if (!program.link(EShMsgDefault))
+        {
+            spdlog::error("Shader linking failed: {}\n{}\n",
+                program.getInfoLog(),
+                program.getInfoDebugLog());
+            return std::unexpected{
+                std::make_error_code(std::errc::executable_format_error)};
+        }
+
+        glslang::TIntermediate const* const intermediate{
+            program.getIntermediate(language)};
+
+        glslang::SpvOptions spv_options{};
+        spv_options.generateDebugInfo = with_debug_info;
+        spv_options.emitNonSemanticShaderDebugInfo = with_debug_info;
+        spv_options.emitNonSemanticShaderDebugSource = with_debug_info;
+        spv_options.disableOptimizer = optimize;
+
+        std::vector<uint32_t> binary;
+        static_assert(std::is_same_v<uint32_t, unsigned int>);
+        glslang::GlslangToSpv(*intermediate, binary, &spv_options);
+
+        std::vector<vkglsl::reflected_binding_t> bindings{reflect(binary)};
+
+        if (key)
+        {
+            std::vector<vkglsl::shader_include_t> const includes{
+                includer.take_includes()};
+
+            vkglsl::cached_shader_t cached{.code = std::move(binary),
+                .bindings = std::move(bindings)};
+            if (auto const result{
+                    vkglsl::write_cached_shader(*key, includes, cached)};
+                !result)
+            {
+                spdlog::warn("Shader '{}' not cached: {}",
+                    source_name,
+                    result.error().message());
+            }
+
+            binary = std::move(cached.code);
+            bindings = std::move(cached.bindings);
+        }
+
+        return compiled_shader_t{.entry_point = std::move(entry_point_str),
+            .code = std::move(binary),
+            .bindings = std::move(bindings)};
+    }
 } // namespace
 
 struct [[nodiscard]] vkglsl::shader_set_t::impl_t final
@@ -230,6 +521,24 @@ std::expected<void, std::error_code> vkglsl::shader_set_t::add_shader(
     std::filesystem::path const& file,
     std::span<std::string_view const> const& preprocessor_defines,
     std::string_view entry_point)
+{
+    return map_source(file).and_then(
+        [&](cppext::mapped_file_t&& glsl_source)
+        {
+            return add_shader(stage,
+                glsl_source.chars(),
+                file.string(),
+                preprocessor_defines,
+                entry_point);
+        });
+}
+
+std::expected<void, std::error_code> vkglsl::shader_set_t::add_shader(
+    VkShaderStageFlagBits const stage,
+    std::span<char const> const& glsl_source,
+    std::string_view const source_name,
+    std::span<std::string_view const> const& preprocessor_defines,
+    std::string_view entry_point)
 {
     EShLanguage const language{to_glslang(stage)};
     if (impl_->shaders.contains(language))
@@ -238,86 +547,94 @@ std::expected<void, std::error_code> vkglsl::shader_set_t::add_shader(
         return std::unexpected{std::make_error_code(std::errc::file_exists)};
     }
 
-    std::string const preamble_str{preamble(preprocessor_defines)};
-
-    // NOLINTNEXTLINE(misc-const-correctness)
-    std::string entry_point_str{entry_point};
-
-    glslang::TShader shader{language};
-
-    shader.setPreamble(preamble_str.c_str());
-
-    shader.setEnvInput(glslang::EShSourceGlsl,
+    return compile(impl_->includer,
         language,
-        glslang::EShClientVulkan,
-        100);
-    shader.setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_3);
-    shader.setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_6);
-    shader.setDebugInfo(impl_->with_debug_info);
-
-    auto const path_str{file.string()};
-    std::vector<char> const glsl_source{cppext::read_file(file)};
-
-    std::array const strings{glsl_source.data()};
-    std::array const lengths{cppext::narrow<int>(glsl_source.size())};
-    std::array const names{path_str.c_str()};
-    shader.setStringsWithLengthsAndNames(strings.data(),
-        lengths.data(),
-        names.data(),
-        1);
-    shader.setEntryPoint(entry_point_str.c_str());
-    shader.setSourceEntryPoint(entry_point_str.c_str());
-
-    EShMessages messages{
-        static_cast<EShMessages>(EShMsgSpvRules | EShMsgVulkanRules)};
-    if (impl_->with_debug_info)
+        glsl_source,
+        source_name,
+        preprocessor_defines,
+        entry_point,
+        impl_->with_debug_info,
+        impl_->optimize)
+        .transform([this, language](compiled_shader_t&& shader)
+            { impl_->shaders.emplace(language, std::move(shader)); });
+}
+
+std::expected<void, std::error_code> vkglsl::shader_set_t::add_shaders(
+    std::span<shader_source_t const> const& sources,
+    BS::thread_pool<>* const thread_pool)
+{
+    for (auto it{std::cbegin(sources)}; it != std::cend(sources); ++it)
     {
-        messages = static_cast<EShMessages>(messages | EShMsgDebugInfo);
+        EShLanguage const language{to_glslang(it->stage)};
+        if (impl_->shaders.contains(language) ||
+            std::ranges::any_of(std::cbegin(sources),
+                it,
+                [language](shader_source_t const& source)
+                { return to_glslang(source.stage) == language; }))
+        {
+            spdlog::error("Shader stage already exists");
+            return std::unexpected{
+                std::make_error_code(std::errc::file_exists)};
+        }
     }
 
-    if (!shader.parse(GetDefaultResources(),
-            460,
-            EProfile::ECoreProfile,
-            false,
-            false,
-            messages,
-            impl_->includer))
+    auto const compile_at = [this, &sources](size_t const i)
     {
-        spdlog::error("Shader compilation failed: {}\n{}\n",
-            shader.getInfoLog(),
-            shader.getInfoDebugLog());
-        return std::unexpected{
-            std::make_error_code(std::errc::executable_format_error)};
-    }
+        shader_source_t const& source{sources[i]};
+        return map_source(source.file).and_then(
+            [&](cppext::mapped_file_t&& glsl_source)
+            {
+                return compile(impl_->includer,
+                    to_glslang(source.stage),
+                    glsl_source.chars(),
+                    source.file.string(),
+                    source.preprocessor_defines,
+                    source.entry_point,
+                    impl_->with_debug_info,
+                    impl_->optimize);
+            });
+    };
 
-    glslang::TProgram program;
-    program.addShader(&shader);
+    std::vector<std::expected<compiled_shader_t, std::error_code>> results;
+    results.reserve(sources.size());
 
-    if (!program.link(EShMsgDefault))
+    if (thread_pool && thread_pool->get_thread_count() > 1 &&
+        sources.size() > 1)
     {
-        spdlog::error("Shader linking failed: {}\n{}\n",
-            program.getInfoLog(),
-            program.getInfoDebugLog());
-        return std::unexpected{
-            std::make_error_code(std::errc::executable_format_error)};
-    }
+        BS::multi_future<std::expected<compiled_shader_t, std::error_code>>
+            futures{thread_pool->submit_sequence(size_t{},
+                sources.size(),
+                compile_at)};
 
-    glslang::TIntermediate const* const intermediate{
-        program.getIntermediate(language)};
+        // Tasks reference local state, all of them have to be finished
+        // before results are collected as collecting may throw
+        futures.wait();
 
-    glslang::SpvOptions spv_options{};
-    spv_options.generateDebugInfo = impl_->with_debug_info;
-    spv_options.emitNonSemanticShaderDebugInfo = impl_->with_debug_info;
-    spv_options.emitNonSemanticShaderDebugSource = impl_->with_debug_info;
-    spv_options.disableOptimizer = impl_->optimize;
+        for (auto& future : futures)
+        {
+            results.push_back(future.get());
+        }
+    }
+    else
+    {
+        for (size_t i{}; i != sources.size(); ++i)
+        {
+            results.push_back(compile_at(i));
+        }
+    }
 
-    std::vector<uint32_t> binary;
-    static_assert(std::is_same_v<uint32_t, unsigned int>);
-    glslang::GlslangToSpv(*intermediate, binary, &spv_options);
+    if (auto const it{std::ranges::find_if(results,
+            [](auto const& result) { return !result.has_value(); })};
+        it != std::cend(results))
+    {
+        return std::unexpected{it->error()};
+    }
 
-    impl_->shaders.emplace(std::piecewise_construct,
-        std::forward_as_tuple(language),
-        std::forward_as_tuple(std::move(entry_point_str), std::move(binary)));
+    for (size_t i{}; i != sources.size(); ++i)
+    {
+        impl_->shaders.emplace(to_glslang(sources[i].stage),
+            *std::move(results[i]));
+    }
 
     return {};
 }
@@ -334,11 +651,10 @@ std::expected<void, std::error_code> vkglsl::shader_set_t::add_shader_binary(
         return std::unexpected{std::make_error_code(std::errc::file_exists)};
     }
 
-    // NOLINTNEXTLINE(misc-const-correctness)
-    std::vector<uint32_t> temp{std::cbegin(binary), std::cend(binary)};
-    impl_->shaders.emplace(std::piecewise_construct,
-        std::forward_as_tuple(language),
-        std::forward_as_tuple(std::string{entry_point}, std::move(temp)));
+    impl_->shaders.emplace(language,
+        compiled_shader_t{.entry_point = std::string{entry_point},
+            .code = {std::cbegin(binary), std::cend(binary)},
+            .bindings = reflect(binary)});
 
     return {};
 }
@@ -397,53 +713,23 @@ vkglsl::shader_set_t::descriptor_bindings(uint32_t const set) const
 
     for (auto const& [lang, shader] : impl_->shaders)
     {
-        spirv_cross::Compiler compiler{shader.code};
-        auto const filter_descriptor_set =
-            [&compiler, set](spirv_cross::Resource const& resource)
-        {
-            return resource_decoration(compiler,
-                       resource,
-                       spv::DecorationDescriptorSet) == set;
-        };
-
-        auto const declare_resources =
-            [&](spirv_cross::SmallVector<spirv_cross::Resource> const&
-                    resources,
-                VkDescriptorType const type)
+        for (reflected_binding_t const& reflected : shader.bindings)
         {
-            for (spirv_cross::Resource const& resource :
-                std::views::filter(resources, filter_descriptor_set))
+            if (reflected.set != set)
             {
-                uint32_t const binding{compiler.get_decoration(resource.id,
-                    spv::DecorationBinding)};
-
-                auto& bind_point{binding_for(binding)};
-                bind_point.descriptorType = type;
-                bind_point.descriptorCount = 1;
-
-                DISABLE_WARNING_PUSH
-                DISABLE_WARNING_SIGN_CONVERSION
-                // NOLINTNEXTLINE(modernize-type-traits) - FP
-                bind_point.stageFlags |= to_vulkan(lang);
-                DISABLE_WARNING_POP
+                continue;
             }
-        };
 
-        spirv_cross::ShaderResources const resources{
-            compiler.get_shader_resources()};
+            auto& bind_point{binding_for(reflected.binding)};
+            bind_point.descriptorType = reflected.type;
+            bind_point.descriptorCount = 1;
 
-        declare_resources(resources.sampled_images,
-            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
-        declare_resources(resources.uniform_buffers,
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
-        declare_resources(resources.storage_buffers,
-            VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
-        declare_resources(resources.separate_samplers,
-            VK_DESCRIPTOR_TYPE_SAMPLER);
-        declare_resources(resources.separate_images,
-            VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
-        declare_resources(resources.storage_images,
-            VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+            DISABLE_WARNING_PUSH
+            DISABLE_WARNING_SIGN_CONVERSION
+            // NOLINTNEXTLINE(modernize-type-traits) - FP
+            bind_point.stageFlags |= to_vulkan(lang);
+            DISABLE_WARNING_POP
+        }
     }
 
     return rv;
@@ -461,6 +747,40 @@ vkglsl::add_shader_module_from_path(shader_set_t& shader_set,
         .and_then([&]() { return shader_set.shader_module(device, stage); });
 }
 
+std::expected<std::vector<vkrndr::shader_module_t>, std::error_code>
+vkglsl::add_shader_modules_from_paths(shader_set_t& shader_set,
+    vkrndr::device_t const& device,
+    std::span<shader_source_t const> const& sources,
+    BS::thread_pool<>* const thread_pool)
+{
+    if (auto const result{shader_set.add_shaders(sources, thread_pool)};
+        !result)
+    {
+        return std::unexpected{result.error()};
+    }
+
+    std::vector<vkrndr::shader_module_t> rv;
+    rv.reserve(sources.size());
+    for (shader_source_t const& source : sources)
+    {
+        std::expected<vkrndr::shader_module_t, std::error_code> module{
+            shader_set.shader_module(device, source.stage)};
+        if (!module)
+        {
+            for (vkrndr::shader_module_t const& created : rv)
+            {
+                destroy(device, created);
+            }
+
+            return std::unexpected{module.error()};
+        }
+
+        rv.push_back(*std::move(module));
+    }
+
+    return rv;
+}
+
 std::expected<vkrndr::shader_module_t, std::error_code>
 vkglsl::add_shader_binary_from_path(shader_set_t& shader_set,
     vkrndr::device_t const& device,
@@ -468,10 +788,10 @@ vkglsl::add_shader_binary_from_path(shader_set_t& shader_set,
     std::filesystem::path const& file,
     std::string_view entry_point)
 {
-    std::vector<char> binary;
+    cppext::mapped_file_t binary;
     try
     {
-        binary = cppext::read_file(file);
+        binary = cppext::mapped_file_t{file};
     }
     catch (std::runtime_error const& ex)
     {
@@ -480,10 +800,11 @@ vkglsl::add_shader_binary_from_path(shader_set_t& shader_set,
             std::make_error_code(std::errc::no_such_file_or_directory)};
     }
 
+    // Mapping is page aligned, words of the binary are properly aligned
     return shader_set
         .add_shader_binary(stage,
             // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-            std::span{reinterpret_cast<uint32_t*>(binary.data()),
+            std::span{reinterpret_cast<uint32_t const*>(binary.bytes().data()),
                 binary.size() / 4},
             entry_point)
         .and_then([&]() { return shader_set.shader_module(device, stage); });
@@ -0,0 +1,233 @@
+#include <vkglsl_guard.hpp>
+#include <vkglsl_shader_set.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <volk.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    constexpr std::string_view shader_source{R"(#version 460
+#extension GL_GOOGLE_include_directive : require
+
+#include "vkglsl_cache_common.glsl"
+
+layout(local_size_x = 1) in;
+
+layout(set = 0, binding = 0) buffer Result
+{
+    uint value;
+} result;
+
+void main() { result.value = VALUE; }
+)"};
+
+    struct [[nodiscard]] cache_test_t final
+    {
+        std::filesystem::path root;
+        std::filesystem::path cache;
+        std::filesystem::path includes;
+        std::filesystem::path shader;
+    };
+
+    void write_file(std::filesystem::path const& path,
+        std::string_view const contents)
+    {
+        std::ofstream stream{path, std::ios::binary | std::ios::trunc};
+        stream.write(contents.data(),
+            static_cast<std::streamsize>(contents.size()));
+    }
+
+    [[nodiscard]] cache_test_t make_cache_test(char const* const name)
+    {
+        auto const root{std::filesystem::temp_directory_path() / name};
+        std::filesystem::remove_all(root);
+
+        cache_test_t rv{.root = root,
+            .cache = root / "cache",
+            .includes = root / "include",
+            .shader = root / "shader.comp"};
+
+        std::filesystem::create_directories(rv.includes);
+        write_file(rv.includes / "vkglsl_cache_common.glsl",
+            "#define VALUE 1u\n");
+        write_file(rv.shader, shader_source);
+
+        return rv;
+    }
+
+    [[nodiscard]] std::vector<uint32_t> compile(cache_test_t const& test,
+        std::span<std::filesystem::path const> const& include_directories,
+        std::span<std::string_view const> const& defines = {})
+    {
+        vkglsl::shader_set_t set;
+        for (std::filesystem::path const& directory : include_directories)
+        {
+            REQUIRE(set.add_include_directory(directory));
+        }
+
+        REQUIRE(set.add_shader(VK_SHADER_STAGE_COMPUTE_BIT,
+            test.shader,
+            defines));
+
+        std::vector<uint32_t> const* const binary{
+            set.shader_binary(VK_SHADER_STAGE_COMPUTE_BIT)};
+        REQUIRE(binary);
+        REQUIRE_FALSE(binary->empty());
+
+        return *binary;
+    }
+
+    [[nodiscard]] std::vector<std::filesystem::path> cached_files(
+        cache_test_t const& test)
+    {
+        std::vector<std::filesystem::path> rv;
+        for (std::filesystem::directory_entry const& entry :
+            std::filesystem::directory_iterator{test.cache})
+        {
+            rv.push_back(entry.path());
+        }
+        return rv;
+    }
+
+    // Cache entries are only written when the shader is compiled, an entry
+    // which keeps its old write time was read instead
+    void age(std::filesystem::path const& path)
+    {
+        std::filesystem::last_write_time(path,
+            std::filesystem::file_time_type::clock::now() -
+                std::chrono::hours{1});
+    }
+
+    [[nodiscard]] bool is_aged(std::filesystem::path const& path)
+    {
+        return std::filesystem::last_write_time(path) <
+            std::filesystem::file_time_type::clock::now() -
+            std::chrono::minutes{30};
+    }
+} // namespace
+
+TEST_CASE("Identical compile is read from the shader cache",
+    "[vkglsl][shader_cache]")
+{
+    cache_test_t const test{make_cache_test("vkglsl_cache_hit")};
+    vkglsl::guard_t const guard{test.cache};
+
+    std::array const directories{test.includes};
+
+    std::vector<uint32_t> const compiled{compile(test, directories)};
+
+    std::vector<std::filesystem::path> const files{cached_files(test)};
+    REQUIRE(files.size() == 1);
+    age(files.front());
+
+    CHECK(compile(test, directories) == compiled);
+    CHECK(cached_files(test) == files);
+    CHECK(is_aged(files.front()));
+
+    std::filesystem::remove_all(test.root);
+}
+
+TEST_CASE("Changed define misses the shader cache", "[vkglsl][shader_cache]")
+{
+    cache_test_t const test{make_cache_test("vkglsl_cache_define")};
+    vkglsl::guard_t const guard{test.cache};
+
+    std::array const directories{test.includes};
+    std::array const defines{std::string_view{"UNUSED_OPTION"}};
+
+    static_cast<void>(compile(test, directories));
+
+    std::vector<std::filesystem::path> const files{cached_files(test)};
+    REQUIRE(files.size() == 1);
+    age(files.front());
+
+    static_cast<void>(compile(test, directories, defines));
+    CHECK(cached_files(test).size() == 2);
+    CHECK(is_aged(files.front()));
+
+    std::filesystem::remove_all(test.root);
+}
+
+TEST_CASE("Changed include directory misses the shader cache",
+    "[vkglsl][shader_cache]")
+{
+    cache_test_t const test{make_cache_test("vkglsl_cache_include_dir")};
+    vkglsl::guard_t const guard{test.cache};
+
+    auto const other_directory{test.root / "other"};
+    std::filesystem::create_directories(other_directory);
+
+    std::array const directories{test.includes};
+    std::array const more_directories{test.includes, other_directory};
+
+    std::vector<uint32_t> const compiled{compile(test, directories)};
+
+    std::vector<std::filesystem::path> const files{cached_files(test)};
+    REQUIRE(files.size() == 1);
+    age(files.front());
+
+    CHECK(compile(test, more_directories) == compiled);
+    CHECK(cached_files(test).size() == 2);
+    CHECK(is_aged(files.front()));
+
+    std::filesystem::remove_all(test.root);
+}
+
+TEST_CASE("Changed included file misses the shader cache",
+    "[vkglsl][shader_cache]")
+{
+    cache_test_t const test{make_cache_test("vkglsl_cache_include_file")};
+    vkglsl::guard_t const guard{test.cache};
+
+    std::array const directories{test.includes};
+
+    std::vector<uint32_t> const compiled{compile(test, directories)};
+
+    std::vector<std::filesystem::path> const files{cached_files(test)};
+    REQUIRE(files.size() == 1);
+    age(files.front());
+
+    write_file(test.includes / "vkglsl_cache_common.glsl",
+        "#define VALUE 2u\n");
+
+    // Key of the shader doesn't change, the stale entry is replaced
+    CHECK(compile(test, directories) != compiled);
+    CHECK(cached_files(test) == files);
+    CHECK_FALSE(is_aged(files.front()));
+
+    std::filesystem::remove_all(test.root);
+}
+
+TEST_CASE("Corrupted shader cache entry is rejected", "[vkglsl][shader_cache]")
+{
+    cache_test_t const test{make_cache_test("vkglsl_cache_corrupted")};
+    vkglsl::guard_t const guard{test.cache};
+
+    std::array const directories{test.includes};
+
+    std::vector<uint32_t> const compiled{compile(test, directories)};
+
+    std::vector<std::filesystem::path> const files{cached_files(test)};
+    REQUIRE(files.size() == 1);
+
+    auto const size{std::filesystem::file_size(files.front())};
+    std::filesystem::resize_file(files.front(), size / 2);
+    age(files.front());
+
+    CHECK(compile(test, directories) == compiled);
+    CHECK_FALSE(is_aged(files.front()));
+    CHECK(std::filesystem::file_size(files.front()) == size);
+
+    std::filesystem::remove_all(test.root);
+}
@@ -2,11 +2,15 @@
 #define VKRNDR_BACKEND_INCLUDED
 
 #include <vkrndr_commands.hpp>
+#include <vkrndr_descriptor_heap.hpp>
 #include <vkrndr_device.hpp>
 #include <vkrndr_error_code.hpp>
 #include <vkrndr_image.hpp>
+#include <vkrndr_linear_allocator.hpp>
+#include <vkrndr_pipeline_compiler.hpp>
 #include <vkrndr_rendering_context.hpp>
 #include <vkrndr_synchronization.hpp>
+#include <vkrndr_upload_queue.hpp>
 #include <vkrndr_utility.hpp>
 
 #include <cppext_container.hpp>
@@ -57,14 +61,35 @@ namespace vkrndr
 
         [[nodiscard]] uint32_t frames_in_flight() const;
 
+        // Uploads recorded during a frame are submitted at the beginning of
+        // the next one, unless submitted explicitly
+        [[nodiscard]] upload_queue_t& upload_queue();
+
+        [[nodiscard]] pipeline_compiler_t& pipeline_compiler();
+
+        // Released slots are recycled at the beginning of frames
+        [[nodiscard]] descriptor_heap_t& descriptor_heap();
+
+        // Transient vertex, index, indirect, uniform and storage data valid
+        // for the current frame
+        [[nodiscard]] linear_allocator_t& frame_allocator();
+
         void begin_frame();
 
         [[nodiscard]] std::span<VkCommandBuffer const> present_buffers();
 
         void end_frame();
 
+        // Command buffers are submitted in order of requests, requests have
+        // to be made from the thread that renders the frame
         [[nodiscard]] VkCommandBuffer request_command_buffer();
 
+        // Each command buffer is allocated from its own pool and can be
+        // recorded on a different thread. Span is valid until the next
+        // request.
+        [[nodiscard]] std::span<VkCommandBuffer const>
+        request_parallel_command_buffers(uint32_t count);
+
         template<typename Func>
         std::expected<std::invoke_result_t<Func, VkCommandBuffer>,
             std::error_code>
@@ -93,6 +118,12 @@ namespace vkrndr
         backend_t& operator=(backend_t&&) noexcept = delete;
 
     private: // Types
+        struct [[nodiscard]] recording_pool_t final
+        {
+            VkCommandPool pool{VK_NULL_HANDLE};
+            VkCommandBuffer buffer{VK_NULL_HANDLE};
+        };
+
         struct [[nodiscard]] frame_data_t final
         {
             execution_port_t* present_queue{};
@@ -101,6 +132,12 @@ namespace vkrndr
             std::vector<VkCommandBuffer> present_command_buffers;
             size_t used_present_command_buffers{};
 
+            std::vector<recording_pool_t> recording_pools;
+            size_t used_recording_pools{};
+
+            // Requested command buffers in order of submission
+            std::vector<VkCommandBuffer> recorded_command_buffers;
+
             execution_port_t* transfer_queue{};
             VkCommandPool transfer_transient_command_pool{VK_NULL_HANDLE};
 
@@ -113,6 +150,14 @@ namespace vkrndr
         VkDescriptorPool descriptor_pool_;
 
         cppext::cycled_buffer_t<frame_data_t> frame_data_;
+
+        std::unique_ptr<upload_queue_t> upload_queue_;
+
+        std::unique_ptr<pipeline_compiler_t> pipeline_compiler_;
+
+        std::unique_ptr<descriptor_heap_t> descriptor_heap_;
+
+        std::unique_ptr<linear_allocator_t> frame_allocator_;
     };
 } // namespace vkrndr
 
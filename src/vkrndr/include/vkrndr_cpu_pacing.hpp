@@ -1,16 +1,13 @@
 #ifndef VKRNDR_CPU_PACING_INCLUDED
 #define VKRNDR_CPU_PACING_INCLUDED
 
-#include <boost/container/deque.hpp>
-
 #include <volk.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <vector>
 
-// IWYU pragma: no_include <utility>
-
 namespace vkrndr
 {
     struct device_t;
@@ -22,12 +19,16 @@ namespace vkrndr
     {
         uint32_t index{};
 
-        VkFence submit_fence{VK_NULL_HANDLE};
-
-        boost::container::deque<std::function<void()>> cleanup;
-        boost::container::deque<std::function<void()>> old_cleanup_queue;
+        // Value signaled on the pacing timeline semaphore once the
+        // submission of the frame is complete
+        uint64_t timeline_value{};
     };
 
+    // Paces frames with a single timeline semaphore, the submission of each
+    // frame signals the next value of the timeline.
+    //
+    // Deferred actions are keyed by the last value given to a frame and run
+    // once the timeline reaches it.
     class [[nodiscard]] cpu_pacing_t final
     {
     public:
@@ -38,6 +39,7 @@ namespace vkrndr
         cpu_pacing_t(cpu_pacing_t&&) noexcept = delete;
 
     public:
+        // Runs all deferred actions, submitted frames have to be complete
         ~cpu_pacing_t();
 
     public:
@@ -45,22 +47,53 @@ namespace vkrndr
 
         [[nodiscard]] frame_in_flight_t const& current() const noexcept;
 
+        [[nodiscard]] VkSemaphore timeline() const noexcept;
+
+        // Waits for the previous submission of the current frame and runs
+        // deferred actions of completed frames
         [[nodiscard]] frame_in_flight_t* pace(uint64_t timeout = 0);
 
+        // Assigns the next timeline value to the current frame
         void begin_frame();
 
         void end_frame();
 
+        // Action runs once the device is done with frames that have begun
+        void defer(std::function<void()> action);
+
     public:
         cpu_pacing_t& operator=(cpu_pacing_t const&) = delete;
 
         cpu_pacing_t& operator=(cpu_pacing_t&&) noexcept = delete;
 
+    private:
+        struct [[nodiscard]] deferred_action_t final
+        {
+            uint64_t value{};
+            std::function<void()> action;
+        };
+
+    private:
+        [[nodiscard]] deferred_action_t& deferred_at(size_t offset);
+
+        void grow_deferred();
+
+        void run_deferred(uint64_t completed_value);
+
     private:
         device_t const* device_;
         std::vector<frame_in_flight_t> frames_;
         uint32_t frames_in_flight_;
         uint32_t current_frame_{};
+
+        VkSemaphore timeline_{VK_NULL_HANDLE};
+        uint64_t last_value_{};
+
+        // Ring of actions ordered by value, completed actions are taken from
+        // the head and their slots reused by later deferrals
+        std::vector<deferred_action_t> deferred_;
+        size_t deferred_head_{};
+        size_t deferred_count_{};
     };
 } // namespace vkrndr
 
@@ -75,4 +108,9 @@ vkrndr::cpu_pacing_t::current() const noexcept
     return frames_[current_frame_];
 }
 
+inline VkSemaphore vkrndr::cpu_pacing_t::timeline() const noexcept
+{
+    return timeline_;
+}
+
 #endif
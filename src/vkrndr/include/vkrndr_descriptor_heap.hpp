@@ -0,0 +1,146 @@
+#ifndef VKRNDR_DESCRIPTOR_HEAP_INCLUDED
+#define VKRNDR_DESCRIPTOR_HEAP_INCLUDED
+
+#include <volk.h>
+
+#include <cstdint>
+#include <expected>
+#include <system_error>
+#include <vector>
+
+namespace vkrndr
+{
+    struct buffer_t;
+    struct device_t;
+} // namespace vkrndr
+
+namespace vkrndr
+{
+    struct [[nodiscard]] descriptor_heap_capacity_t final
+    {
+        uint32_t sampled_images{4096};
+        uint32_t samplers{256};
+        uint32_t storage_buffers{4096};
+    };
+
+    // Single update after bind descriptor set shared by all passes. Shaders
+    // index sampled images, samplers and storage buffers with slots allocated
+    // from the heap, bindings are partially bound and the storage buffer
+    // binding has a variable descriptor count.
+    //
+    // Released slots are reused only after frames in flight frames have
+    // begun, submitted work may still read their descriptors until then.
+    //
+    // Not thread safe.
+    class [[nodiscard]] descriptor_heap_t final
+    {
+    public: // Constants
+        static constexpr uint32_t sampled_image_binding{0};
+        static constexpr uint32_t sampler_binding{1};
+        static constexpr uint32_t storage_buffer_binding{2};
+
+    public: // Construction
+        descriptor_heap_t(device_t const& device,
+            uint32_t frames_in_flight,
+            descriptor_heap_capacity_t const& capacity = {});
+
+        descriptor_heap_t(descriptor_heap_t const&) = delete;
+
+        descriptor_heap_t(descriptor_heap_t&&) noexcept = delete;
+
+    public: // Destruction
+        ~descriptor_heap_t();
+
+    public: // Interface
+        [[nodiscard]] VkDescriptorSetLayout descriptor_layout() const noexcept;
+
+        [[nodiscard]] VkDescriptorSet descriptor_set() const noexcept;
+
+        [[nodiscard]] std::expected<uint32_t, std::error_code>
+        add_sampled_image(VkImageView view,
+            VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        [[nodiscard]] std::expected<uint32_t, std::error_code> add_sampler(
+            VkSampler sampler);
+
+        [[nodiscard]] std::expected<uint32_t, std::error_code>
+        add_storage_buffer(buffer_t const& buffer,
+            VkDeviceSize offset = 0,
+            VkDeviceSize range = VK_WHOLE_SIZE);
+
+        // Slot may be in use by submitted work, descriptor is replaced
+        // without waiting for it
+        void update_sampled_image(uint32_t slot,
+            VkImageView view,
+            VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        void update_storage_buffer(uint32_t slot,
+            buffer_t const& buffer,
+            VkDeviceSize offset = 0,
+            VkDeviceSize range = VK_WHOLE_SIZE);
+
+        void release_sampled_image(uint32_t slot);
+
+        void release_sampler(uint32_t slot);
+
+        void release_storage_buffer(uint32_t slot);
+
+        // Slots released frames in flight frames ago become available
+        void begin_frame();
+
+        void bind_on(VkCommandBuffer command_buffer,
+            VkPipelineLayout layout,
+            VkPipelineBindPoint bind_point,
+            uint32_t set) const;
+
+    public: // Operators
+        descriptor_heap_t& operator=(descriptor_heap_t const&) = delete;
+
+        descriptor_heap_t& operator=(descriptor_heap_t&&) noexcept = delete;
+
+    private: // Types
+        struct [[nodiscard]] retired_slot_t final
+        {
+            uint64_t frame{};
+            uint32_t slot{};
+        };
+
+        struct [[nodiscard]] slots_t final
+        {
+            uint32_t capacity{};
+            // Slots above this one were never allocated
+            uint32_t next{};
+            std::vector<uint32_t> free;
+            std::vector<retired_slot_t> retired;
+        };
+
+    private: // Helpers
+        [[nodiscard]] static std::expected<uint32_t, std::error_code> allocate(
+            slots_t& slots);
+
+        void release(slots_t& slots, uint32_t slot);
+
+        void recycle(slots_t& slots) const;
+
+        void write(uint32_t binding,
+            VkDescriptorType type,
+            uint32_t slot,
+            VkDescriptorImageInfo const* image_info,
+            VkDescriptorBufferInfo const* buffer_info) const;
+
+    private: // Data
+        device_t const* device_;
+        uint32_t frames_in_flight_;
+        uint64_t frame_{};
+
+        VkDescriptorSetLayout layout_{VK_NULL_HANDLE};
+        VkDescriptorPool pool_{VK_NULL_HANDLE};
+        VkDescriptorSet set_{VK_NULL_HANDLE};
+
+        slots_t sampled_images_;
+        slots_t samplers_;
+        slots_t storage_buffers_;
+    };
+} // namespace vkrndr
+
+#endif
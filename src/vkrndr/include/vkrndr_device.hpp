@@ -45,6 +45,10 @@ namespace vkrndr
 
         VmaAllocator allocator{VK_NULL_HANDLE};
 
+        // Used by all pipeline builders, see load_pipeline_cache and
+        // save_pipeline_cache for persistence
+        VkPipelineCache pipeline_cache{VK_NULL_HANDLE};
+
     public:
         device_t() = default;
 
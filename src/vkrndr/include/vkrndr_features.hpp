@@ -135,6 +135,11 @@ namespace vkrndr
         vkrndr::feature_chain_t features;
     };
 
+    // Queue family which supports transfers but neither graphics nor compute,
+    // such families are usually backed by dedicated copy engines
+    [[nodiscard]] std::optional<queue_family_t> find_dedicated_transfer_family(
+        physical_device_features_t const& device);
+
     [[nodiscard]] std::vector<physical_device_features_t>
     query_available_physical_devices(VkInstance instance,
         uint32_t max_api_version,
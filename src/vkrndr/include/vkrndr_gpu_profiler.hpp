@@ -0,0 +1,149 @@
+#ifndef VKRNDR_GPU_PROFILER_INCLUDED
+#define VKRNDR_GPU_PROFILER_INCLUDED
+
+#include <cppext_cycled_buffer.hpp>
+
+#include <volk.h>
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vkrndr
+{
+    struct device_t;
+} // namespace vkrndr
+
+namespace vkrndr
+{
+    struct [[nodiscard]] gpu_scope_timing_t final
+    {
+        std::string_view name;
+        double milliseconds{};
+        // Values of requested pipeline statistics in order of flag bits,
+        // empty if statistics weren't requested
+        std::span<uint64_t const> statistics;
+    };
+
+    // Measures scopes of command buffers with timestamp queries, one set of
+    // query pools per frame in flight. Results are read back when the frame
+    // slot is reused, by then the device is done with the frame and reading
+    // doesn't wait.
+    //
+    // Scopes can be recorded concurrently on different command buffers.
+    // Pipeline statistics queries can't be nested within a command buffer,
+    // when statistics are requested scopes of a command buffer can't nest
+    // either. Requesting statistics requires the pipelineStatisticsQuery
+    // device feature.
+    class [[nodiscard]] gpu_profiler_t final
+    {
+    public: // Constants
+        static constexpr uint32_t invalid_scope{
+            std::numeric_limits<uint32_t>::max()};
+
+    public: // Construction
+        gpu_profiler_t(device_t const& device,
+            uint32_t frames_in_flight,
+            uint32_t max_scopes = 256,
+            VkQueryPipelineStatisticFlags statistics = 0);
+
+        gpu_profiler_t(gpu_profiler_t const&) = delete;
+
+        gpu_profiler_t(gpu_profiler_t&&) noexcept = delete;
+
+    public: // Destruction
+        ~gpu_profiler_t();
+
+    public: // Interface
+        // Reads back results of the frame that previously used the next
+        // frame slot and resets its queries. Command buffer has to be
+        // submitted before command buffers with scopes of the frame.
+        void begin_frame(VkCommandBuffer command_buffer);
+
+        // Returns invalid_scope when all scopes of the frame are used
+        [[nodiscard]] uint32_t begin_scope(VkCommandBuffer command_buffer,
+            std::string_view name);
+
+        void end_scope(VkCommandBuffer command_buffer, uint32_t scope);
+
+        // Timings of the last frame with available results, in order in
+        // which scopes were begun
+        [[nodiscard]] std::span<gpu_scope_timing_t const>
+        timings() const noexcept;
+
+    public: // Operators
+        gpu_profiler_t& operator=(gpu_profiler_t const&) = delete;
+
+        gpu_profiler_t& operator=(gpu_profiler_t&&) noexcept = delete;
+
+    private: // Types
+        struct [[nodiscard]] frame_t final
+        {
+            VkQueryPool timestamps{VK_NULL_HANDLE};
+            VkQueryPool statistics{VK_NULL_HANDLE};
+            std::vector<std::string> names;
+            uint32_t used_scopes{};
+        };
+
+    private: // Helpers
+        void resolve(frame_t& frame);
+
+    private: // Data
+        device_t const* device_;
+        uint32_t max_scopes_;
+        VkQueryPipelineStatisticFlags statistic_flags_;
+        uint32_t statistic_count_;
+        double timestamp_period_;
+
+        cppext::cycled_buffer_t<frame_t> frames_;
+        std::atomic<uint32_t> next_scope_;
+        bool recording_{};
+
+        std::vector<uint64_t> timestamp_results_;
+        std::vector<uint64_t> statistic_results_;
+        // Statistics are read here first, timings view statistic results
+        // which are replaced only when all results of the frame are read
+        std::vector<uint64_t> statistic_scratch_;
+        std::vector<std::string> timing_names_;
+        std::vector<gpu_scope_timing_t> timings_;
+    };
+
+    // Scope ends when the guard is destroyed
+    class [[nodiscard]] gpu_profiler_scope_t final
+    {
+    public: // Construction
+        gpu_profiler_scope_t(gpu_profiler_t& profiler,
+            VkCommandBuffer command_buffer,
+            std::string_view name);
+
+        gpu_profiler_scope_t(gpu_profiler_scope_t const&) = delete;
+
+        gpu_profiler_scope_t(gpu_profiler_scope_t&&) noexcept = delete;
+
+    public: // Destruction
+        ~gpu_profiler_scope_t();
+
+    public: // Operators
+        gpu_profiler_scope_t& operator=(gpu_profiler_scope_t const&) = delete;
+
+        gpu_profiler_scope_t& operator=(
+            gpu_profiler_scope_t&&) noexcept = delete;
+
+    private: // Data
+        gpu_profiler_t* profiler_;
+        VkCommandBuffer command_buffer_;
+        uint32_t scope_;
+    };
+} // namespace vkrndr
+
+inline std::span<vkrndr::gpu_scope_timing_t const>
+vkrndr::gpu_profiler_t::timings() const noexcept
+{
+    return timings_;
+}
+
+#endif
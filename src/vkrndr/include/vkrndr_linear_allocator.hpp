@@ -0,0 +1,118 @@
+#ifndef VKRNDR_LINEAR_ALLOCATOR_INCLUDED
+#define VKRNDR_LINEAR_ALLOCATOR_INCLUDED
+
+#include <vkrndr_buffer.hpp>
+#include <vkrndr_memory.hpp>
+
+#include <cppext_cycled_buffer.hpp>
+
+#include <volk.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace vkrndr
+{
+    struct device_t;
+} // namespace vkrndr
+
+namespace vkrndr
+{
+    struct [[nodiscard]] linear_allocation_t final
+    {
+        VkBuffer buffer{VK_NULL_HANDLE};
+        VkDeviceSize offset{};
+        VkDeviceSize size{};
+        // Address of the allocation, zero if the allocator wasn't created
+        // with shader device address usage
+        VkDeviceAddress device_address{};
+        std::byte* mapped{};
+
+        template<typename T>
+        [[nodiscard]] std::span<T> as() const noexcept
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+            return {reinterpret_cast<T*>(mapped), size / sizeof(T)};
+        }
+    };
+
+    // Sub-allocates transient data from persistently mapped host visible
+    // buffers, one set of buffers per frame in flight. Offsets are aligned to
+    // the requested alignment and to the minimum offset alignment of the
+    // buffer usage.
+    //
+    // Allocations are valid until the frame slot is reused. When a frame
+    // doesn't fit into a block, another one is created and the blocks are
+    // merged into a single block the next time the frame slot is used.
+    //
+    // Not thread safe.
+    class [[nodiscard]] linear_allocator_t final
+    {
+    public: // Construction
+        linear_allocator_t(device_t const& device,
+            uint32_t frames_in_flight,
+            VkBufferUsageFlags usage,
+            VkDeviceSize block_size = VkDeviceSize{1} << 20);
+
+        linear_allocator_t(linear_allocator_t const&) = delete;
+
+        linear_allocator_t(linear_allocator_t&&) noexcept = delete;
+
+    public: // Destruction
+        ~linear_allocator_t();
+
+    public: // Interface
+        [[nodiscard]] linear_allocation_t allocate(VkDeviceSize size,
+            VkDeviceSize alignment = 1);
+
+        template<typename T>
+        [[nodiscard]] linear_allocation_t allocate(size_t count);
+
+        // Releases allocations of the frame that previously used the next
+        // frame slot, the device has to be done with that frame
+        void begin_frame();
+
+    public: // Operators
+        linear_allocator_t& operator=(linear_allocator_t const&) = delete;
+
+        linear_allocator_t& operator=(linear_allocator_t&&) noexcept = delete;
+
+    private: // Types
+        struct [[nodiscard]] block_t final
+        {
+            buffer_t buffer;
+            mapped_memory_t map;
+        };
+
+        struct [[nodiscard]] frame_t final
+        {
+            std::vector<block_t> blocks;
+            size_t current_block{};
+            VkDeviceSize offset{};
+        };
+
+    private: // Helpers
+        [[nodiscard]] block_t create_block(VkDeviceSize size) const;
+
+        void destroy_block(block_t& block) const;
+
+    private: // Data
+        device_t const* device_;
+        VkBufferUsageFlags usage_;
+        VkDeviceSize block_size_;
+        VkDeviceSize min_alignment_{1};
+
+        cppext::cycled_buffer_t<frame_t> frames_;
+    };
+} // namespace vkrndr
+
+template<typename T>
+vkrndr::linear_allocation_t vkrndr::linear_allocator_t::allocate(
+    size_t const count)
+{
+    return allocate(sizeof(T) * count, alignof(T));
+}
+
+#endif
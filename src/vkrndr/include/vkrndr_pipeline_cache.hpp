@@ -0,0 +1,28 @@
+#ifndef VKRNDR_PIPELINE_CACHE_INCLUDED
+#define VKRNDR_PIPELINE_CACHE_INCLUDED
+
+#include <expected>
+#include <filesystem>
+#include <system_error>
+
+namespace vkrndr
+{
+    struct device_t;
+} // namespace vkrndr
+
+namespace vkrndr
+{
+    // Merges data stored with save_pipeline_cache into the pipeline cache of
+    // the device. Returns false when the file doesn't exist or was written
+    // for a different device, pipeline cache UUID or driver version.
+    [[nodiscard]] std::expected<bool, std::error_code> load_pipeline_cache(
+        device_t const& device,
+        std::filesystem::path const& file);
+
+    // Previously stored data is replaced only when the whole file is written
+    [[nodiscard]] std::expected<void, std::error_code> save_pipeline_cache(
+        device_t const& device,
+        std::filesystem::path const& file);
+} // namespace vkrndr
+
+#endif
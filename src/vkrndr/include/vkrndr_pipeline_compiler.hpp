@@ -0,0 +1,125 @@
+#ifndef VKRNDR_PIPELINE_COMPILER_INCLUDED
+#define VKRNDR_PIPELINE_COMPILER_INCLUDED
+
+#include <vkrndr_compute_pipeline_builder.hpp>
+#include <vkrndr_graphics_pipeline_builder.hpp>
+#include <vkrndr_pipeline.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace vkrndr
+{
+    struct device_t;
+} // namespace vkrndr
+
+namespace vkrndr
+{
+    // Pipeline compiled in the background. Fallback pipeline is returned
+    // until the compiled one is acquired by poll or wait, it isn't owned and
+    // has to outlive the deferred pipeline.
+    class [[nodiscard]] deferred_pipeline_t final
+    {
+    public: // Construction
+        deferred_pipeline_t() = default;
+
+        deferred_pipeline_t(std::future<pipeline_t> future,
+            pipeline_t const& fallback);
+
+        deferred_pipeline_t(deferred_pipeline_t const&) = delete;
+
+        deferred_pipeline_t(deferred_pipeline_t&&) noexcept = default;
+
+    public: // Destruction
+        ~deferred_pipeline_t() = default;
+
+    public: // Interface
+        // Acquires the compiled pipeline if compilation finished, rethrows
+        // compilation errors
+        [[nodiscard]] bool poll();
+
+        // Blocks until the compiled pipeline is acquired
+        void wait();
+
+        [[nodiscard]] bool ready() const noexcept;
+
+        [[nodiscard]] bool pending() const noexcept;
+
+        // Compiled pipeline when ready, fallback pipeline otherwise
+        [[nodiscard]] pipeline_t const& current() const noexcept;
+
+        [[nodiscard]] pipeline_t const& fallback() const noexcept;
+
+    public: // Operators
+        deferred_pipeline_t& operator=(deferred_pipeline_t const&) = delete;
+
+        deferred_pipeline_t& operator=(
+            deferred_pipeline_t&&) noexcept = default;
+
+    private: // Data
+        std::future<pipeline_t> future_;
+        pipeline_t pipeline_;
+        pipeline_t fallback_;
+    };
+
+    // Waits for compilation and destroys the compiled pipeline
+    void destroy(device_t const& device, deferred_pipeline_t& pipeline);
+
+    // Creates pipelines on worker threads. Builders are copied, shader modules
+    // and pipeline layouts referenced by them have to remain valid until the
+    // pipeline is compiled. Pipelines are created with the device pipeline
+    // cache, which is internally synchronized. Worker threads are started by
+    // the first compile.
+    class [[nodiscard]] pipeline_compiler_t final
+    {
+    public: // Construction
+        explicit pipeline_compiler_t(uint32_t worker_count = 1);
+
+        pipeline_compiler_t(pipeline_compiler_t const&) = delete;
+
+        pipeline_compiler_t(pipeline_compiler_t&&) noexcept = delete;
+
+    public: // Destruction
+        // Compiles already queued pipelines before returning
+        ~pipeline_compiler_t();
+
+    public: // Interface
+        [[nodiscard]] deferred_pipeline_t compile(
+            graphics_pipeline_builder_t const& builder,
+            pipeline_t const& fallback = {});
+
+        [[nodiscard]] deferred_pipeline_t compile(
+            compute_pipeline_builder_t const& builder,
+            pipeline_t const& fallback = {});
+
+    public: // Operators
+        pipeline_compiler_t& operator=(pipeline_compiler_t const&) = delete;
+
+        pipeline_compiler_t& operator=(
+            pipeline_compiler_t&&) noexcept = delete;
+
+    private: // Helpers
+        [[nodiscard]] std::future<pipeline_t> enqueue(
+            std::packaged_task<pipeline_t()> task);
+
+        void work(std::stop_token const& token);
+
+    private: // Data
+        uint32_t worker_count_;
+        std::once_flag started_;
+
+        std::mutex mutex_;
+        std::condition_variable_any condition_;
+        std::deque<std::packaged_task<pipeline_t()>> tasks_;
+
+        std::vector<std::jthread> workers_;
+    };
+} // namespace vkrndr
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef VKRNDR_RENDER_GRAPH_INCLUDED
+#define VKRNDR_RENDER_GRAPH_INCLUDED
+
+#include <vkrndr_image.hpp>
+
+#include <vma_impl.hpp>
+
+#include <volk.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace vkrndr
+{
+    struct device_t;
+} // namespace vkrndr
+
+namespace vkrndr
+{
+    struct [[nodiscard]] image_usage_t final
+    {
+        VkPipelineStageFlags2 stage{VK_PIPELINE_STAGE_2_NONE};
+        VkAccessFlags2 access{VK_ACCESS_2_NONE};
+        VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    };
+
+    [[nodiscard]] constexpr image_usage_t color_attachment_usage()
+    {
+        return {.stage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+            .access = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT |
+                VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+            .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    }
+
+    [[nodiscard]] constexpr image_usage_t depth_attachment_usage()
+    {
+        return {.stage = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT |
+                VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+            .access = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .layout = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL};
+    }
+
+    [[nodiscard]] constexpr image_usage_t sampled_usage(
+        VkPipelineStageFlags2 const stage,
+        VkImageLayout const layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+    {
+        return {.stage = stage,
+            .access = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+            .layout = layout};
+    }
+
+    [[nodiscard]] constexpr image_usage_t storage_usage(
+        VkPipelineStageFlags2 const stage,
+        VkAccessFlags2 const access = VK_ACCESS_2_SHADER_STORAGE_READ_BIT |
+            VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT)
+    {
+        return {.stage = stage,
+            .access = access,
+            .layout = VK_IMAGE_LAYOUT_GENERAL};
+    }
+
+    struct [[nodiscard]] render_graph_image_t final
+    {
+        uint32_t index{};
+    };
+
+    struct [[nodiscard]] transient_image_create_info_t final
+    {
+        VkFormat format{};
+        VkExtent2D extent{};
+        VkImageUsageFlags usage{};
+        VkImageAspectFlags aspect{VK_IMAGE_ASPECT_COLOR_BIT};
+        uint32_t mip_levels{1};
+        VkSampleCountFlagBits samples{VK_SAMPLE_COUNT_1_BIT};
+    };
+
+    class [[nodiscard]] render_graph_pass_t final
+    {
+    public: // Construction
+        explicit render_graph_pass_t(std::string_view name);
+
+        render_graph_pass_t(render_graph_pass_t const&) = delete;
+
+        render_graph_pass_t(render_graph_pass_t&&) noexcept = default;
+
+    public: // Destruction
+        ~render_graph_pass_t() = default;
+
+    public: // Interface
+        // Each image is declared once per pass, with combined usage when it
+        // is both read and written
+        render_graph_pass_t& read(render_graph_image_t image,
+            image_usage_t const& usage);
+
+        render_graph_pass_t& write(render_graph_image_t image,
+            image_usage_t const& usage);
+
+        // Pass isn't culled even if nothing reads its results
+        render_graph_pass_t& with_side_effects();
+
+        render_graph_pass_t& execute(
+            std::function<void(VkCommandBuffer)> callback);
+
+        [[nodiscard]] bool culled() const noexcept;
+
+    public: // Operators
+        render_graph_pass_t& operator=(render_graph_pass_t const&) = delete;
+
+        render_graph_pass_t& operator=(
+            render_graph_pass_t&&) noexcept = default;
+
+    private: // Types
+        struct [[nodiscard]] access_t final
+        {
+            render_graph_image_t image;
+            image_usage_t usage;
+            bool write{};
+        };
+
+    private: // Data
+        std::string name_;
+        std::vector<access_t> accesses_;
+        std::function<void(VkCommandBuffer)> callback_;
+        bool side_effects_{};
+        bool culled_{};
+
+        friend class render_graph_t;
+    };
+
+    // Passes are recorded in the order in which they were added. Barriers
+    // are derived from image usages declared by the passes and issued in a
+    // single batch before each pass.
+    //
+    // Compilation culls passes whose results aren't used by passes with
+    // side effects or by imported images and allocates transient images.
+    // Transient images with disjoint lifetimes share memory, their contents
+    // don't persist between executions.
+    //
+    // Not thread safe.
+    class [[nodiscard]] render_graph_t final
+    {
+    public: // Construction
+        explicit render_graph_t(device_t const& device);
+
+        render_graph_t(render_graph_t const&) = delete;
+
+        render_graph_t(render_graph_t&&) noexcept = delete;
+
+    public: // Destruction
+        ~render_graph_t();
+
+    public: // Interface
+        // Image is in initial usage at the beginning of each execution and
+        // is transitioned to final usage at the end, if given. Accesses of
+        // the initial usage are made available before the first pass.
+        [[nodiscard]] render_graph_image_t import_image(image_t const& image,
+            image_usage_t const& initial,
+            std::optional<image_usage_t> const& final = std::nullopt,
+            VkImageAspectFlags aspect = VK_IMAGE_ASPECT_COLOR_BIT);
+
+        // Replaces an imported image between executions
+        void update_image(render_graph_image_t handle, image_t const& image);
+
+        [[nodiscard]] render_graph_image_t create_image(
+            transient_image_create_info_t const& create_info);
+
+        render_graph_pass_t& add_pass(std::string_view name);
+
+        void compile();
+
+        void execute(VkCommandBuffer command_buffer);
+
+        // Transient images are valid after compilation
+        [[nodiscard]] image_t const& image(render_graph_image_t handle) const;
+
+        [[nodiscard]] VkDeviceSize transient_memory_size() const noexcept;
+
+    public: // Operators
+        render_graph_t& operator=(render_graph_t const&) = delete;
+
+        render_graph_t& operator=(render_graph_t&&) noexcept = delete;
+
+    private: // Types
+        struct [[nodiscard]] image_state_t final
+        {
+            image_usage_t usage;
+            bool written{};
+        };
+
+        struct [[nodiscard]] image_record_t final
+        {
+            image_t image;
+            VkImageAspectFlags aspect{};
+            bool imported{};
+
+            image_usage_t initial;
+            std::optional<image_usage_t> final;
+
+            transient_image_create_info_t create_info;
+            std::optional<size_t> first_pass;
+            size_t last_pass{};
+            std::optional<size_t> memory_block;
+            // Transient image took over its memory block in the current
+            // execution
+            bool resident{};
+
+            image_state_t state;
+        };
+
+        struct [[nodiscard]] memory_block_t final
+        {
+            VkMemoryRequirements requirements{};
+            size_t last_pass{};
+            VmaAllocation allocation{VK_NULL_HANDLE};
+            // Stages of the last access to any image placed in the block and
+            // its accesses if it wrote to the image
+            VkPipelineStageFlags2 last_stage{VK_PIPELINE_STAGE_2_NONE};
+            VkAccessFlags2 last_write_access{VK_ACCESS_2_NONE};
+        };
+
+    private: // Helpers
+        void cull();
+
+        void allocate_transient_images();
+
+        void transition(image_record_t& record,
+            image_usage_t const& usage,
+            bool write);
+
+    private: // Data
+        device_t const* device_;
+
+        std::vector<image_record_t> images_;
+        std::deque<render_graph_pass_t> passes_;
+        std::vector<memory_block_t> memory_blocks_;
+
+        std::vector<VkImageMemoryBarrier2> barriers_;
+
+        bool compiled_{};
+    };
+} // namespace vkrndr
+
+#endif
@@ -112,10 +112,13 @@ namespace vkrndr
         [[nodiscard]] std::optional<vkrndr::image_t>
         acquire_next_image(size_t current_frame, uint64_t timeout = 0);
 
+        // Timeline semaphore is signaled with the given value once the
+        // command buffers complete
         void submit_command_buffers(
             std::span<VkCommandBuffer const> command_buffers,
             size_t current_frame,
-            VkFence submit_fence);
+            VkSemaphore timeline,
+            uint64_t timeline_value);
 
         [[nodiscard]] bool change_present_mode(VkPresentModeKHR new_mode);
 
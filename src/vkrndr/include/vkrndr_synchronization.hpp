@@ -73,6 +73,9 @@ namespace vkrndr
 
     [[nodiscard]] VkSemaphore create_semaphore(device_t const& device);
 
+    [[nodiscard]] VkSemaphore create_timeline_semaphore(device_t const& device,
+        uint64_t initial_value = 0);
+
     [[nodiscard]] VkFence create_fence(device_t const& device,
         bool set_signaled);
 
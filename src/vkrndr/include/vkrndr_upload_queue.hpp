@@ -0,0 +1,154 @@
+#ifndef VKRNDR_UPLOAD_QUEUE_INCLUDED
+#define VKRNDR_UPLOAD_QUEUE_INCLUDED
+
+#include <vkrndr_buffer.hpp>
+#include <vkrndr_image.hpp>
+
+#include <volk.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace vkrndr
+{
+    struct device_t;
+    class execution_port_t;
+} // namespace vkrndr
+
+namespace vkrndr
+{
+    // Completion handle of an upload, uploads are completed in the order in
+    // which they were recorded
+    struct [[nodiscard]] upload_ticket_t final
+    {
+        uint64_t value{};
+    };
+
+    // Records copies into device local resources and submits them in batches
+    // to the transfer port without waiting for them. Completion is tracked
+    // with a timeline semaphore.
+    //
+    // When the transfer port belongs to a different queue family, ownership
+    // of uploaded resources is released on the transfer port and acquired on
+    // the graphics port once the copies of a batch are complete. Mipmaps are
+    // generated on the graphics port. Copies are tracked with a separate
+    // timeline semaphore, tickets are ready only after the graphics port
+    // part of their batch completed. Targets must not be in use by the
+    // device while they are uploaded to.
+    //
+    // Not thread safe.
+    class [[nodiscard]] upload_queue_t final
+    {
+    public: // Construction
+        upload_queue_t(device_t const& device,
+            execution_port_t& graphics_port,
+            execution_port_t& transfer_port);
+
+        upload_queue_t(upload_queue_t const&) = delete;
+
+        upload_queue_t(upload_queue_t&&) noexcept = delete;
+
+    public: // Destruction
+        // Waits for submitted uploads
+        ~upload_queue_t();
+
+    public: // Interface
+        // Source buffer has to remain valid until the upload is ready
+        [[nodiscard]] std::expected<upload_ticket_t, std::error_code>
+        upload(buffer_t const& source, buffer_t const& target);
+
+        // Data is copied to staging memory owned by the queue
+        [[nodiscard]] std::expected<upload_ticket_t, std::error_code>
+        upload(std::span<std::byte const> const& data, buffer_t const& target);
+
+        // Image is left in shader read only layout, mip levels of the image
+        // are generated from the base level unless all are defined
+        [[nodiscard]] std::expected<upload_ticket_t, std::error_code> upload(
+            std::span<std::byte const> const& data,
+            image_t const& target,
+            std::span<image_mip_level_t const> const& defined_mips = {});
+
+        // Submits recorded uploads as a single batch
+        [[nodiscard]] std::expected<void, std::error_code> submit();
+
+        // Acquires ownership of resources from batches with completed copies
+        // and releases staging memory of ready batches
+        [[nodiscard]] std::expected<void, std::error_code> poll();
+
+        [[nodiscard]] bool ready(upload_ticket_t ticket) const;
+
+        // Submits the batch of the upload if it wasn't submitted yet and
+        // blocks until the upload is ready
+        [[nodiscard]] std::expected<void, std::error_code> wait(
+            upload_ticket_t ticket);
+
+    public: // Operators
+        upload_queue_t& operator=(upload_queue_t const&) = delete;
+
+        upload_queue_t& operator=(upload_queue_t&&) noexcept = delete;
+
+    private: // Types
+        struct [[nodiscard]] batch_t final
+        {
+            // Value of the transfer semaphore signaled when copies are
+            // complete, used only with a dedicated transfer port
+            uint64_t transfer_value{};
+            // Value signaled when uploads are ready for the graphics port
+            uint64_t value{};
+
+            VkCommandPool transfer_pool{VK_NULL_HANDLE};
+            VkCommandBuffer transfer_commands{VK_NULL_HANDLE};
+
+            VkCommandPool graphics_pool{VK_NULL_HANDLE};
+            VkCommandBuffer graphics_commands{VK_NULL_HANDLE};
+
+            std::vector<buffer_t> staging_buffers;
+
+            std::vector<VkBufferMemoryBarrier2> buffer_acquires;
+            std::vector<VkImageMemoryBarrier2> image_acquires;
+            std::vector<image_t> mipmapped_images;
+
+            bool graphics_pending{};
+        };
+
+    private: // Helpers
+        [[nodiscard]] bool dedicated() const noexcept;
+
+        [[nodiscard]] std::expected<batch_t*, std::error_code> recording();
+
+        [[nodiscard]] buffer_t stage(batch_t& batch,
+            std::span<std::byte const> const& data);
+
+        [[nodiscard]] std::expected<void, std::error_code> submit_graphics(
+            batch_t& batch);
+
+        [[nodiscard]] std::expected<void, std::error_code> release(
+            batch_t batch);
+
+    private: // Data
+        device_t const* device_;
+        execution_port_t* graphics_port_;
+        execution_port_t* transfer_port_;
+
+        VkSemaphore semaphore_;
+        uint64_t last_value_{};
+
+        // Batches become ready on the graphics port in submission order,
+        // but their copies may complete before earlier acquires are
+        // submitted. Copies signal their own semaphore so that values of
+        // each semaphore are signaled in increasing order.
+        VkSemaphore transfer_semaphore_;
+        uint64_t last_transfer_value_{};
+
+        std::optional<batch_t> recording_;
+        std::vector<batch_t> in_flight_;
+        std::vector<batch_t> free_;
+    };
+} // namespace vkrndr
+
+#endif
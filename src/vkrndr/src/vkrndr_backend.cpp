@@ -2,13 +2,17 @@
 
 #include <vkrndr_buffer.hpp>
 #include <vkrndr_commands.hpp>
+#include <vkrndr_descriptor_heap.hpp>
 #include <vkrndr_descriptors.hpp>
 #include <vkrndr_device.hpp>
 #include <vkrndr_execution_port.hpp>
 #include <vkrndr_image.hpp>
+#include <vkrndr_linear_allocator.hpp>
 #include <vkrndr_memory.hpp>
+#include <vkrndr_pipeline_compiler.hpp>
 #include <vkrndr_rendering_context.hpp>
 #include <vkrndr_synchronization.hpp>
+#include <vkrndr_upload_queue.hpp>
 #include <vkrndr_utility.hpp>
 
 #include <cppext_container.hpp>
@@ -29,6 +33,7 @@
 #include <span>
 #include <stdexcept>
 #include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -63,6 +68,14 @@ namespace
 
         return std::move(pool).value();
     }
+
+    void begin_command_buffer(VkCommandBuffer const command_buffer)
+    {
+        VkCommandBufferBeginInfo begin_info{};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkrndr::check_result(vkBeginCommandBuffer(command_buffer, &begin_info));
+    }
 } // namespace
 
 vkrndr::backend_t::backend_t(rendering_context_t rendering_context,
@@ -78,6 +91,19 @@ vkrndr::backend_t::backend_t(rendering_context_t rendering_context,
         throw std::runtime_error{"no suitable execution port found"};
     }
 
+    // Ports of queue families without graphics and compute capabilities are
+    // usually backed by dedicated copy engines
+    auto upload_port{std::ranges::find_if(context_.device->execution_ports,
+        [](std::unique_ptr<execution_port_t> const& port)
+        {
+            return port->has_transfer() && !port->has_graphics() &&
+                !port->has_compute();
+        })};
+    if (upload_port == std::cend(context_.device->execution_ports))
+    {
+        upload_port = execution_port;
+    }
+
     frame_data_ = cppext::cycled_buffer_t<frame_data_t>{frames_in_flight,
         frames_in_flight};
     descriptor_pool_ = ::create_descriptor_pool(*context_.device);
@@ -103,10 +129,35 @@ vkrndr::backend_t::backend_t(rendering_context_t rendering_context,
         fd.frame_fences_ =
             std::make_unique<vkrndr::fence_pool_t>(*context_.device);
     };
+
+    upload_queue_ = std::make_unique<upload_queue_t>(*context_.device,
+        **execution_port,
+        **upload_port);
+
+    // Leave a core for the render loop, threads are started only when a
+    // pipeline is compiled in the background
+    pipeline_compiler_ = std::make_unique<pipeline_compiler_t>(
+        std::max(std::thread::hardware_concurrency(), 2U) - 1);
+
+    descriptor_heap_ =
+        std::make_unique<descriptor_heap_t>(*context_.device, frames_in_flight);
+
+    frame_allocator_ = std::make_unique<linear_allocator_t>(*context_.device,
+        frames_in_flight,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+            VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
 }
 
 vkrndr::backend_t::~backend_t()
 {
+    frame_allocator_.reset();
+    descriptor_heap_.reset();
+    pipeline_compiler_.reset();
+    upload_queue_.reset();
+
     for (frame_data_t const& fd : cppext::as_span(frame_data_))
     {
         destroy_command_pool(*context_.device, fd.present_command_pool);
@@ -114,6 +165,11 @@ vkrndr::backend_t::~backend_t()
             fd.present_transient_command_pool);
         destroy_command_pool(*context_.device,
             fd.transfer_transient_command_pool);
+
+        for (recording_pool_t const& recording_pool : fd.recording_pools)
+        {
+            destroy_command_pool(*context_.device, recording_pool.pool);
+        }
     };
 
     destroy_descriptor_pool(*context_.device, descriptor_pool_);
@@ -134,8 +190,45 @@ uint32_t vkrndr::backend_t::frames_in_flight() const
     return cppext::narrow<uint32_t>(frame_data_.size());
 }
 
+vkrndr::upload_queue_t& vkrndr::backend_t::upload_queue()
+{
+    return *upload_queue_;
+}
+
+vkrndr::pipeline_compiler_t& vkrndr::backend_t::pipeline_compiler()
+{
+    return *pipeline_compiler_;
+}
+
+vkrndr::descriptor_heap_t& vkrndr::backend_t::descriptor_heap()
+{
+    return *descriptor_heap_;
+}
+
+vkrndr::linear_allocator_t& vkrndr::backend_t::frame_allocator()
+{
+    return *frame_allocator_;
+}
+
 void vkrndr::backend_t::begin_frame()
 {
+    descriptor_heap_->begin_frame();
+    frame_allocator_->begin_frame();
+
+    if (std::expected<void, std::error_code> const result{
+            upload_queue_->submit()};
+        !result)
+    {
+        throw std::system_error{result.error()};
+    }
+
+    if (std::expected<void, std::error_code> const result{
+            upload_queue_->poll()};
+        !result)
+    {
+        throw std::system_error{result.error()};
+    }
+
     if (std::expected<void, std::error_code> const result{
             reset_command_pool(*context_.device,
                 frame_data_->present_command_pool)};
@@ -151,12 +244,25 @@ void vkrndr::backend_t::begin_frame()
     {
         throw std::system_error{result.error()};
     }
+
+    for (recording_pool_t const& recording_pool :
+        std::span{frame_data_->recording_pools}.first(
+            frame_data_->used_recording_pools))
+    {
+        if (std::expected<void, std::error_code> const result{
+                reset_command_pool(*context_.device, recording_pool.pool)};
+            !result)
+        {
+            throw std::system_error{result.error()};
+        }
+    }
+    frame_data_->used_recording_pools = 0;
 }
 
 std::span<VkCommandBuffer const> vkrndr::backend_t::present_buffers()
 {
-    std::span const rv{frame_data_->present_command_buffers.data(),
-        frame_data_->used_present_command_buffers};
+    std::span<VkCommandBuffer const> const rv{
+        frame_data_->recorded_command_buffers};
 
     for (VkCommandBuffer const buffer : rv)
     {
@@ -168,8 +274,12 @@ std::span<VkCommandBuffer const> vkrndr::backend_t::present_buffers()
 
 void vkrndr::backend_t::end_frame()
 {
-    frame_data_.cycle([](frame_data_t& fd, frame_data_t const&)
-        { fd.used_present_command_buffers = 0; });
+    frame_data_.cycle(
+        [](frame_data_t& fd, frame_data_t const&)
+        {
+            fd.used_present_command_buffers = 0;
+            fd.recorded_command_buffers.clear();
+        });
 }
 
 VkCommandBuffer vkrndr::backend_t::request_command_buffer()
@@ -195,13 +305,56 @@ VkCommandBuffer vkrndr::backend_t::request_command_buffer()
     VkCommandBuffer rv{frame_data_->present_command_buffers[frame_data_
             ->used_present_command_buffers++]};
 
-    VkCommandBufferBeginInfo begin_info{};
-    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    check_result(vkBeginCommandBuffer(rv, &begin_info));
+    begin_command_buffer(rv);
+    frame_data_->recorded_command_buffers.push_back(rv);
     return rv;
 }
 
+std::span<VkCommandBuffer const>
+vkrndr::backend_t::request_parallel_command_buffers(uint32_t const count)
+{
+    std::vector<recording_pool_t>& pools{frame_data_->recording_pools};
+    while (pools.size() < frame_data_->used_recording_pools + count)
+    {
+        std::expected<VkCommandPool, std::error_code> const pool{
+            create_command_pool(*context_.device,
+                frame_data_->present_queue->queue_family(),
+                VK_COMMAND_POOL_CREATE_TRANSIENT_BIT)};
+        if (!pool)
+        {
+            throw std::system_error{pool.error()};
+        }
+
+        recording_pool_t recording_pool{.pool = *pool};
+        if (std::expected<void, std::error_code> const result{
+                allocate_command_buffers(*context_.device,
+                    recording_pool.pool,
+                    true,
+                    cppext::as_span(recording_pool.buffer))};
+            !result)
+        {
+            destroy_command_pool(*context_.device, recording_pool.pool);
+            throw std::system_error{result.error()};
+        }
+
+        pools.push_back(recording_pool);
+    }
+
+    std::vector<VkCommandBuffer>& recorded{
+        frame_data_->recorded_command_buffers};
+    size_t const first{recorded.size()};
+
+    for (recording_pool_t const& recording_pool :
+        std::span{pools}.subspan(frame_data_->used_recording_pools, count))
+    {
+        begin_command_buffer(recording_pool.buffer);
+        recorded.push_back(recording_pool.buffer);
+    }
+    frame_data_->used_recording_pools += count;
+
+    return std::span{recorded}.subspan(first, count);
+}
+
 vkrndr::image_t vkrndr::backend_t::transfer_image(
     std::span<std::byte const> const& image_data,
     VkExtent2D const extent,
@@ -24,7 +24,7 @@ vkrndr::pipeline_t vkrndr::compute_pipeline_builder_t::build()
 
     pipeline_t rv{*layout_, VK_NULL_HANDLE, VK_PIPELINE_BIND_POINT_COMPUTE};
     check_result(vkCreateComputePipelines(*device_,
-        nullptr,
+        device_->pipeline_cache,
         1,
         &create_info,
         nullptr,
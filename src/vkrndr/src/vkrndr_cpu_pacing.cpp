@@ -3,81 +3,57 @@
 #include <vkrndr_debug_utils.hpp>
 #include <vkrndr_device.hpp>
 #include <vkrndr_error_code.hpp>
+#include <vkrndr_synchronization.hpp>
 #include <vkrndr_utility.hpp>
 
-#include <fmt/format.h>
-
 #include <vulkan/utility/vk_struct_helper.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <system_error>
-#include <utility> // IWYU pragma: keep
+#include <utility>
 
-// IWYU pragma: no_include <boost/move/detail/reverse_iterator.hpp>
 // IWYU pragma: no_include <set>
 // IWYU pragma: no_include <string>
-// IWYU pragma: no_include <variant>
 
 vkrndr::cpu_pacing_t::cpu_pacing_t(device_t const& device,
     uint32_t const frames_in_flight)
     : device_{&device}
     , frames_{frames_in_flight}
     , frames_in_flight_{frames_in_flight}
+    , timeline_{create_timeline_semaphore(device)}
 {
-    VkFenceCreateInfo const signaled_fence_create{
-        .sType = vku::GetSType<VkFenceCreateInfo>(),
-        .flags = VK_FENCE_CREATE_SIGNALED_BIT,
-    };
-
     uint32_t index{};
     for (frame_in_flight_t& frame : frames_)
     {
         frame.index = index++;
-
-        if (VkResult const result{vkCreateFence(*device_,
-                &signaled_fence_create,
-                nullptr,
-                &frame.submit_fence)};
-            !is_success_result(result))
-        {
-            throw std::system_error{make_error_code(result)};
-        }
-
-        VKRNDR_IF_DEBUG_UTILS(object_name(*device_,
-            VK_OBJECT_TYPE_FENCE,
-            handle_cast(frame.submit_fence),
-            fmt::format("CPU pacing fence {}", frame.index)));
     }
+
+    VKRNDR_IF_DEBUG_UTILS(object_name(*device_,
+        VK_OBJECT_TYPE_SEMAPHORE,
+        handle_cast(timeline_),
+        "CPU pacing timeline"));
 }
 
 // NOLINTNEXTLINE(bugprone-exception-escape)
 vkrndr::cpu_pacing_t::~cpu_pacing_t()
 {
-    for (frame_in_flight_t const& frame : frames_)
-    {
-        vkDestroyFence(*device_, frame.submit_fence, nullptr);
-
-        for (auto it{frame.cleanup.rbegin()}; it != frame.cleanup.rend(); ++it)
-        {
-            (*it)();
-        }
-
-        for (auto it{frame.old_cleanup_queue.rbegin()};
-            it != frame.old_cleanup_queue.rend();
-            ++it)
-        {
-            (*it)();
-        }
-    }
+    run_deferred(last_value_);
+
+    vkDestroySemaphore(*device_, timeline_, nullptr);
 }
 
 vkrndr::frame_in_flight_t* vkrndr::cpu_pacing_t::pace(uint64_t const timeout)
 {
-    if (VkResult const result{vkWaitForFences(*device_,
-            1,
-            &frames_[current_frame_].submit_fence,
-            VK_TRUE,
-            timeout)};
+    VkSemaphoreWaitInfo const wait_info{
+        .sType = vku::GetSType<VkSemaphoreWaitInfo>(),
+        .semaphoreCount = 1,
+        .pSemaphores = &timeline_,
+        .pValues = &frames_[current_frame_].timeline_value};
+
+    if (VkResult const result{vkWaitSemaphores(*device_, &wait_info, timeout)};
         result == VK_TIMEOUT)
     {
         return nullptr;
@@ -87,32 +63,77 @@ vkrndr::frame_in_flight_t* vkrndr::cpu_pacing_t::pace(uint64_t const timeout)
         throw std::system_error{make_error_code(result)};
     }
 
-    auto& frame{current()};
-    for (auto it{frame.old_cleanup_queue.rbegin()};
-        it != frame.old_cleanup_queue.rend();
-        ++it)
+    uint64_t completed{};
+    check_result(vkGetSemaphoreCounterValue(*device_, timeline_, &completed));
+
+    run_deferred(completed);
+
+    return &current();
+}
+
+void vkrndr::cpu_pacing_t::begin_frame()
+{
+    frames_[current_frame_].timeline_value = ++last_value_;
+}
+
+void vkrndr::cpu_pacing_t::end_frame()
+{
+    current_frame_ = (current_frame_ + 1) % frames_in_flight_;
+}
+
+void vkrndr::cpu_pacing_t::defer(std::function<void()> action)
+{
+    if (deferred_count_ == deferred_.size())
     {
-        (*it)();
+        grow_deferred();
     }
-    frame.old_cleanup_queue.clear();
 
-    using std::swap;
-    swap(frame.old_cleanup_queue, frame.cleanup);
+    ++deferred_count_;
+    deferred_at(deferred_count_ - 1) = {last_value_, std::move(action)};
+}
 
-    return &frame;
+vkrndr::cpu_pacing_t::deferred_action_t& vkrndr::cpu_pacing_t::deferred_at(
+    size_t const offset)
+{
+    return deferred_[(deferred_head_ + offset) % deferred_.size()];
 }
 
-void vkrndr::cpu_pacing_t::begin_frame()
+void vkrndr::cpu_pacing_t::grow_deferred()
 {
-    if (VkResult const result{
-            vkResetFences(*device_, 1, &frames_[current_frame_].submit_fence)};
-        result != VK_SUCCESS)
+    std::vector<deferred_action_t> grown(
+        std::max(deferred_.size() * 2, size_t{frames_in_flight_} * 4));
+    for (size_t i{}; i != deferred_count_; ++i)
     {
-        throw std::system_error{make_error_code(result)};
+        grown[i] = std::move(deferred_at(i));
     }
+
+    deferred_ = std::move(grown);
+    deferred_head_ = 0;
 }
 
-void vkrndr::cpu_pacing_t::end_frame()
+void vkrndr::cpu_pacing_t::run_deferred(uint64_t const completed_value)
 {
-    current_frame_ = (current_frame_ + 1) % frames_in_flight_;
+    size_t completed{};
+    while (completed != deferred_count_ &&
+        deferred_at(completed).value <= completed_value)
+    {
+        ++completed;
+    }
+
+    // Actions run in reverse order of deferral
+    for (size_t i{completed}; i != 0; --i)
+    {
+        deferred_at(i - 1).action();
+    }
+
+    for (size_t i{}; i != completed; ++i)
+    {
+        deferred_at(i).action = nullptr;
+    }
+
+    if (completed != 0)
+    {
+        deferred_head_ = (deferred_head_ + completed) % deferred_.size();
+        deferred_count_ -= completed;
+    }
 }
@@ -0,0 +1,265 @@
+#include <vkrndr_descriptor_heap.hpp>
+
+#include <vkrndr_buffer.hpp>
+#include <vkrndr_descriptors.hpp>
+#include <vkrndr_device.hpp>
+#include <vkrndr_error_code.hpp>
+#include <vkrndr_utility.hpp>
+
+#include <cppext_container.hpp>
+
+#include <vulkan/utility/vk_struct_helper.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+vkrndr::descriptor_heap_t::descriptor_heap_t(device_t const& device,
+    uint32_t const frames_in_flight,
+    descriptor_heap_capacity_t const& capacity)
+    : device_{&device}
+    , frames_in_flight_{frames_in_flight}
+    , sampled_images_{.capacity = capacity.sampled_images}
+    , samplers_{.capacity = capacity.samplers}
+    , storage_buffers_{.capacity = capacity.storage_buffers}
+{
+    std::array const bindings{
+        VkDescriptorSetLayoutBinding{.binding = sampled_image_binding,
+            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            .descriptorCount = capacity.sampled_images,
+            .stageFlags = VK_SHADER_STAGE_ALL},
+        VkDescriptorSetLayoutBinding{.binding = sampler_binding,
+            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+            .descriptorCount = capacity.samplers,
+            .stageFlags = VK_SHADER_STAGE_ALL},
+        VkDescriptorSetLayoutBinding{.binding = storage_buffer_binding,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = capacity.storage_buffers,
+            .stageFlags = VK_SHADER_STAGE_ALL}};
+
+    VkDescriptorBindingFlags const flags{
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+        VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT};
+
+    // Only the last binding of a set may have a variable count
+    std::array const binding_flags{flags,
+        flags,
+        flags | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT};
+
+    layout_ =
+        create_descriptor_set_layout(device, bindings, binding_flags).value();
+
+    std::array const pool_sizes{
+        VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+            .descriptorCount = capacity.sampled_images},
+        VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_SAMPLER,
+            .descriptorCount = capacity.samplers},
+        VkDescriptorPoolSize{.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = capacity.storage_buffers}};
+
+    pool_ = create_descriptor_pool(device,
+        pool_sizes,
+        1,
+        VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT)
+                .value();
+
+    check_result(allocate_descriptor_sets(device,
+        pool_,
+        cppext::as_span(layout_),
+        cppext::as_span(capacity.storage_buffers),
+        cppext::as_span(set_)));
+}
+
+vkrndr::descriptor_heap_t::~descriptor_heap_t()
+{
+    destroy_descriptor_pool(*device_, pool_);
+    vkDestroyDescriptorSetLayout(*device_, layout_, nullptr);
+}
+
+VkDescriptorSetLayout
+vkrndr::descriptor_heap_t::descriptor_layout() const noexcept
+{
+    return layout_;
+}
+
+VkDescriptorSet vkrndr::descriptor_heap_t::descriptor_set() const noexcept
+{
+    return set_;
+}
+
+std::expected<uint32_t, std::error_code>
+vkrndr::descriptor_heap_t::add_sampled_image(VkImageView const view,
+    VkImageLayout const layout)
+{
+    return allocate(sampled_images_).transform(
+        [&](uint32_t const slot)
+        {
+            update_sampled_image(slot, view, layout);
+            return slot;
+        });
+}
+
+std::expected<uint32_t, std::error_code>
+vkrndr::descriptor_heap_t::add_sampler(VkSampler const sampler)
+{
+    return allocate(samplers_).transform(
+        [&](uint32_t const slot)
+        {
+            VkDescriptorImageInfo const info{sampler_descriptor(sampler)};
+            write(sampler_binding,
+                VK_DESCRIPTOR_TYPE_SAMPLER,
+                slot,
+                &info,
+                nullptr);
+            return slot;
+        });
+}
+
+std::expected<uint32_t, std::error_code>
+vkrndr::descriptor_heap_t::add_storage_buffer(buffer_t const& buffer,
+    VkDeviceSize const offset,
+    VkDeviceSize const range)
+{
+    return allocate(storage_buffers_).transform(
+        [&](uint32_t const slot)
+        {
+            update_storage_buffer(slot, buffer, offset, range);
+            return slot;
+        });
+}
+
+void vkrndr::descriptor_heap_t::update_sampled_image(uint32_t const slot,
+    VkImageView const view,
+    VkImageLayout const layout)
+{
+    assert(slot < sampled_images_.next);
+
+    VkDescriptorImageInfo const info{.imageView = view, .imageLayout = layout};
+    write(sampled_image_binding,
+        VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+        slot,
+        &info,
+        nullptr);
+}
+
+void vkrndr::descriptor_heap_t::update_storage_buffer(uint32_t const slot,
+    buffer_t const& buffer,
+    VkDeviceSize const offset,
+    VkDeviceSize const range)
+{
+    assert(slot < storage_buffers_.next);
+
+    VkDescriptorBufferInfo const info{
+        buffer_descriptor(buffer, offset, range)};
+    write(storage_buffer_binding,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        slot,
+        nullptr,
+        &info);
+}
+
+void vkrndr::descriptor_heap_t::release_sampled_image(uint32_t const slot)
+{
+    release(sampled_images_, slot);
+}
+
+void vkrndr::descriptor_heap_t::release_sampler(uint32_t const slot)
+{
+    release(samplers_, slot);
+}
+
+void vkrndr::descriptor_heap_t::release_storage_buffer(uint32_t const slot)
+{
+    release(storage_buffers_, slot);
+}
+
+void vkrndr::descriptor_heap_t::begin_frame()
+{
+    ++frame_;
+
+    recycle(sampled_images_);
+    recycle(samplers_);
+    recycle(storage_buffers_);
+}
+
+void vkrndr::descriptor_heap_t::bind_on(VkCommandBuffer command_buffer,
+    VkPipelineLayout layout,
+    VkPipelineBindPoint const bind_point,
+    uint32_t const set) const
+{
+    vkCmdBindDescriptorSets(command_buffer,
+        bind_point,
+        layout,
+        set,
+        1,
+        &set_,
+        0,
+        nullptr);
+}
+
+std::expected<uint32_t, std::error_code>
+vkrndr::descriptor_heap_t::allocate(slots_t& slots)
+{
+    if (!slots.free.empty())
+    {
+        uint32_t const rv{slots.free.back()};
+        slots.free.pop_back();
+        return rv;
+    }
+
+    if (slots.next == slots.capacity)
+    {
+        return std::unexpected{make_error_code(VK_ERROR_OUT_OF_POOL_MEMORY)};
+    }
+
+    return slots.next++;
+}
+
+void vkrndr::descriptor_heap_t::release(slots_t& slots, uint32_t const slot)
+{
+    assert(slot < slots.next);
+
+    slots.retired.emplace_back(frame_, slot);
+}
+
+void vkrndr::descriptor_heap_t::recycle(slots_t& slots) const
+{
+    // Retired slots are ordered by the frame in which they were released
+    auto it{slots.retired.begin()};
+    for (; it != slots.retired.end(); ++it)
+    {
+        if (frame_ - it->frame < frames_in_flight_)
+        {
+            break;
+        }
+
+        slots.free.push_back(it->slot);
+    }
+    slots.retired.erase(slots.retired.begin(), it);
+}
+
+void vkrndr::descriptor_heap_t::write(uint32_t const binding,
+    VkDescriptorType const type,
+    uint32_t const slot,
+    VkDescriptorImageInfo const* const image_info,
+    VkDescriptorBufferInfo const* const buffer_info) const
+{
+    VkWriteDescriptorSet const write{
+        .sType = vku::GetSType<VkWriteDescriptorSet>(),
+        .dstSet = set_,
+        .dstBinding = binding,
+        .dstArrayElement = slot,
+        .descriptorCount = 1,
+        .descriptorType = type,
+        .pImageInfo = image_info,
+        .pBufferInfo = buffer_info,
+    };
+
+    vkUpdateDescriptorSets(*device_, 1, &write, 0, nullptr);
+}
@@ -158,6 +158,17 @@ namespace
             return std::unexpected{vkrndr::make_error_code(result)};
         }
 
+        VkPipelineCacheCreateInfo const pipeline_cache_info{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+        if (VkResult const result{vkCreatePipelineCache(rv->logical_device,
+                &pipeline_cache_info,
+                nullptr,
+                &rv->pipeline_cache)};
+            result != VK_SUCCESS)
+        {
+            return std::unexpected{vkrndr::make_error_code(result)};
+        }
+
         rv->execution_ports.reserve(queue_create_infos.size());
         for (auto const& family : create_info.queues)
         {
@@ -274,6 +285,7 @@ vkrndr::device_t::~device_t()
 {
     if (vkDestroyDevice)
     {
+        vkDestroyPipelineCache(logical_device, pipeline_cache, nullptr);
         vmaDestroyAllocator(allocator);
         vkDestroyDevice(logical_device, nullptr);
     }
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <iterator>
+#include <optional>
 #include <ranges>
 #include <span>
 #include <string_view>
@@ -206,6 +207,8 @@ void vkrndr::add_required_feature_flags(feature_flags_t& flags,
                 &VkPhysicalDeviceVulkan12Features::runtimeDescriptorArray,
                 &VkPhysicalDeviceVulkan12Features::scalarBlockLayout,
                 &VkPhysicalDeviceVulkan12Features::bufferDeviceAddress,
+                &VkPhysicalDeviceVulkan12Features::timelineSemaphore,
+                &VkPhysicalDeviceVulkan12Features::drawIndirectCount,
                 // clang-format on
             });
     }
@@ -404,6 +407,25 @@ vkrndr::query_available_physical_devices(VkInstance instance,
     return rv;
 }
 
+std::optional<vkrndr::queue_family_t>
+vkrndr::find_dedicated_transfer_family(physical_device_features_t const& device)
+{
+    auto const it{std::ranges::find_if(device.queue_families,
+        [](queue_family_t const& family)
+        {
+            VkQueueFlags const flags{family.properties.queueFlags};
+            return supports_flags(flags, VK_QUEUE_TRANSFER_BIT) &&
+                !supports_flags(flags, VK_QUEUE_GRAPHICS_BIT) &&
+                !supports_flags(flags, VK_QUEUE_COMPUTE_BIT);
+        })};
+    if (it == std::cend(device.queue_families))
+    {
+        return std::nullopt;
+    }
+
+    return *it;
+}
+
 bool vkrndr::enable_extension_for_device(char const* const extension_name,
     physical_device_features_t const& device,
     vkrndr::feature_chain_t& chain)
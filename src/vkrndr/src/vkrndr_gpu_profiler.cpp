@@ -0,0 +1,218 @@
+#include <vkrndr_gpu_profiler.hpp>
+
+#include <vkrndr_device.hpp>
+#include <vkrndr_utility.hpp>
+
+#include <cppext_cycled_buffer.hpp>
+
+#include <vulkan/utility/vk_struct_helper.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace
+{
+    [[nodiscard]] VkQueryPool create_query_pool(
+        vkrndr::device_t const& device,
+        VkQueryType const type,
+        uint32_t const count,
+        VkQueryPipelineStatisticFlags const statistics = 0)
+    {
+        VkQueryPoolCreateInfo const create_info{
+            .sType = vku::GetSType<VkQueryPoolCreateInfo>(),
+            .queryType = type,
+            .queryCount = count,
+            .pipelineStatistics = statistics};
+
+        VkQueryPool rv; // NOLINT
+        vkrndr::check_result(
+            vkCreateQueryPool(device, &create_info, nullptr, &rv));
+
+        return rv;
+    }
+} // namespace
+
+vkrndr::gpu_profiler_t::gpu_profiler_t(device_t const& device,
+    uint32_t const frames_in_flight,
+    uint32_t const max_scopes,
+    VkQueryPipelineStatisticFlags const statistics)
+    : device_{&device}
+    , max_scopes_{max_scopes}
+    , statistic_flags_{statistics}
+    , statistic_count_{
+          static_cast<uint32_t>(std::popcount(statistic_flags_))}
+    , frames_{frames_in_flight, frames_in_flight}
+    , next_scope_{max_scopes}
+{
+    VkPhysicalDeviceProperties properties; // NOLINT
+    vkGetPhysicalDeviceProperties(device, &properties);
+    timestamp_period_ = properties.limits.timestampPeriod;
+
+    for (frame_t& frame : cppext::as_span(frames_))
+    {
+        frame.timestamps = create_query_pool(device,
+            VK_QUERY_TYPE_TIMESTAMP,
+            2 * max_scopes_);
+        if (statistic_flags_)
+        {
+            frame.statistics = create_query_pool(device,
+                VK_QUERY_TYPE_PIPELINE_STATISTICS,
+                max_scopes_,
+                statistic_flags_);
+        }
+        frame.names.resize(max_scopes_);
+    }
+
+    timestamp_results_.resize(size_t{2} * max_scopes_);
+    statistic_results_.resize(size_t{statistic_count_} * max_scopes_);
+    statistic_scratch_.resize(statistic_results_.size());
+    timings_.reserve(max_scopes_);
+    // Timings view the names, they can't be reallocated
+    timing_names_.reserve(max_scopes_);
+}
+
+vkrndr::gpu_profiler_t::~gpu_profiler_t()
+{
+    for (frame_t const& frame : cppext::as_span(frames_))
+    {
+        vkDestroyQueryPool(*device_, frame.statistics, nullptr);
+        vkDestroyQueryPool(*device_, frame.timestamps, nullptr);
+    }
+}
+
+void vkrndr::gpu_profiler_t::begin_frame(VkCommandBuffer command_buffer)
+{
+    if (recording_)
+    {
+        frames_->used_scopes = std::min(next_scope_.load(), max_scopes_);
+    }
+    recording_ = true;
+
+    frames_.cycle();
+
+    frame_t& frame{*frames_};
+    if (frame.used_scopes)
+    {
+        resolve(frame);
+    }
+
+    vkCmdResetQueryPool(command_buffer, frame.timestamps, 0, 2 * max_scopes_);
+    if (frame.statistics != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(command_buffer, frame.statistics, 0, max_scopes_);
+    }
+
+    frame.used_scopes = 0;
+    next_scope_ = 0;
+}
+
+uint32_t vkrndr::gpu_profiler_t::begin_scope(VkCommandBuffer command_buffer,
+    std::string_view const name)
+{
+    uint32_t const scope{next_scope_.fetch_add(1, std::memory_order_relaxed)};
+    if (scope >= max_scopes_)
+    {
+        return invalid_scope;
+    }
+
+    frame_t& frame{*frames_};
+    frame.names[scope] = name;
+
+    vkCmdWriteTimestamp2(command_buffer,
+        VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT,
+        frame.timestamps,
+        2 * scope);
+    if (frame.statistics != VK_NULL_HANDLE)
+    {
+        vkCmdBeginQuery(command_buffer, frame.statistics, scope, 0);
+    }
+
+    return scope;
+}
+
+void vkrndr::gpu_profiler_t::end_scope(VkCommandBuffer command_buffer,
+    uint32_t const scope)
+{
+    if (scope == invalid_scope)
+    {
+        return;
+    }
+
+    frame_t const& frame{*frames_};
+    if (frame.statistics != VK_NULL_HANDLE)
+    {
+        vkCmdEndQuery(command_buffer, frame.statistics, scope);
+    }
+    vkCmdWriteTimestamp2(command_buffer,
+        VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT,
+        frame.timestamps,
+        2 * scope + 1);
+}
+
+void vkrndr::gpu_profiler_t::resolve(frame_t& frame)
+{
+    uint32_t const used{frame.used_scopes};
+
+    // Results of frames that didn't complete are skipped, last timings
+    // remain valid
+    if (vkGetQueryPoolResults(*device_,
+            frame.timestamps,
+            0,
+            2 * used,
+            sizeof(uint64_t) * 2 * used,
+            timestamp_results_.data(),
+            sizeof(uint64_t),
+            VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+    {
+        return;
+    }
+
+    if (frame.statistics != VK_NULL_HANDLE &&
+        vkGetQueryPoolResults(*device_,
+            frame.statistics,
+            0,
+            used,
+            sizeof(uint64_t) * statistic_count_ * used,
+            statistic_scratch_.data(),
+            sizeof(uint64_t) * statistic_count_,
+            VK_QUERY_RESULT_64_BIT) != VK_SUCCESS)
+    {
+        return;
+    }
+
+    statistic_results_.swap(statistic_scratch_);
+
+    timings_.clear();
+    timing_names_.clear();
+    for (uint32_t i{}; i != used; ++i)
+    {
+        uint64_t const begin{timestamp_results_[2 * size_t{i}]};
+        uint64_t const end{timestamp_results_[2 * size_t{i} + 1]};
+
+        timing_names_.push_back(frame.names[i]);
+        timings_.push_back({.name = timing_names_.back(),
+            .milliseconds = static_cast<double>(end - begin) *
+                timestamp_period_ / 1e6,
+            .statistics = std::span{statistic_results_}.subspan(
+                size_t{statistic_count_} * i,
+                statistic_count_)});
+    }
+}
+
+vkrndr::gpu_profiler_scope_t::gpu_profiler_scope_t(gpu_profiler_t& profiler,
+    VkCommandBuffer command_buffer,
+    std::string_view const name)
+    : profiler_{&profiler}
+    , command_buffer_{command_buffer}
+    , scope_{profiler.begin_scope(command_buffer, name)}
+{
+}
+
+vkrndr::gpu_profiler_scope_t::~gpu_profiler_scope_t()
+{
+    profiler_->end_scope(command_buffer_, scope_);
+}
@@ -107,7 +107,7 @@ vkrndr::pipeline_t vkrndr::graphics_pipeline_builder_t::build()
 
     pipeline_t rv{*layout_, VK_NULL_HANDLE, VK_PIPELINE_BIND_POINT_GRAPHICS};
     check_result(vkCreateGraphicsPipelines(*device_,
-        VK_NULL_HANDLE,
+        device_->pipeline_cache,
         1,
         &create_info,
         nullptr,
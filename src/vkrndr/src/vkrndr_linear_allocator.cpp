@@ -0,0 +1,145 @@
+#include <vkrndr_linear_allocator.hpp>
+
+#include <vkrndr_buffer.hpp>
+#include <vkrndr_device.hpp>
+#include <vkrndr_memory.hpp>
+
+#include <cppext_container.hpp>
+#include <cppext_cycled_buffer.hpp>
+#include <cppext_memory.hpp>
+
+#include <vma_impl.hpp>
+
+#include <volk.h>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+vkrndr::linear_allocator_t::linear_allocator_t(device_t const& device,
+    uint32_t const frames_in_flight,
+    VkBufferUsageFlags const usage,
+    VkDeviceSize const block_size)
+    : device_{&device}
+    , usage_{usage}
+    , block_size_{block_size}
+    , frames_{frames_in_flight, frames_in_flight}
+{
+    VkPhysicalDeviceProperties properties; // NOLINT
+    vkGetPhysicalDeviceProperties(device, &properties);
+
+    if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+    {
+        min_alignment_ = std::max(min_alignment_,
+            properties.limits.minUniformBufferOffsetAlignment);
+    }
+
+    if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+    {
+        min_alignment_ = std::max(min_alignment_,
+            properties.limits.minStorageBufferOffsetAlignment);
+    }
+
+    for (frame_t& frame : cppext::as_span(frames_))
+    {
+        frame.blocks.push_back(create_block(block_size_));
+    }
+}
+
+vkrndr::linear_allocator_t::~linear_allocator_t()
+{
+    for (frame_t& frame : cppext::as_span(frames_))
+    {
+        for (block_t& block : frame.blocks)
+        {
+            destroy_block(block);
+        }
+    }
+}
+
+vkrndr::linear_allocation_t vkrndr::linear_allocator_t::allocate(
+    VkDeviceSize const size,
+    VkDeviceSize const alignment)
+{
+    assert(std::has_single_bit(alignment));
+
+    VkDeviceSize const effective_alignment{
+        std::max(alignment, min_alignment_)};
+
+    frame_t& frame{*frames_};
+    for (; frame.current_block != frame.blocks.size();
+        ++frame.current_block, frame.offset = 0)
+    {
+        block_t& block{frame.blocks[frame.current_block]};
+
+        VkDeviceSize const offset{
+            cppext::aligned_size(frame.offset, effective_alignment)};
+        if (offset + size <= block.buffer.size)
+        {
+            frame.offset = offset + size;
+
+            return {.buffer = block.buffer,
+                .offset = offset,
+                .size = size,
+                .device_address = block.buffer.device_address == 0
+                    ? 0
+                    : block.buffer.device_address + offset,
+                .mapped = block.map.as<std::byte>(offset)};
+        }
+    }
+
+    block_t& block{frame.blocks.emplace_back(
+        create_block(std::max(block_size_, size)))};
+    frame.offset = size;
+
+    return {.buffer = block.buffer,
+        .offset = 0,
+        .size = size,
+        .device_address = block.buffer.device_address,
+        .mapped = block.map.as<std::byte>()};
+}
+
+void vkrndr::linear_allocator_t::begin_frame()
+{
+    frames_.cycle();
+
+    frame_t& frame{*frames_};
+    if (frame.blocks.size() > 1)
+    {
+        VkDeviceSize total_size{};
+        for (block_t& block : frame.blocks)
+        {
+            total_size += block.buffer.size;
+            destroy_block(block);
+        }
+        frame.blocks.clear();
+
+        frame.blocks.push_back(create_block(total_size));
+    }
+
+    frame.current_block = 0;
+    frame.offset = 0;
+}
+
+vkrndr::linear_allocator_t::block_t vkrndr::linear_allocator_t::create_block(
+    VkDeviceSize const size) const
+{
+    buffer_t const buffer{create_buffer(*device_,
+        {.size = size,
+            .usage = usage_,
+            .allocation_flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+            .required_memory_flags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            .preferred_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT})};
+
+    return {.buffer = buffer, .map = map_memory(*device_, buffer)};
+}
+
+void vkrndr::linear_allocator_t::destroy_block(block_t& block) const
+{
+    unmap_memory(*device_, &block.map);
+    destroy(*device_, block.buffer);
+}
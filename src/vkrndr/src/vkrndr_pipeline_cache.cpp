@@ -0,0 +1,199 @@
+#include <vkrndr_pipeline_cache.hpp>
+
+#include <vkrndr_device.hpp>
+#include <vkrndr_error_code.hpp>
+#include <vkrndr_utility.hpp>
+
+#include <volk.h>
+
+#include <vulkan/utility/vk_struct_helper.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t magic{0x4350'4B4E}; // NKPC
+
+    // Header of the driver data identifies the device but not the driver
+    // version, data of other driver versions is usually rejected as well
+    // but it isn't required to be
+    struct [[nodiscard]] file_header_t final
+    {
+        uint32_t magic{};
+        uint32_t driver_version{};
+        uint64_t data_size{};
+    };
+
+    [[nodiscard]] bool is_compatible(
+        VkPhysicalDeviceProperties const& properties,
+        std::span<std::byte const> const& data)
+    {
+        VkPipelineCacheHeaderVersionOne header; // NOLINT
+        if (data.size() < sizeof(header))
+        {
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        return header.headerSize >= sizeof(header) &&
+            header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+            header.vendorID == properties.vendorID &&
+            header.deviceID == properties.deviceID &&
+            std::ranges::equal(header.pipelineCacheUUID,
+                properties.pipelineCacheUUID);
+    }
+} // namespace
+
+std::expected<bool, std::error_code> vkrndr::load_pipeline_cache(
+    device_t const& device,
+    std::filesystem::path const& file)
+{
+    std::error_code ec;
+    uintmax_t const file_size{std::filesystem::file_size(file, ec)};
+    if (ec == std::errc::no_such_file_or_directory)
+    {
+        return false;
+    }
+
+    if (ec)
+    {
+        return std::unexpected{ec};
+    }
+
+    std::ifstream stream{file, std::ios::binary};
+    if (!stream.is_open())
+    {
+        return std::unexpected{std::make_error_code(std::errc::io_error)};
+    }
+
+    file_header_t header;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!stream || header.magic != magic ||
+        file_size != sizeof(header) + header.data_size)
+    {
+        return false;
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(device, &properties);
+    if (header.driver_version != properties.driverVersion)
+    {
+        return false;
+    }
+
+    std::vector<std::byte> data(header.data_size);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    stream.read(reinterpret_cast<char*>(data.data()),
+        static_cast<std::streamsize>(data.size()));
+    if (!stream || !is_compatible(properties, data))
+    {
+        return false;
+    }
+
+    VkPipelineCacheCreateInfo const create_info{
+        .sType = vku::GetSType<VkPipelineCacheCreateInfo>(),
+        .initialDataSize = data.size(),
+        .pInitialData = data.data()};
+
+    VkPipelineCache loaded{VK_NULL_HANDLE};
+    if (VkResult const result{
+            vkCreatePipelineCache(device, &create_info, nullptr, &loaded)};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    VkResult const result{
+        vkMergePipelineCaches(device, device.pipeline_cache, 1, &loaded)};
+    vkDestroyPipelineCache(device, loaded, nullptr);
+    if (!is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    return true;
+}
+
+std::expected<void, std::error_code> vkrndr::save_pipeline_cache(
+    device_t const& device,
+    std::filesystem::path const& file)
+{
+    size_t size{};
+    if (VkResult const result{vkGetPipelineCacheData(device,
+            device.pipeline_cache,
+            &size,
+            nullptr)};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    std::vector<std::byte> data(size);
+    if (VkResult const result{vkGetPipelineCacheData(device,
+            device.pipeline_cache,
+            &size,
+            data.data())};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+    data.resize(size);
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(device, &properties);
+
+    file_header_t const header{.magic = magic,
+        .driver_version = properties.driverVersion,
+        .data_size = data.size()};
+
+    std::filesystem::path temporary{file};
+    temporary += ".tmp";
+
+    {
+        std::ofstream stream{temporary, std::ios::binary | std::ios::trunc};
+        if (!stream.is_open())
+        {
+            return std::unexpected{std::make_error_code(std::errc::io_error)};
+        }
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+        stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<char const*>(data.data()),
+            static_cast<std::streamsize>(data.size()));
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+
+        stream.flush();
+        if (!stream)
+        {
+            stream.close();
+
+            std::error_code ec;
+            remove(temporary, ec);
+
+            return std::unexpected{std::make_error_code(std::errc::io_error)};
+        }
+    }
+
+    std::error_code ec;
+    rename(temporary, file, ec);
+    if (ec)
+    {
+        std::error_code remove_ec;
+        remove(temporary, remove_ec);
+
+        return std::unexpected{ec};
+    }
+
+    return {};
+}
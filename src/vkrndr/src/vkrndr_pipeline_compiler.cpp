@@ -0,0 +1,156 @@
+#include <vkrndr_pipeline_compiler.hpp>
+
+#include <vkrndr_compute_pipeline_builder.hpp>
+#include <vkrndr_graphics_pipeline_builder.hpp>
+#include <vkrndr_pipeline.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <stop_token>
+#include <utility>
+
+vkrndr::deferred_pipeline_t::deferred_pipeline_t(
+    std::future<pipeline_t> future,
+    pipeline_t const& fallback)
+    : future_{std::move(future)}
+    , fallback_{fallback}
+{
+}
+
+bool vkrndr::deferred_pipeline_t::poll()
+{
+    if (future_.valid() &&
+        future_.wait_for(std::chrono::seconds{0}) == std::future_status::ready)
+    {
+        pipeline_ = future_.get();
+    }
+
+    return ready();
+}
+
+void vkrndr::deferred_pipeline_t::wait()
+{
+    if (future_.valid())
+    {
+        pipeline_ = future_.get();
+    }
+}
+
+bool vkrndr::deferred_pipeline_t::ready() const noexcept
+{
+    return pipeline_.handle != VK_NULL_HANDLE;
+}
+
+bool vkrndr::deferred_pipeline_t::pending() const noexcept
+{
+    return future_.valid();
+}
+
+vkrndr::pipeline_t const& vkrndr::deferred_pipeline_t::current() const noexcept
+{
+    return ready() ? pipeline_ : fallback_;
+}
+
+vkrndr::pipeline_t const&
+vkrndr::deferred_pipeline_t::fallback() const noexcept
+{
+    return fallback_;
+}
+
+void vkrndr::destroy(device_t const& device, deferred_pipeline_t& pipeline)
+{
+    pipeline.wait();
+
+    if (pipeline.ready())
+    {
+        destroy(device, pipeline.current());
+    }
+
+    pipeline = {};
+}
+
+vkrndr::pipeline_compiler_t::pipeline_compiler_t(uint32_t const worker_count)
+    : worker_count_{worker_count}
+{
+    assert(worker_count > 0);
+}
+
+vkrndr::pipeline_compiler_t::~pipeline_compiler_t()
+{
+    for (std::jthread& worker : workers_)
+    {
+        worker.request_stop();
+    }
+    workers_.clear();
+}
+
+vkrndr::deferred_pipeline_t vkrndr::pipeline_compiler_t::compile(
+    graphics_pipeline_builder_t const& builder,
+    pipeline_t const& fallback)
+{
+    return {enqueue(std::packaged_task<pipeline_t()>{
+                [builder]() mutable { return builder.build(); }}),
+        fallback};
+}
+
+vkrndr::deferred_pipeline_t vkrndr::pipeline_compiler_t::compile(
+    compute_pipeline_builder_t const& builder,
+    pipeline_t const& fallback)
+{
+    return {enqueue(std::packaged_task<pipeline_t()>{
+                [builder]() mutable { return builder.build(); }}),
+        fallback};
+}
+
+std::future<vkrndr::pipeline_t> vkrndr::pipeline_compiler_t::enqueue(
+    std::packaged_task<pipeline_t()> task)
+{
+    std::call_once(started_,
+        [this]()
+        {
+            workers_.reserve(worker_count_);
+            for (uint32_t i{}; i != worker_count_; ++i)
+            {
+                workers_.emplace_back([this](std::stop_token const& token)
+                    { work(token); });
+            }
+        });
+
+    std::future<pipeline_t> rv{task.get_future()};
+    {
+        std::scoped_lock const lock{mutex_};
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+
+    return rv;
+}
+
+void vkrndr::pipeline_compiler_t::work(std::stop_token const& token)
+{
+    while (true)
+    {
+        std::packaged_task<pipeline_t()> task;
+        {
+            std::unique_lock lock{mutex_};
+
+            // Queued tasks are finished even after the stop is requested,
+            // nobody would be left to fulfill their futures otherwise
+            if (!condition_.wait(lock,
+                    token,
+                    [this]() { return !tasks_.empty(); }) &&
+                tasks_.empty())
+            {
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        task();
+    }
+}
@@ -31,7 +31,7 @@ vkrndr::pipeline_t vkrndr::raytracing_pipeline_builder_t::build()
         VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR};
     check_result(vkCreateRayTracingPipelinesKHR(*device_,
         VK_NULL_HANDLE,
-        VK_NULL_HANDLE,
+        device_->pipeline_cache,
         1,
         &create_info,
         nullptr,
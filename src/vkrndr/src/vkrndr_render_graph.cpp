@@ -0,0 +1,421 @@
+#include <vkrndr_render_graph.hpp>
+
+#include <vkrndr_debug_utils.hpp>
+#include <vkrndr_device.hpp>
+#include <vkrndr_image.hpp>
+#include <vkrndr_synchronization.hpp>
+#include <vkrndr_utility.hpp>
+
+#include <cppext_numeric.hpp>
+
+#include <vma_impl.hpp>
+
+#include <vulkan/utility/vk_struct_helper.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+vkrndr::render_graph_pass_t::render_graph_pass_t(std::string_view const name)
+    : name_{name}
+{
+}
+
+vkrndr::render_graph_pass_t& vkrndr::render_graph_pass_t::read(
+    render_graph_image_t const image,
+    image_usage_t const& usage)
+{
+    accesses_.emplace_back(image, usage, false);
+    return *this;
+}
+
+vkrndr::render_graph_pass_t& vkrndr::render_graph_pass_t::write(
+    render_graph_image_t const image,
+    image_usage_t const& usage)
+{
+    accesses_.emplace_back(image, usage, true);
+    return *this;
+}
+
+vkrndr::render_graph_pass_t& vkrndr::render_graph_pass_t::with_side_effects()
+{
+    side_effects_ = true;
+    return *this;
+}
+
+vkrndr::render_graph_pass_t& vkrndr::render_graph_pass_t::execute(
+    std::function<void(VkCommandBuffer)> callback)
+{
+    callback_ = std::move(callback);
+    return *this;
+}
+
+bool vkrndr::render_graph_pass_t::culled() const noexcept { return culled_; }
+
+vkrndr::render_graph_t::render_graph_t(device_t const& device)
+    : device_{&device}
+{
+}
+
+vkrndr::render_graph_t::~render_graph_t()
+{
+    for (image_record_t const& record : images_)
+    {
+        if (!record.imported)
+        {
+            vkDestroyImageView(*device_, record.image.view, nullptr);
+            vkDestroyImage(*device_, record.image.handle, nullptr);
+        }
+    }
+
+    for (memory_block_t const& block : memory_blocks_)
+    {
+        vmaFreeMemory(device_->allocator, block.allocation);
+    }
+}
+
+vkrndr::render_graph_image_t vkrndr::render_graph_t::import_image(
+    image_t const& image,
+    image_usage_t const& initial,
+    std::optional<image_usage_t> const& final,
+    VkImageAspectFlags const aspect)
+{
+    image_record_t& record{images_.emplace_back()};
+    record.image = image;
+    record.aspect = aspect;
+    record.imported = true;
+    record.initial = initial;
+    record.final = final;
+
+    return {cppext::narrow<uint32_t>(images_.size() - 1)};
+}
+
+void vkrndr::render_graph_t::update_image(render_graph_image_t const handle,
+    image_t const& image)
+{
+    assert(images_[handle.index].imported);
+
+    images_[handle.index].image = image;
+}
+
+vkrndr::render_graph_image_t vkrndr::render_graph_t::create_image(
+    transient_image_create_info_t const& create_info)
+{
+    assert(!compiled_);
+
+    image_record_t& record{images_.emplace_back()};
+    record.image.format = create_info.format;
+    record.image.sample_count = create_info.samples;
+    record.image.mip_levels = create_info.mip_levels;
+    record.image.extent = to_3d_extent(create_info.extent);
+    record.aspect = create_info.aspect;
+    record.create_info = create_info;
+
+    return {cppext::narrow<uint32_t>(images_.size() - 1)};
+}
+
+vkrndr::render_graph_pass_t& vkrndr::render_graph_t::add_pass(
+    std::string_view const name)
+{
+    assert(!compiled_);
+
+    return passes_.emplace_back(name);
+}
+
+void vkrndr::render_graph_t::compile()
+{
+    assert(!compiled_);
+
+    cull();
+
+    allocate_transient_images();
+
+    compiled_ = true;
+}
+
+void vkrndr::render_graph_t::execute(VkCommandBuffer command_buffer)
+{
+    assert(compiled_);
+
+    for (image_record_t& record : images_)
+    {
+        if (record.imported)
+        {
+            record.state = {.usage = record.initial,
+                .written = record.initial.access != VK_ACCESS_2_NONE};
+        }
+        else if (record.memory_block)
+        {
+            // State is taken from the memory block on first use, earlier
+            // images placed in the block may be used before that
+            record.resident = false;
+        }
+    }
+
+    for (render_graph_pass_t const& pass : passes_)
+    {
+        if (pass.culled_)
+        {
+            continue;
+        }
+
+        for (render_graph_pass_t::access_t const& access : pass.accesses_)
+        {
+            transition(images_[access.image.index],
+                access.usage,
+                access.write);
+        }
+
+        if (!barriers_.empty())
+        {
+            wait_for(command_buffer, {}, {}, barriers_);
+            barriers_.clear();
+        }
+
+        if (pass.callback_)
+        {
+            VKRNDR_IF_DEBUG_UTILS(
+                [[maybe_unused]] command_buffer_scope_t const pass_scope{
+                    command_buffer,
+                    pass.name_});
+
+            pass.callback_(command_buffer);
+        }
+    }
+
+    for (image_record_t& record : images_)
+    {
+        if (record.imported && record.final)
+        {
+            transition(record, *record.final, false);
+        }
+    }
+
+    if (!barriers_.empty())
+    {
+        wait_for(command_buffer, {}, {}, barriers_);
+        barriers_.clear();
+    }
+}
+
+vkrndr::image_t const& vkrndr::render_graph_t::image(
+    render_graph_image_t const handle) const
+{
+    return images_[handle.index].image;
+}
+
+VkDeviceSize vkrndr::render_graph_t::transient_memory_size() const noexcept
+{
+    return std::accumulate(memory_blocks_.cbegin(),
+        memory_blocks_.cend(),
+        VkDeviceSize{},
+        [](VkDeviceSize const sum, memory_block_t const& block)
+        { return sum + block.requirements.size; });
+}
+
+void vkrndr::render_graph_t::cull()
+{
+    std::vector<bool> needed_images(images_.size());
+
+    // Walk backwards so that consumers are visited before producers
+    for (auto it{passes_.rbegin()}; it != passes_.rend(); ++it)
+    {
+        render_graph_pass_t& pass{*it};
+
+        bool const needed{pass.side_effects_ ||
+            std::ranges::any_of(pass.accesses_,
+                [this, &needed_images](
+                    render_graph_pass_t::access_t const& access)
+                {
+                    return access.write &&
+                        (images_[access.image.index].imported ||
+                            needed_images[access.image.index]);
+                })};
+
+        pass.culled_ = !needed;
+        if (!needed)
+        {
+            continue;
+        }
+
+        for (render_graph_pass_t::access_t const& access : pass.accesses_)
+        {
+            if (!access.write)
+            {
+                needed_images[access.image.index] = true;
+            }
+        }
+    }
+
+    for (size_t i{}; i != passes_.size(); ++i)
+    {
+        if (passes_[i].culled_)
+        {
+            continue;
+        }
+
+        for (render_graph_pass_t::access_t const& access : passes_[i].accesses_)
+        {
+            image_record_t& record{images_[access.image.index]};
+            if (!record.first_pass)
+            {
+                record.first_pass = i;
+            }
+            record.last_pass = i;
+        }
+    }
+}
+
+void vkrndr::render_graph_t::allocate_transient_images()
+{
+    std::vector<size_t> transient_images;
+    for (size_t i{}; i != images_.size(); ++i)
+    {
+        if (!images_[i].imported && images_[i].first_pass)
+        {
+            transient_images.push_back(i);
+        }
+    }
+
+    std::ranges::sort(transient_images,
+        std::less{},
+        [this](size_t const i) { return *images_[i].first_pass; });
+
+    for (size_t const i : transient_images)
+    {
+        image_record_t& record{images_[i]};
+        transient_image_create_info_t const& info{record.create_info};
+
+        VkImageCreateInfo const image_info{
+            .sType = vku::GetSType<VkImageCreateInfo>(),
+            .imageType = VK_IMAGE_TYPE_2D,
+            .format = info.format,
+            .extent = record.image.extent,
+            .mipLevels = info.mip_levels,
+            .arrayLayers = 1,
+            .samples = info.samples,
+            .tiling = VK_IMAGE_TILING_OPTIMAL,
+            .usage = info.usage,
+            .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED};
+
+        check_result(vkCreateImage(*device_,
+            &image_info,
+            nullptr,
+            &record.image.handle));
+
+        VkMemoryRequirements requirements; // NOLINT
+        vkGetImageMemoryRequirements(*device_,
+            record.image.handle,
+            &requirements);
+
+        // Reuse a block whose images are no longer used
+        auto const block{std::ranges::find_if(memory_blocks_,
+            [&record, &requirements](memory_block_t const& b)
+            {
+                return b.last_pass < *record.first_pass &&
+                    (b.requirements.memoryTypeBits &
+                        requirements.memoryTypeBits) != 0;
+            })};
+        if (block == memory_blocks_.end())
+        {
+            record.memory_block = memory_blocks_.size();
+            memory_blocks_.push_back(
+                {.requirements = requirements, .last_pass = record.last_pass});
+        }
+        else
+        {
+            record.memory_block = static_cast<size_t>(
+                std::distance(memory_blocks_.begin(), block));
+
+            block->requirements.size =
+                std::max(block->requirements.size, requirements.size);
+            block->requirements.alignment = std::max(
+                block->requirements.alignment,
+                requirements.alignment);
+            block->requirements.memoryTypeBits &= requirements.memoryTypeBits;
+            block->last_pass = record.last_pass;
+        }
+    }
+
+    VmaAllocationCreateInfo const allocation_info{
+        .requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
+    for (memory_block_t& block : memory_blocks_)
+    {
+        check_result(vmaAllocateMemory(device_->allocator,
+            &block.requirements,
+            &allocation_info,
+            &block.allocation,
+            nullptr));
+    }
+
+    for (size_t const i : transient_images)
+    {
+        image_record_t& record{images_[i]};
+
+        check_result(vmaBindImageMemory(device_->allocator,
+            memory_blocks_[*record.memory_block].allocation,
+            record.image.handle));
+
+        record.image.view = create_image_view(*device_,
+            record.image.handle,
+            record.image.format,
+            record.aspect,
+            record.image.mip_levels);
+    }
+}
+
+void vkrndr::render_graph_t::transition(image_record_t& record,
+    image_usage_t const& usage,
+    bool const write)
+{
+    image_state_t& state{record.state};
+
+    if (record.memory_block && !record.resident)
+    {
+        // Contents are discarded, wait only for the previous user of the
+        // memory and for its writes to complete
+        memory_block_t const& block{memory_blocks_[*record.memory_block]};
+        state = {.usage = {.stage = block.last_stage,
+                     .access = block.last_write_access},
+            .written = block.last_write_access != VK_ACCESS_2_NONE};
+        record.resident = true;
+    }
+
+    if (!write && !state.written && state.usage.layout == usage.layout)
+    {
+        // Reads don't have to be ordered between each other, later writes
+        // wait for all of them
+        state.usage.stage |= usage.stage;
+        state.usage.access |= usage.access;
+    }
+    else
+    {
+        barriers_.push_back(with_layout(
+            with_access(
+                on_stage(image_barrier(record.image, record.aspect),
+                    state.usage.stage,
+                    usage.stage),
+                state.written ? state.usage.access : VK_ACCESS_2_NONE,
+                usage.access),
+            state.usage.layout,
+            usage.layout));
+
+        state = {.usage = usage, .written = write};
+    }
+
+    if (record.memory_block)
+    {
+        memory_block_t& block{memory_blocks_[*record.memory_block]};
+        block.last_stage = state.usage.stage;
+        block.last_write_access =
+            state.written ? state.usage.access : VK_ACCESS_2_NONE;
+    }
+}
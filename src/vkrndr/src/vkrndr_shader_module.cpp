@@ -4,12 +4,11 @@
 #include <vkrndr_device.hpp>
 #include <vkrndr_utility.hpp>
 
-#include <cppext_read_file.hpp>
+#include <cppext_mapped_file.hpp>
 
 #include <bit>
 #include <cstdint>
 #include <filesystem>
-#include <vector>
 
 void vkrndr::destroy(device_t const& device,
     shader_module_t const& shader_module)
@@ -22,11 +21,11 @@ vkrndr::shader_module_t vkrndr::create_shader_module(device_t const& device,
     VkShaderStageFlagBits const stage,
     std::string_view const entry_point)
 {
-    std::vector<char> const code{cppext::read_file(path)};
+    cppext::mapped_file_t const code{path};
 
     return create_shader_module(device,
         // NOLINTNEXTLINE(bugprone-bitwise-pointer-cast)
-        std::span{std::bit_cast<uint32_t const*>(code.data()),
+        std::span{std::bit_cast<uint32_t const*>(code.bytes().data()),
             code.size() / sizeof(uint32_t)},
         stage,
         entry_point);
@@ -331,25 +331,35 @@ std::optional<vkrndr::image_t> vkrndr::swapchain_t::acquire_next_image(
 void vkrndr::swapchain_t::submit_command_buffers(
     std::span<VkCommandBuffer const> command_buffers,
     size_t const current_frame,
-    VkFence const submit_fence)
+    VkSemaphore const timeline,
+    uint64_t const timeline_value)
 {
     auto& frame{frames_in_flight_[current_frame]};
 
     VkPipelineStageFlags const wait_stage{
         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
 
+    // Value of the binary present semaphore is ignored
+    std::array const signal_semaphores{frame.present_semaphore, timeline};
+    std::array const signal_values{uint64_t{0}, timeline_value};
+
+    VkTimelineSemaphoreSubmitInfo const timeline_info{
+        .sType = vku::GetSType<VkTimelineSemaphoreSubmitInfo>(),
+        .signalSemaphoreValueCount = count_cast(signal_values),
+        .pSignalSemaphoreValues = signal_values.data()};
+
     VkSubmitInfo const submit_info{.sType = vku::GetSType<VkSubmitInfo>(),
+        .pNext = &timeline_info,
         .waitSemaphoreCount = 1,
         .pWaitSemaphores = &frame.acquire_semaphore,
         .pWaitDstStageMask = &wait_stage,
         .commandBufferCount = count_cast(command_buffers),
         .pCommandBuffers = command_buffers.data(),
-        .signalSemaphoreCount = 1,
-        .pSignalSemaphores = &frame.present_semaphore};
+        .signalSemaphoreCount = count_cast(signal_semaphores),
+        .pSignalSemaphores = signal_semaphores.data()};
 
     VkResult result{
-        settings_.present_queue->submit(cppext::as_span(submit_info),
-            submit_fence)};
+        settings_.present_queue->submit(cppext::as_span(submit_info))};
     check_result(result);
 
     VkPresentInfoKHR present_info{.sType = vku::GetSType<VkPresentInfoKHR>(),
@@ -8,6 +8,7 @@
 #include <vulkan/utility/vk_struct_helper.hpp>
 
 #include <cassert>
+#include <cstdint>
 #include <expected>
 #include <utility>
 
@@ -22,6 +23,24 @@ VkSemaphore vkrndr::create_semaphore(device_t const& device)
     return rv;
 }
 
+VkSemaphore vkrndr::create_timeline_semaphore(device_t const& device,
+    uint64_t const initial_value)
+{
+    VkSemaphoreTypeCreateInfo const type_info{
+        .sType = vku::GetSType<VkSemaphoreTypeCreateInfo>(),
+        .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+        .initialValue = initial_value};
+
+    VkSemaphoreCreateInfo const semaphore_info{
+        .sType = vku::GetSType<VkSemaphoreCreateInfo>(),
+        .pNext = &type_info};
+
+    VkSemaphore rv; // NOLINT
+    check_result(vkCreateSemaphore(device, &semaphore_info, nullptr, &rv));
+
+    return rv;
+}
+
 VkFence vkrndr::create_fence(device_t const& device, bool const set_signaled)
 {
     VkFenceCreateInfo fence_info{};
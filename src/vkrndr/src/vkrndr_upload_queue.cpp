@@ -0,0 +1,642 @@
+#include <vkrndr_upload_queue.hpp>
+
+#include <vkrndr_buffer.hpp>
+#include <vkrndr_commands.hpp>
+#include <vkrndr_device.hpp>
+#include <vkrndr_error_code.hpp>
+#include <vkrndr_execution_port.hpp>
+#include <vkrndr_image.hpp>
+#include <vkrndr_memory.hpp>
+#include <vkrndr_synchronization.hpp>
+#include <vkrndr_utility.hpp>
+
+#include <cppext_container.hpp>
+#include <cppext_numeric.hpp>
+
+#include <vulkan/utility/vk_struct_helper.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Barrier half recorded on the queue family which releases ownership
+    template<typename T>
+    [[nodiscard]] constexpr T release_barrier(T const& barrier,
+        uint32_t const from,
+        uint32_t const to)
+    {
+        T rv{vkrndr::with_ownership_transfer(barrier, from, to)};
+        rv.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        rv.dstAccessMask = VK_ACCESS_2_NONE;
+
+        return rv;
+    }
+
+    // Barrier half recorded on the queue family which acquires ownership
+    template<typename T>
+    [[nodiscard]] constexpr T acquire_barrier(T const& barrier,
+        uint32_t const from,
+        uint32_t const to)
+    {
+        T rv{vkrndr::with_ownership_transfer(barrier, from, to)};
+        rv.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        rv.srcAccessMask = VK_ACCESS_2_NONE;
+
+        return rv;
+    }
+
+    void copy_mip_levels(VkCommandBuffer const command_buffer,
+        VkBuffer const source,
+        VkImage const image,
+        std::span<vkrndr::image_mip_level_t const> const& mip_levels)
+    {
+        std::vector<VkBufferImageCopy> regions;
+        regions.reserve(mip_levels.size());
+        for (size_t i{}; i != mip_levels.size(); ++i)
+        {
+            vkrndr::image_mip_level_t const& level{mip_levels[i]};
+
+            regions.push_back({.bufferOffset = level.data_offset,
+                .bufferRowLength = 0,
+                .bufferImageHeight = 0,
+                .imageSubresource = {.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                    .mipLevel = cppext::narrow<uint32_t>(i),
+                    .baseArrayLayer = 0,
+                    .layerCount = 1},
+                .imageOffset = {0, 0, 0},
+                .imageExtent = {level.extent.width, level.extent.height, 1}});
+        }
+
+        vkCmdCopyBufferToImage(command_buffer,
+            source,
+            image,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            vkrndr::count_cast(regions),
+            regions.data());
+    }
+
+    [[nodiscard]] std::expected<void, std::error_code> begin_commands(
+        VkCommandBuffer const command_buffer)
+    {
+        VkCommandBufferBeginInfo const begin_info{
+            .sType = vku::GetSType<VkCommandBufferBeginInfo>(),
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT};
+
+        if (VkResult const result{
+                vkBeginCommandBuffer(command_buffer, &begin_info)};
+            !vkrndr::is_success_result(result))
+        {
+            return std::unexpected{vkrndr::make_error_code(result)};
+        }
+
+        return {};
+    }
+} // namespace
+
+vkrndr::upload_queue_t::upload_queue_t(device_t const& device,
+    execution_port_t& graphics_port,
+    execution_port_t& transfer_port)
+    : device_{&device}
+    , graphics_port_{&graphics_port}
+    , transfer_port_{&transfer_port}
+    , semaphore_{create_timeline_semaphore(device)}
+    , transfer_semaphore_{create_timeline_semaphore(device)}
+{
+    assert(graphics_port.has_graphics());
+    assert(transfer_port.has_transfer());
+}
+
+vkrndr::upload_queue_t::~upload_queue_t()
+{
+    if (!in_flight_.empty())
+    {
+        [[maybe_unused]] std::expected<void, std::error_code> const result{
+            wait(upload_ticket_t{in_flight_.back().value})};
+        assert(result);
+    }
+
+    auto const destroy_batch = [this](batch_t const& batch)
+    {
+        for (buffer_t const& buffer : batch.staging_buffers)
+        {
+            destroy(*device_, buffer);
+        }
+        destroy_command_pool(*device_, batch.transfer_pool);
+        destroy_command_pool(*device_, batch.graphics_pool);
+    };
+
+    if (recording_)
+    {
+        destroy_batch(*recording_);
+    }
+
+    for (batch_t const& batch : in_flight_)
+    {
+        destroy_batch(batch);
+    }
+
+    for (batch_t const& batch : free_)
+    {
+        destroy_batch(batch);
+    }
+
+    vkDestroySemaphore(*device_, transfer_semaphore_, nullptr);
+    vkDestroySemaphore(*device_, semaphore_, nullptr);
+}
+
+std::expected<vkrndr::upload_ticket_t, std::error_code>
+vkrndr::upload_queue_t::upload(buffer_t const& source, buffer_t const& target)
+{
+    assert(source.size <= target.size);
+
+    std::expected<batch_t*, std::error_code> const batch{recording()};
+    if (!batch)
+    {
+        return std::unexpected{batch.error()};
+    }
+
+    VkCommandBuffer const cb{(*batch)->transfer_commands};
+
+    copy_buffer_to_buffer(cb, source, source.size, target);
+
+    auto const barrier{with_access(on_stage(buffer_barrier(target),
+                                       VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+                                       VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT),
+        VK_ACCESS_2_TRANSFER_WRITE_BIT,
+        VK_ACCESS_2_MEMORY_READ_BIT)};
+    if (dedicated())
+    {
+        uint32_t const from{transfer_port_->queue_family()};
+        uint32_t const to{graphics_port_->queue_family()};
+
+        auto const release{release_barrier(barrier, from, to)};
+        wait_for(cb, {}, cppext::as_span(release), {});
+
+        (*batch)->buffer_acquires.push_back(acquire_barrier(barrier, from, to));
+    }
+    else
+    {
+        wait_for(cb, {}, cppext::as_span(barrier), {});
+    }
+
+    return upload_ticket_t{(*batch)->value};
+}
+
+std::expected<vkrndr::upload_ticket_t, std::error_code>
+vkrndr::upload_queue_t::upload(std::span<std::byte const> const& data,
+    buffer_t const& target)
+{
+    std::expected<batch_t*, std::error_code> const batch{recording()};
+    if (!batch)
+    {
+        return std::unexpected{batch.error()};
+    }
+
+    return upload(stage(**batch, data), target);
+}
+
+std::expected<vkrndr::upload_ticket_t, std::error_code>
+vkrndr::upload_queue_t::upload(std::span<std::byte const> const& data,
+    image_t const& target,
+    std::span<image_mip_level_t const> const& defined_mips)
+{
+    assert(defined_mips.empty() || defined_mips.size() == target.mip_levels);
+
+    std::expected<batch_t*, std::error_code> const batch{recording()};
+    if (!batch)
+    {
+        return std::unexpected{batch.error()};
+    }
+
+    buffer_t const staging_buffer{stage(**batch, data)};
+
+    VkCommandBuffer const cb{(*batch)->transfer_commands};
+    VkExtent2D const extent{target.extent.width, target.extent.height};
+    bool const generate{defined_mips.empty() && target.mip_levels > 1};
+
+    wait_for_transfer_write(target, cb, target.mip_levels);
+    if (defined_mips.empty())
+    {
+        copy_buffer_to_image(cb, staging_buffer, target, extent);
+    }
+    else
+    {
+        copy_mip_levels(cb, staging_buffer, target, defined_mips);
+    }
+
+    if (!dedicated())
+    {
+        if (generate)
+        {
+            generate_mipmaps(*device_,
+                target,
+                cb,
+                target.format,
+                extent,
+                target.mip_levels);
+        }
+        else
+        {
+            wait_for_transfer_write_completed(target, cb, target.mip_levels);
+        }
+
+        return upload_ticket_t{(*batch)->value};
+    }
+
+    uint32_t const from{transfer_port_->queue_family()};
+    uint32_t const to{graphics_port_->queue_family()};
+
+    auto const resource{image_barrier(target)};
+
+    // Mipmaps are generated with blits after ownership is acquired by the
+    // graphics queue family, layout is left as is until then
+    VkImageMemoryBarrier2 barrier{resource};
+    if (generate)
+    {
+        barrier = with_access(
+            on_stage(resource, VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT),
+            VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT);
+        barrier = with_layout(barrier,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    }
+    else
+    {
+        barrier = with_access(on_stage(resource,
+                                  VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT,
+                                  VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT),
+            VK_ACCESS_2_TRANSFER_WRITE_BIT,
+            VK_ACCESS_2_SHADER_READ_BIT);
+        barrier = with_layout(barrier,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+
+    auto const release{release_barrier(barrier, from, to)};
+    wait_for(cb, {}, {}, cppext::as_span(release));
+
+    (*batch)->image_acquires.push_back(acquire_barrier(barrier, from, to));
+    if (generate)
+    {
+        (*batch)->mipmapped_images.push_back(target);
+    }
+
+    return upload_ticket_t{(*batch)->value};
+}
+
+std::expected<void, std::error_code> vkrndr::upload_queue_t::submit()
+{
+    if (!recording_)
+    {
+        return {};
+    }
+
+    batch_t& batch{*recording_};
+
+    if (VkResult const result{vkEndCommandBuffer(batch.transfer_commands)};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    // Batch is ready once the copies are complete unless ownership has to be
+    // acquired on the graphics port
+    bool const graphics_pending{dedicated()};
+
+    VkTimelineSemaphoreSubmitInfo const timeline_info{
+        .sType = vku::GetSType<VkTimelineSemaphoreSubmitInfo>(),
+        .signalSemaphoreValueCount = 1,
+        .pSignalSemaphoreValues =
+            graphics_pending ? &batch.transfer_value : &batch.value};
+
+    VkSubmitInfo const submit_info{.sType = vku::GetSType<VkSubmitInfo>(),
+        .pNext = &timeline_info,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &batch.transfer_commands,
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores =
+            graphics_pending ? &transfer_semaphore_ : &semaphore_};
+
+    if (VkResult const result{
+            transfer_port_->submit(cppext::as_span(submit_info))};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    batch.graphics_pending = graphics_pending;
+
+    in_flight_.push_back(std::move(batch));
+    recording_.reset();
+
+    return {};
+}
+
+std::expected<void, std::error_code> vkrndr::upload_queue_t::poll()
+{
+    uint64_t completed{};
+    if (VkResult const result{
+            vkGetSemaphoreCounterValue(*device_, semaphore_, &completed)};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    uint64_t transfer_completed{};
+    if (VkResult const result{vkGetSemaphoreCounterValue(*device_,
+            transfer_semaphore_,
+            &transfer_completed)};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    // Acquire operations are submitted only after the host observes that
+    // the copies are complete, the graphics queue never waits on the
+    // transfer queue
+    for (batch_t& batch : in_flight_)
+    {
+        if (!batch.graphics_pending)
+        {
+            continue;
+        }
+
+        if (batch.transfer_value > transfer_completed)
+        {
+            break;
+        }
+
+        if (std::expected<void, std::error_code> result{
+                submit_graphics(batch)};
+            !result)
+        {
+            return result;
+        }
+    }
+
+    while (!in_flight_.empty() && !in_flight_.front().graphics_pending &&
+        in_flight_.front().value <= completed)
+    {
+        batch_t batch{std::move(in_flight_.front())};
+        in_flight_.erase(in_flight_.begin());
+
+        if (std::expected<void, std::error_code> result{
+                release(std::move(batch))};
+            !result)
+        {
+            return result;
+        }
+    }
+
+    return {};
+}
+
+bool vkrndr::upload_queue_t::ready(upload_ticket_t const ticket) const
+{
+    uint64_t completed{};
+    if (VkResult const result{
+            vkGetSemaphoreCounterValue(*device_, semaphore_, &completed)};
+        !is_success_result(result))
+    {
+        return false;
+    }
+
+    return completed >= ticket.value;
+}
+
+std::expected<void, std::error_code> vkrndr::upload_queue_t::wait(
+    upload_ticket_t const ticket)
+{
+    assert(ticket.value <= last_value_);
+
+    if (recording_ && ticket.value >= recording_->value)
+    {
+        if (std::expected<void, std::error_code> result{submit()}; !result)
+        {
+            return result;
+        }
+    }
+
+    while (!ready(ticket) && !in_flight_.empty())
+    {
+        // Copies have to complete before the acquire of the batch can be
+        // submitted by poll
+        batch_t const& batch{in_flight_.front()};
+        bool const copies{batch.graphics_pending};
+        uint64_t const value{copies ? batch.transfer_value : batch.value};
+
+        VkSemaphoreWaitInfo const wait_info{
+            .sType = vku::GetSType<VkSemaphoreWaitInfo>(),
+            .semaphoreCount = 1,
+            .pSemaphores = copies ? &transfer_semaphore_ : &semaphore_,
+            .pValues = &value};
+
+        if (VkResult const result{vkWaitSemaphores(*device_,
+                &wait_info,
+                std::numeric_limits<uint64_t>::max())};
+            !is_success_result(result))
+        {
+            return std::unexpected{make_error_code(result)};
+        }
+
+        if (std::expected<void, std::error_code> result{poll()}; !result)
+        {
+            return result;
+        }
+    }
+
+    return {};
+}
+
+bool vkrndr::upload_queue_t::dedicated() const noexcept
+{
+    return graphics_port_->queue_family() != transfer_port_->queue_family();
+}
+
+std::expected<vkrndr::upload_queue_t::batch_t*, std::error_code>
+vkrndr::upload_queue_t::recording()
+{
+    if (recording_)
+    {
+        return &recording_.value();
+    }
+
+    batch_t batch;
+    if (!free_.empty())
+    {
+        batch = std::move(free_.back());
+        free_.pop_back();
+    }
+    else
+    {
+        auto const create_commands = [this](uint32_t const family,
+                                         VkCommandPool& pool,
+                                         VkCommandBuffer& command_buffer)
+            -> std::expected<void, std::error_code>
+        {
+            std::expected<VkCommandPool, std::error_code> const rv{
+                create_command_pool(*device_,
+                    family,
+                    VK_COMMAND_POOL_CREATE_TRANSIENT_BIT)};
+            if (!rv)
+            {
+                return std::unexpected{rv.error()};
+            }
+            pool = *rv;
+
+            return allocate_command_buffers(*device_,
+                pool,
+                true,
+                cppext::as_span(command_buffer));
+        };
+
+        std::expected<void, std::error_code> result{
+            create_commands(transfer_port_->queue_family(),
+                batch.transfer_pool,
+                batch.transfer_commands)};
+        if (result && dedicated())
+        {
+            result = create_commands(graphics_port_->queue_family(),
+                batch.graphics_pool,
+                batch.graphics_commands);
+        }
+
+        if (!result)
+        {
+            destroy_command_pool(*device_, batch.transfer_pool);
+            destroy_command_pool(*device_, batch.graphics_pool);
+            return std::unexpected{result.error()};
+        }
+    }
+
+    if (std::expected<void, std::error_code> const result{
+            begin_commands(batch.transfer_commands)};
+        !result)
+    {
+        free_.push_back(std::move(batch));
+        return std::unexpected{result.error()};
+    }
+
+    // Values of both parts are reserved upfront, tickets are handed out
+    // while the batch is being recorded
+    batch.value = ++last_value_;
+    batch.transfer_value = dedicated() ? ++last_transfer_value_ : 0;
+
+    recording_ = std::move(batch);
+
+    return &recording_.value();
+}
+
+vkrndr::buffer_t vkrndr::upload_queue_t::stage(batch_t& batch,
+    std::span<std::byte const> const& data)
+{
+    buffer_t const rv{create_staging_buffer(*device_, data.size())};
+    batch.staging_buffers.push_back(rv);
+
+    mapped_memory_t staging_map{map_memory(*device_, rv)};
+    memcpy(staging_map.mapped_memory, data.data(), data.size());
+    unmap_memory(*device_, &staging_map);
+
+    return rv;
+}
+
+std::expected<void, std::error_code> vkrndr::upload_queue_t::submit_graphics(
+    batch_t& batch)
+{
+    VkCommandBuffer const cb{batch.graphics_commands};
+
+    if (std::expected<void, std::error_code> result{begin_commands(cb)};
+        !result)
+    {
+        return result;
+    }
+
+    wait_for(cb, {}, batch.buffer_acquires, batch.image_acquires);
+    for (image_t const& image : batch.mipmapped_images)
+    {
+        generate_mipmaps(*device_,
+            image,
+            cb,
+            image.format,
+            {image.extent.width, image.extent.height},
+            image.mip_levels);
+    }
+
+    if (VkResult const result{vkEndCommandBuffer(cb)};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    // Wait is already satisfied, it only orders the acquire after the release
+    VkPipelineStageFlags const wait_stage{VK_PIPELINE_STAGE_ALL_COMMANDS_BIT};
+
+    VkTimelineSemaphoreSubmitInfo const timeline_info{
+        .sType = vku::GetSType<VkTimelineSemaphoreSubmitInfo>(),
+        .waitSemaphoreValueCount = 1,
+        .pWaitSemaphoreValues = &batch.transfer_value,
+        .signalSemaphoreValueCount = 1,
+        .pSignalSemaphoreValues = &batch.value};
+
+    VkSubmitInfo const submit_info{.sType = vku::GetSType<VkSubmitInfo>(),
+        .pNext = &timeline_info,
+        .waitSemaphoreCount = 1,
+        .pWaitSemaphores = &transfer_semaphore_,
+        .pWaitDstStageMask = &wait_stage,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &cb,
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = &semaphore_};
+
+    if (VkResult const result{
+            graphics_port_->submit(cppext::as_span(submit_info))};
+        !is_success_result(result))
+    {
+        return std::unexpected{make_error_code(result)};
+    }
+
+    batch.graphics_pending = false;
+
+    return {};
+}
+
+std::expected<void, std::error_code> vkrndr::upload_queue_t::release(
+    batch_t batch)
+{
+    for (buffer_t const& buffer : batch.staging_buffers)
+    {
+        destroy(*device_, buffer);
+    }
+    batch.staging_buffers.clear();
+    batch.buffer_acquires.clear();
+    batch.image_acquires.clear();
+    batch.mipmapped_images.clear();
+
+    std::expected<void, std::error_code> result{
+        reset_command_pool(*device_, batch.transfer_pool)};
+    if (result && batch.graphics_pool != VK_NULL_HANDLE)
+    {
+        result = reset_command_pool(*device_, batch.graphics_pool);
+    }
+
+    if (!result)
+    {
+        destroy_command_pool(*device_, batch.transfer_pool);
+        destroy_command_pool(*device_, batch.graphics_pool);
+        return result;
+    }
+
+    free_.push_back(std::move(batch));
+
+    return {};
+}
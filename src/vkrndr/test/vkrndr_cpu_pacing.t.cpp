@@ -0,0 +1,117 @@
+#include <vkrndr_cpu_pacing.hpp>
+
+#include <vkrndr_device.hpp>
+#include <vkrndr_utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vulkan/utility/vk_struct_helper.hpp>
+
+#include <volk.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <global_handles.hpp>
+
+namespace
+{
+    void signal(vkrndr::cpu_pacing_t const& pacing, uint64_t const value)
+    {
+        VkSemaphoreSignalInfo const signal_info{
+            .sType = vku::GetSType<VkSemaphoreSignalInfo>(),
+            .semaphore = pacing.timeline(),
+            .value = value};
+        vkrndr::check_result(
+            vkSignalSemaphore(*test::minimal_device, &signal_info));
+    }
+} // namespace
+
+TEST_CASE("Frames are given increasing timeline values",
+    "[vkrndr][cpu_pacing][gpu]")
+{
+    vkrndr::cpu_pacing_t pacing{*test::minimal_device, 2};
+
+    REQUIRE(pacing.pace() == &pacing.current());
+    pacing.begin_frame();
+    CHECK(pacing.current().index == 0);
+    CHECK(pacing.current().timeline_value == 1);
+    pacing.end_frame();
+
+    REQUIRE(pacing.pace() == &pacing.current());
+    pacing.begin_frame();
+    CHECK(pacing.current().index == 1);
+    CHECK(pacing.current().timeline_value == 2);
+    pacing.end_frame();
+
+    // First frame wasn't signaled yet
+    CHECK(pacing.pace() == nullptr);
+
+    signal(pacing, 2);
+}
+
+TEST_CASE("Deferred actions run once the timeline reaches the frame",
+    "[vkrndr][cpu_pacing][gpu]")
+{
+    vkrndr::cpu_pacing_t pacing{*test::minimal_device, 2};
+
+    int runs{};
+
+    REQUIRE(pacing.pace());
+    pacing.begin_frame();
+    pacing.defer([&runs]() { ++runs; });
+    pacing.end_frame();
+
+    REQUIRE(pacing.pace());
+    CHECK(runs == 0);
+    pacing.begin_frame();
+    pacing.end_frame();
+
+    signal(pacing, 1);
+    REQUIRE(pacing.pace());
+    CHECK(runs == 1);
+
+    signal(pacing, 2);
+}
+
+TEST_CASE("Deferred actions run in reverse order of deferral",
+    "[vkrndr][cpu_pacing][gpu]")
+{
+    vkrndr::cpu_pacing_t pacing{*test::minimal_device, 2};
+
+    std::vector<int> order;
+
+    // Two frames stay in flight, actions outgrow the initial ring capacity
+    // and later ones are stored after the head wraps around
+    for (int frame{1}; frame != 6; ++frame)
+    {
+        if (frame > 2)
+        {
+            signal(pacing, static_cast<uint64_t>(frame - 2));
+        }
+
+        REQUIRE(pacing.pace());
+        pacing.begin_frame();
+        for (int i{}; i != 7; ++i)
+        {
+            pacing.defer([&order, frame, i]()
+                { order.push_back(frame * 10 + i); });
+        }
+        pacing.end_frame();
+    }
+
+    signal(pacing, 5);
+    REQUIRE(pacing.pace());
+
+    // Last two frames complete together
+    std::vector<int> expected;
+    for (int const frame : {1, 2, 3, 5, 4})
+    {
+        for (int i{6}; i != -1; --i)
+        {
+            expected.push_back(frame * 10 + i);
+        }
+    }
+
+    CHECK(order == expected);
+}
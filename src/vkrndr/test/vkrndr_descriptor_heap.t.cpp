@@ -0,0 +1,98 @@
+#include <vkrndr_descriptor_heap.hpp>
+
+#include <vkrndr_device.hpp>
+#include <vkrndr_error_code.hpp>
+#include <vkrndr_sampler.hpp>
+#include <vkrndr_utility.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <volk.h>
+
+#include <cstdint>
+#include <expected>
+#include <system_error>
+
+#include <global_handles.hpp>
+
+namespace
+{
+    [[nodiscard]] VkSampler create_sampler()
+    {
+        VkSamplerCreateInfo const create_info{
+            vkrndr::as_create_info(vkrndr::sampler_properties_t{})};
+
+        VkSampler rv; // NOLINT
+        vkrndr::check_result(
+            vkCreateSampler(*test::minimal_device, &create_info, nullptr, &rv));
+        return rv;
+    }
+} // namespace
+
+TEST_CASE("Descriptor heap allocates sequential slots",
+    "[vkrndr][descriptor_heap][gpu]")
+{
+    VkSampler const sampler{create_sampler()};
+    {
+        vkrndr::descriptor_heap_t heap{*test::minimal_device, 2};
+        REQUIRE(heap.descriptor_layout() != VK_NULL_HANDLE);
+        REQUIRE(heap.descriptor_set() != VK_NULL_HANDLE);
+
+        for (uint32_t i{}; i != 4; ++i)
+        {
+            std::expected<uint32_t, std::error_code> const slot{
+                heap.add_sampler(sampler)};
+            REQUIRE(slot);
+            CHECK(*slot == i);
+        }
+    }
+    vkDestroySampler(*test::minimal_device, sampler, nullptr);
+}
+
+TEST_CASE("Released descriptor heap slot is reused after frames in flight",
+    "[vkrndr][descriptor_heap][gpu]")
+{
+    VkSampler const sampler{create_sampler()};
+    {
+        vkrndr::descriptor_heap_t heap{*test::minimal_device, 2};
+
+        std::expected<uint32_t, std::error_code> const first{
+            heap.add_sampler(sampler)};
+        REQUIRE(first);
+        heap.release_sampler(*first);
+
+        heap.begin_frame();
+        std::expected<uint32_t, std::error_code> const second{
+            heap.add_sampler(sampler)};
+        REQUIRE(second);
+        CHECK(*second != *first);
+
+        heap.begin_frame();
+        std::expected<uint32_t, std::error_code> const third{
+            heap.add_sampler(sampler)};
+        REQUIRE(third);
+        CHECK(*third == *first);
+    }
+    vkDestroySampler(*test::minimal_device, sampler, nullptr);
+}
+
+TEST_CASE("Exhausted descriptor heap returns an error",
+    "[vkrndr][descriptor_heap][gpu]")
+{
+    VkSampler const sampler{create_sampler()};
+    {
+        vkrndr::descriptor_heap_t heap{*test::minimal_device,
+            1,
+            {.sampled_images = 1, .samplers = 2, .storage_buffers = 1}};
+
+        REQUIRE(heap.add_sampler(sampler));
+        REQUIRE(heap.add_sampler(sampler));
+
+        std::expected<uint32_t, std::error_code> const slot{
+            heap.add_sampler(sampler)};
+        REQUIRE_FALSE(slot);
+        CHECK(slot.error() ==
+            vkrndr::make_error_code(VK_ERROR_OUT_OF_POOL_MEMORY));
+    }
+    vkDestroySampler(*test::minimal_device, sampler, nullptr);
+}
@@ -0,0 +1,76 @@
+#include <vkrndr_gpu_profiler.hpp>
+
+#include <vkrndr_commands.hpp>
+#include <vkrndr_device.hpp>
+#include <vkrndr_execution_port.hpp>
+#include <vkrndr_utility.hpp>
+
+#include <cppext_container.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <volk.h>
+
+#include <expected>
+#include <functional>
+#include <system_error>
+
+#include <global_handles.hpp>
+
+// IWYU pragma: no_include <memory>
+
+namespace
+{
+    void submit_and_wait(std::function<void(VkCommandBuffer)> const& record)
+    {
+        vkrndr::execution_port_t& port{
+            *test::minimal_device->execution_ports.front()};
+
+        std::expected<VkCommandPool, std::error_code> const pool{
+            create_command_pool(*test::minimal_device, port.queue_family())};
+        REQUIRE(pool);
+
+        VkCommandBuffer command_buffer{VK_NULL_HANDLE};
+        REQUIRE(begin_single_time_commands(*test::minimal_device,
+            *pool,
+            cppext::as_span(command_buffer)));
+
+        record(command_buffer);
+
+        REQUIRE(end_single_time_commands(port,
+            cppext::as_span(command_buffer),
+            VK_NULL_HANDLE));
+        vkrndr::check_result(vkQueueWaitIdle(port));
+
+        destroy_command_pool(*test::minimal_device, *pool);
+    }
+} // namespace
+
+TEST_CASE("Scope timings are available when frame slot is reused",
+    "[vkrndr][gpu_profiler][gpu]")
+{
+    vkrndr::gpu_profiler_t profiler{*test::minimal_device, 1, 1};
+
+    submit_and_wait(
+        [&profiler](VkCommandBuffer const cb)
+        {
+            profiler.begin_frame(cb);
+
+            {
+                vkrndr::gpu_profiler_scope_t const scope{profiler, cb, "pass"};
+            }
+
+            // Over capacity
+            CHECK(profiler.begin_scope(cb, "ignored") ==
+                vkrndr::gpu_profiler_t::invalid_scope);
+        });
+    CHECK(profiler.timings().empty());
+
+    submit_and_wait([&profiler](VkCommandBuffer const cb)
+        { profiler.begin_frame(cb); });
+
+    REQUIRE(profiler.timings().size() == 1);
+    CHECK(profiler.timings().front().name == "pass");
+    CHECK(profiler.timings().front().milliseconds >= 0.0);
+    CHECK(profiler.timings().front().statistics.empty());
+}
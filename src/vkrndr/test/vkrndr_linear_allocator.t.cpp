@@ -0,0 +1,68 @@
+#include <vkrndr_linear_allocator.hpp>
+
+#include <vkrndr_device.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <volk.h>
+
+#include <global_handles.hpp>
+
+TEST_CASE("Linear allocations are aligned", "[vkrndr][linear_allocator][gpu]")
+{
+    vkrndr::linear_allocator_t allocator{*test::minimal_device,
+        2,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        1024};
+
+    vkrndr::linear_allocation_t const first{allocator.allocate(3)};
+    CHECK(first.offset == 0);
+    CHECK(first.size == 3);
+    CHECK(first.mapped != nullptr);
+
+    vkrndr::linear_allocation_t const second{allocator.allocate(8, 16)};
+    CHECK(second.buffer == first.buffer);
+    CHECK(second.offset == 16);
+    CHECK(second.mapped == first.mapped + 16);
+}
+
+TEST_CASE("Linear allocator grows when block is full",
+    "[vkrndr][linear_allocator][gpu]")
+{
+    vkrndr::linear_allocator_t allocator{*test::minimal_device,
+        1,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        256};
+
+    vkrndr::linear_allocation_t const first{allocator.allocate(200)};
+    vkrndr::linear_allocation_t const second{allocator.allocate(512)};
+    CHECK(second.buffer != first.buffer);
+    CHECK(second.offset == 0);
+    CHECK(second.size == 512);
+
+    // Blocks are merged when the frame slot is reused
+    allocator.begin_frame();
+    vkrndr::linear_allocation_t const merged{allocator.allocate(768)};
+    CHECK(merged.offset == 0);
+    CHECK(merged.buffer != VK_NULL_HANDLE);
+}
+
+TEST_CASE("Linear allocator reuses memory of completed frames",
+    "[vkrndr][linear_allocator][gpu]")
+{
+    vkrndr::linear_allocator_t allocator{*test::minimal_device,
+        2,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        1024};
+
+    vkrndr::linear_allocation_t const first{allocator.allocate(64)};
+
+    allocator.begin_frame();
+    vkrndr::linear_allocation_t const second{allocator.allocate(64)};
+    CHECK(second.buffer != first.buffer);
+
+    allocator.begin_frame();
+    vkrndr::linear_allocation_t const third{allocator.allocate(64)};
+    CHECK(third.buffer == first.buffer);
+    CHECK(third.offset == 0);
+}
@@ -0,0 +1,81 @@
+#include <vkrndr_pipeline_cache.hpp>
+
+#include <vkrndr_device.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <system_error>
+
+#include <global_handles.hpp>
+
+namespace
+{
+    [[nodiscard]] std::filesystem::path temporary_file(char const* const name)
+    {
+        auto rv{std::filesystem::temp_directory_path() / name};
+        std::filesystem::remove(rv);
+        return rv;
+    }
+} // namespace
+
+TEST_CASE("Pipeline cache is not loaded when file doesn't exist",
+    "[vkrndr][pipeline_cache][gpu]")
+{
+    auto const file{temporary_file("vkrndr_missing_pipeline_cache.bin")};
+
+    std::expected<bool, std::error_code> const result{
+        vkrndr::load_pipeline_cache(*test::minimal_device, file)};
+    REQUIRE(result);
+    CHECK_FALSE(*result);
+}
+
+TEST_CASE("Saved pipeline cache is loaded", "[vkrndr][pipeline_cache][gpu]")
+{
+    auto const file{temporary_file("vkrndr_saved_pipeline_cache.bin")};
+
+    REQUIRE(vkrndr::save_pipeline_cache(*test::minimal_device, file));
+    CHECK_FALSE(std::filesystem::exists(file.string() + ".tmp"));
+
+    std::expected<bool, std::error_code> const result{
+        vkrndr::load_pipeline_cache(*test::minimal_device, file)};
+    REQUIRE(result);
+    CHECK(*result);
+
+    std::filesystem::remove(file);
+}
+
+TEST_CASE("Pipeline cache of different driver version is rejected",
+    "[vkrndr][pipeline_cache][gpu]")
+{
+    auto const file{temporary_file("vkrndr_stale_pipeline_cache.bin")};
+
+    REQUIRE(vkrndr::save_pipeline_cache(*test::minimal_device, file));
+
+    {
+        // Driver version follows the magic number in the file header
+        std::fstream stream{file,
+            std::ios::binary | std::ios::in | std::ios::out};
+        stream.seekg(sizeof(uint32_t));
+        uint32_t driver_version{};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        stream.read(reinterpret_cast<char*>(&driver_version),
+            sizeof(driver_version));
+        ++driver_version;
+        stream.seekp(sizeof(uint32_t));
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        stream.write(reinterpret_cast<char const*>(&driver_version),
+            sizeof(driver_version));
+    }
+
+    std::expected<bool, std::error_code> const result{
+        vkrndr::load_pipeline_cache(*test::minimal_device, file)};
+    REQUIRE(result);
+    CHECK_FALSE(*result);
+
+    std::filesystem::remove(file);
+}
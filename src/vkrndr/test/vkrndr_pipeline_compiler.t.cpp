@@ -0,0 +1,174 @@
+#include <vkrndr_pipeline_compiler.hpp>
+
+#include <vkrndr_compute_pipeline_builder.hpp>
+#include <vkrndr_device.hpp>
+#include <vkrndr_pipeline.hpp>
+#include <vkrndr_pipeline_layout_builder.hpp>
+#include <vkrndr_shader_module.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <volk.h>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <global_handles.hpp>
+
+namespace
+{
+    // Empty compute shader with a single invocation per work group
+    constexpr auto empty_compute_shader{std::to_array<uint32_t>({
+        // Header: magic, SPIR-V 1.0, generator, id bound, schema
+        0x07230203,
+        0x00010000,
+        0,
+        5,
+        0,
+        // OpCapability Shader
+        0x00020011,
+        1,
+        // OpMemoryModel Logical GLSL450
+        0x0003000E,
+        0,
+        1,
+        // OpEntryPoint GLCompute %1 "main"
+        0x0005000F,
+        5,
+        1,
+        0x6E69616D,
+        0,
+        // OpExecutionMode %1 LocalSize 1 1 1
+        0x00060010,
+        1,
+        17,
+        1,
+        1,
+        1,
+        // %2 = OpTypeVoid
+        0x00020013,
+        2,
+        // %3 = OpTypeFunction %2
+        0x00030021,
+        3,
+        2,
+        // %1 = OpFunction %2 None %3
+        0x00050036,
+        2,
+        1,
+        0,
+        3,
+        // %4 = OpLabel
+        0x000200F8,
+        4,
+        // OpReturn
+        0x000100FD,
+        // OpFunctionEnd
+        0x00010038,
+    })};
+
+    class [[nodiscard]] compute_fixture_t
+    {
+    public:
+        compute_fixture_t()
+            : shader_{create_shader_module(*test::minimal_device,
+                  empty_compute_shader,
+                  VK_SHADER_STAGE_COMPUTE_BIT,
+                  "main")}
+            , layout_{vkrndr::pipeline_layout_builder_t{*test::minimal_device}
+                      .build()}
+        {
+        }
+
+        compute_fixture_t(compute_fixture_t const&) = delete;
+
+        compute_fixture_t(compute_fixture_t&&) noexcept = delete;
+
+    public:
+        ~compute_fixture_t()
+        {
+            destroy(*test::minimal_device, layout_);
+            destroy(*test::minimal_device, shader_);
+        }
+
+    public:
+        compute_fixture_t& operator=(compute_fixture_t const&) = delete;
+
+        compute_fixture_t& operator=(compute_fixture_t&&) noexcept = delete;
+
+    protected:
+        [[nodiscard]] vkrndr::compute_pipeline_builder_t builder() const
+        {
+            return vkrndr::compute_pipeline_builder_t{*test::minimal_device,
+                layout_}
+                .with_shader(as_pipeline_shader(shader_));
+        }
+
+    private:
+        vkrndr::shader_module_t shader_;
+        vkrndr::pipeline_layout_t layout_;
+    };
+} // namespace
+
+TEST_CASE_METHOD(compute_fixture_t,
+    "Deferred pipeline returns fallback until compiled one is acquired",
+    "[vkrndr][pipeline_compiler][gpu]")
+{
+    vkrndr::pipeline_t const fallback{builder().build()};
+
+    vkrndr::pipeline_compiler_t compiler;
+    vkrndr::deferred_pipeline_t pipeline{
+        compiler.compile(builder(), fallback)};
+
+    CHECK(pipeline.pending());
+    CHECK_FALSE(pipeline.ready());
+    CHECK(pipeline.current().handle == fallback.handle);
+    CHECK(pipeline.fallback().handle == fallback.handle);
+
+    SECTION("poll")
+    {
+        while (!pipeline.poll())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    SECTION("wait") { pipeline.wait(); }
+
+    CHECK_FALSE(pipeline.pending());
+    CHECK(pipeline.ready());
+    CHECK(pipeline.poll());
+    CHECK(pipeline.current().handle != VK_NULL_HANDLE);
+    CHECK(pipeline.current().handle != fallback.handle);
+    CHECK(pipeline.fallback().handle == fallback.handle);
+
+    destroy(*test::minimal_device, pipeline);
+    CHECK_FALSE(pipeline.pending());
+    CHECK_FALSE(pipeline.ready());
+
+    destroy(*test::minimal_device, fallback);
+}
+
+TEST_CASE_METHOD(compute_fixture_t,
+    "Pipeline compiler finishes queued pipelines when destroyed",
+    "[vkrndr][pipeline_compiler][gpu]")
+{
+    std::vector<vkrndr::deferred_pipeline_t> pipelines;
+    {
+        vkrndr::pipeline_compiler_t compiler;
+        for (int i{}; i != 8; ++i)
+        {
+            pipelines.push_back(compiler.compile(builder()));
+        }
+    }
+
+    for (vkrndr::deferred_pipeline_t& pipeline : pipelines)
+    {
+        CHECK(pipeline.poll());
+        CHECK(pipeline.current().handle != VK_NULL_HANDLE);
+
+        destroy(*test::minimal_device, pipeline);
+    }
+}
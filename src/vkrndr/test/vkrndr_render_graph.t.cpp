@@ -0,0 +1,203 @@
+#include <vkrndr_render_graph.hpp>
+
+#include <vkrndr_device.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <volk.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <global_handles.hpp>
+
+namespace
+{
+    constexpr vkrndr::transient_image_create_info_t transient_info{
+        .format = VK_FORMAT_R8G8B8A8_UNORM,
+        .extent = {64, 64},
+        .usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT};
+
+    constexpr vkrndr::image_usage_t compute_write{
+        vkrndr::storage_usage(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+            VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT)};
+
+    constexpr vkrndr::image_usage_t compute_read{
+        vkrndr::sampled_usage(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT)};
+
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+    std::vector<VkImageMemoryBarrier2> recorded_barriers;
+
+    void VKAPI_CALL record_barriers(VkCommandBuffer,
+        VkDependencyInfo const* const dependency)
+    {
+        recorded_barriers.insert(recorded_barriers.end(),
+            dependency->pImageMemoryBarriers,
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            dependency->pImageMemoryBarriers +
+                dependency->imageMemoryBarrierCount);
+    }
+
+    // Captures barriers recorded by the render graph instead of recording
+    // them to a command buffer
+    class [[nodiscard]] barrier_recorder_t final
+    {
+    public:
+        barrier_recorder_t() : original_{vkCmdPipelineBarrier2}
+        {
+            recorded_barriers.clear();
+            vkCmdPipelineBarrier2 = record_barriers;
+        }
+
+        barrier_recorder_t(barrier_recorder_t const&) = delete;
+
+        barrier_recorder_t(barrier_recorder_t&&) noexcept = delete;
+
+    public:
+        ~barrier_recorder_t() { vkCmdPipelineBarrier2 = original_; }
+
+    public:
+        [[nodiscard]] static VkImageMemoryBarrier2 const* find(
+            VkImage const image)
+        {
+            auto const it{std::ranges::find(recorded_barriers,
+                image,
+                &VkImageMemoryBarrier2::image)};
+            return it == recorded_barriers.cend() ? nullptr : &*it;
+        }
+
+        static void clear() { recorded_barriers.clear(); }
+
+    public:
+        barrier_recorder_t& operator=(barrier_recorder_t const&) = delete;
+
+        barrier_recorder_t& operator=(barrier_recorder_t&&) noexcept = delete;
+
+    private:
+        PFN_vkCmdPipelineBarrier2 original_;
+    };
+} // namespace
+
+TEST_CASE("Passes with unused results are culled",
+    "[vkrndr][render_graph][gpu]")
+{
+    vkrndr::render_graph_t graph{*test::minimal_device};
+
+    vkrndr::render_graph_image_t const used{
+        graph.create_image(transient_info)};
+    vkrndr::render_graph_image_t const unused{
+        graph.create_image(transient_info)};
+
+    vkrndr::render_graph_pass_t& producer{
+        graph.add_pass("producer").write(used, compute_write)};
+    vkrndr::render_graph_pass_t& dead{
+        graph.add_pass("dead").write(unused, compute_write)};
+    vkrndr::render_graph_pass_t& consumer{graph.add_pass("consumer")
+            .read(used, compute_read)
+            .with_side_effects()};
+
+    graph.compile();
+
+    CHECK_FALSE(producer.culled());
+    CHECK(dead.culled());
+    CHECK_FALSE(consumer.culled());
+    CHECK(graph.image(used).handle != VK_NULL_HANDLE);
+}
+
+TEST_CASE("Transient images with disjoint lifetimes share memory",
+    "[vkrndr][render_graph][gpu]")
+{
+    auto const build = [](vkrndr::render_graph_t& graph, bool const overlap)
+    {
+        vkrndr::render_graph_image_t const first{
+            graph.create_image(transient_info)};
+        vkrndr::render_graph_image_t const second{
+            graph.create_image(transient_info)};
+        vkrndr::render_graph_image_t const third{
+            graph.create_image(transient_info)};
+
+        graph.add_pass("first").write(first, compute_write);
+        graph.add_pass("second")
+            .read(first, compute_read)
+            .write(second, compute_write);
+        graph.add_pass("third")
+            .read(second, compute_read)
+            .write(third, compute_write);
+
+        vkrndr::render_graph_pass_t& last{
+            graph.add_pass("last").read(third, compute_read)};
+        last.with_side_effects();
+        if (overlap)
+        {
+            // Keeps the first image alive while the third one is used
+            last.read(first, compute_read);
+        }
+
+        graph.compile();
+    };
+
+    vkrndr::render_graph_t overlapping{*test::minimal_device};
+    build(overlapping, true);
+
+    vkrndr::render_graph_t disjoint{*test::minimal_device};
+    build(disjoint, false);
+
+    CHECK(disjoint.transient_memory_size() <
+        overlapping.transient_memory_size());
+}
+
+TEST_CASE("Aliased transient images wait for the previous user of memory",
+    "[vkrndr][render_graph][gpu]")
+{
+    vkrndr::render_graph_t graph{*test::minimal_device};
+
+    // Second image is placed in the memory of the first one
+    vkrndr::render_graph_image_t const first{
+        graph.create_image(transient_info)};
+    vkrndr::render_graph_image_t const second{
+        graph.create_image(transient_info)};
+
+    graph.add_pass("first").write(first, compute_write).with_side_effects();
+    graph.add_pass("second").write(second, compute_write).with_side_effects();
+
+    graph.compile();
+
+    VkImage const first_image{graph.image(first).handle};
+    VkImage const second_image{graph.image(second).handle};
+
+    barrier_recorder_t const recorder;
+
+    graph.execute(VK_NULL_HANDLE);
+    {
+        // Nothing used the memory before the first execution
+        VkImageMemoryBarrier2 const* const barrier{recorder.find(first_image)};
+        REQUIRE(barrier);
+        CHECK(barrier->srcStageMask == VK_PIPELINE_STAGE_2_NONE);
+        CHECK(barrier->srcAccessMask == VK_ACCESS_2_NONE);
+        CHECK(barrier->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+    }
+    {
+        VkImageMemoryBarrier2 const* const barrier{
+            recorder.find(second_image)};
+        REQUIRE(barrier);
+        CHECK(barrier->srcStageMask == compute_write.stage);
+        CHECK(barrier->srcAccessMask == compute_write.access);
+        CHECK(barrier->dstStageMask == compute_write.stage);
+        CHECK(barrier->dstAccessMask == compute_write.access);
+        CHECK(barrier->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+        CHECK(barrier->newLayout == compute_write.layout);
+    }
+
+    recorder.clear();
+
+    graph.execute(VK_NULL_HANDLE);
+    {
+        // Waits for the second image of the previous execution
+        VkImageMemoryBarrier2 const* const barrier{recorder.find(first_image)};
+        REQUIRE(barrier);
+        CHECK(barrier->srcStageMask == compute_write.stage);
+        CHECK(barrier->srcAccessMask == compute_write.access);
+        CHECK(barrier->oldLayout == VK_IMAGE_LAYOUT_UNDEFINED);
+    }
+}
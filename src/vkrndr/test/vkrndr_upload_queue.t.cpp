@@ -0,0 +1,185 @@
+#include <vkrndr_upload_queue.hpp>
+
+#include <vkrndr_buffer.hpp>
+#include <vkrndr_device.hpp>
+#include <vkrndr_execution_port.hpp>
+#include <vkrndr_features.hpp>
+#include <vkrndr_image.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <volk.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <system_error>
+
+#include <global_handles.hpp>
+#include <helpers.hpp>
+
+namespace
+{
+    constexpr VkExtent2D image_extent{64, 64};
+
+    constexpr std::array<std::byte,
+        size_t{image_extent.width} * image_extent.height * 4>
+        data{};
+
+    [[nodiscard]] vkrndr::execution_port_t* find_port(
+        vkrndr::device_t const& device,
+        uint32_t const queue_family)
+    {
+        auto const it{std::ranges::find_if(device.execution_ports,
+            [queue_family](auto const& port)
+            { return port->queue_family() == queue_family; })};
+        return it == device.execution_ports.cend() ? nullptr : it->get();
+    }
+
+    // Image with generated mip levels, acquired on the graphics port when
+    // uploaded through a dedicated transfer port
+    [[nodiscard]] vkrndr::image_t create_target_image(
+        vkrndr::device_t const& device)
+    {
+        return create_image(device,
+            vkrndr::image_2d_create_info_t{.format = VK_FORMAT_R8G8B8A8_UNORM,
+                .extent = image_extent,
+                .mip_levels = 4,
+                .tiling = VK_IMAGE_TILING_OPTIMAL,
+                .usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT |
+                    VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                    VK_IMAGE_USAGE_SAMPLED_BIT,
+                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
+    }
+
+    [[nodiscard]] vkrndr::buffer_t create_target_buffer(
+        vkrndr::device_t const& device)
+    {
+        return create_buffer(device,
+            {.size = data.size(),
+                .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                .required_memory_flags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT});
+    }
+} // namespace
+
+TEST_CASE("Batches on a shared queue family become ready in order",
+    "[vkrndr][upload_queue][gpu]")
+{
+    vkrndr::device_t const& device{*test::minimal_device};
+    vkrndr::execution_port_t& port{*device.execution_ports.front()};
+
+    vkrndr::image_t const image{create_target_image(device)};
+    vkrndr::buffer_t const buffer{create_target_buffer(device)};
+
+    {
+        vkrndr::upload_queue_t queue{device, port, port};
+
+        std::expected<vkrndr::upload_ticket_t, std::error_code> const first{
+            queue.upload(data, image)};
+        REQUIRE(first);
+        REQUIRE(queue.submit());
+
+        std::expected<vkrndr::upload_ticket_t, std::error_code> const second{
+            queue.upload(data, buffer)};
+        REQUIRE(second);
+        REQUIRE(queue.submit());
+
+        CHECK(first->value < second->value);
+
+        REQUIRE(queue.wait(*second));
+        CHECK(queue.ready(*first));
+        CHECK(queue.ready(*second));
+
+        // Waiting for an upload of the recorded batch submits it
+        std::expected<vkrndr::upload_ticket_t, std::error_code> const third{
+            queue.upload(data, buffer)};
+        REQUIRE(third);
+        CHECK_FALSE(queue.ready(*third));
+        REQUIRE(queue.wait(*third));
+        CHECK(queue.ready(*third));
+    }
+
+    destroy(device, buffer);
+    destroy(device, image);
+}
+
+TEST_CASE("Batches on a dedicated transfer port are ready after acquire",
+    "[vkrndr][upload_queue][gpu]")
+{
+    std::optional<vkrndr::physical_device_features_t> const physical_device{
+        pick_best_physical_device(*test::instance, {}, VK_NULL_HANDLE)};
+    REQUIRE(physical_device);
+
+    vkrndr::queue_family_t const* const general{
+        find_general_queue(physical_device->queue_families)};
+    REQUIRE(general);
+
+    std::optional<vkrndr::queue_family_t> const transfer{
+        vkrndr::find_dedicated_transfer_family(*physical_device)};
+    if (!transfer)
+    {
+        SKIP("Physical device doesn't have a dedicated transfer queue");
+    }
+
+    vkrndr::feature_chain_t chain;
+    link_required_feature_chain(chain,
+        std::min(test::instance->api_version,
+            physical_device->properties.apiVersion));
+
+    std::expected<vkrndr::device_ptr_t, std::error_code> const device_result{
+        create_device(*test::instance,
+            {},
+            *physical_device,
+            chain,
+            std::to_array({*general, *transfer}))};
+    REQUIRE(device_result);
+    vkrndr::device_t const& device{**device_result};
+
+    vkrndr::execution_port_t* const graphics_port{
+        find_port(device, general->index)};
+    vkrndr::execution_port_t* const transfer_port{
+        find_port(device, transfer->index)};
+    REQUIRE(graphics_port);
+    REQUIRE(transfer_port);
+
+    vkrndr::image_t const image{create_target_image(device)};
+    vkrndr::buffer_t const buffer{create_target_buffer(device)};
+
+    {
+        vkrndr::upload_queue_t queue{device, *graphics_port, *transfer_port};
+
+        std::expected<vkrndr::upload_ticket_t, std::error_code> const first{
+            queue.upload(data, image)};
+        REQUIRE(first);
+        REQUIRE(queue.submit());
+
+        std::expected<vkrndr::upload_ticket_t, std::error_code> const second{
+            queue.upload(data, buffer)};
+        REQUIRE(second);
+        REQUIRE(queue.submit());
+
+        CHECK(first->value < second->value);
+
+        // Copies of both batches complete before any acquire is submitted,
+        // neither batch is ready until its acquire and mipmap generation
+        // completed on the graphics port
+        REQUIRE(vkQueueWaitIdle(*transfer_port) == VK_SUCCESS);
+        CHECK_FALSE(queue.ready(*first));
+        CHECK_FALSE(queue.ready(*second));
+
+        REQUIRE(queue.wait(*first));
+        CHECK(queue.ready(*first));
+
+        REQUIRE(queue.wait(*second));
+        CHECK(queue.ready(*first));
+        CHECK(queue.ready(*second));
+    }
+
+    destroy(device, buffer);
+    destroy(device, image);
+}